@@ -0,0 +1,115 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Parsing from and serializing into compressed streams
+#include <chrono>
+#include <cjson/compression.h>
+#include <cjson/json.h>
+#include <cjson/serializer.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace cjson;
+using namespace std;
+
+//----------------------------------------------------------------------------------------------------------------------
+string makeDocument(size_t _records) {
+	stringstream ss;
+	ss << "[";
+	for(size_t i = 0; i < _records; ++i) {
+		if(i)
+			ss << ",\n";
+		ss << "{\"id\": " << i << ", \"name\": \"record number " << i << "\", \"price\": " << i << ".25, ";
+		ss << "\"tags\": [\"archived\", \"compressed\"], \"valid\": " << ((i % 3) ? "true" : "false") << "}";
+	}
+	ss << "]";
+	return ss.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Throughput in MB/s of uncompressed data
+template<class Op_>
+double measure(const char* _format, const char* _name, size_t _bytes, unsigned _reps, Op_ _op) {
+	auto start = chrono::high_resolution_clock::now();
+	for(unsigned i = 0; i < _reps; ++i)
+		_op();
+	chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+	double mbps = double(_bytes) * _reps / elapsed.count() / (1024.0 * 1024.0);
+	cout << _format << ", " << _name << ": " << mbps << " MB/s\n";
+	return mbps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	const unsigned cReps = 5;
+	string plain = makeDocument(50000);
+	Json document;
+	document.parse(plain.c_str());
+	cout << "Document size: " << plain.size() << " bytes\n";
+
+	const char* names[] = { "none", "gzip", "zstd" };
+	for(Compression format : { Compression::none, Compression::gzip, Compression::zstd }) {
+		const char* name = names[int(format)];
+		if(!compressionSupported(format)) {
+			cout << name << ": not supported by this build\n";
+			continue;
+		}
+		string compressed;
+		measure(name, "serialize into a compressed stream", plain.size(), cReps, [&]() {
+			stringstream out;
+			CompressingStream compressing(out, format);
+			Serializer serializer;
+			serializer.serialize(document, compressing);
+			compressing.close();
+			compressed = out.str();
+		});
+		cout << name << ", compressed size: " << compressed.size() << " bytes\n";
+		measure(name, "serialize, then compress", plain.size(), cReps, [&]() {
+			string text = document.serialize();
+			stringstream out;
+			CompressingStream compressing(out, format);
+			compressing.write(text.data(), streamsize(text.size()));
+			compressing.close();
+		});
+		measure(name, "parse from a compressed stream", plain.size(), cReps, [&]() {
+			stringstream in(compressed);
+			DecompressingStream decompressing(in);
+			Json j;
+			j.parse(decompressing);
+		});
+		// What had to be done before: decompress the whole document to memory, then parse it
+		measure(name, "decompress, then parse", plain.size(), cReps, [&]() {
+			stringstream in(compressed);
+			DecompressingStream decompressing(in);
+			stringstream text;
+			text << decompressing.rdbuf();
+			Json j;
+			j.parse(text);
+		});
+	}
+	return 0;
+}
\ No newline at end of file
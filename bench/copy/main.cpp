@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Copy, modification, diff and destruction of a tree with a million nodes
+#include <chrono>
+#include <cjson/json.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Ten nodes per record
+Json makeTree(int _records) {
+	Json tree;
+	tree.parse("[]");
+	Json record;
+	for(int i = 0; i < _records; ++i) {
+		record["id"] = i;
+		record["name"] = "item number " + to_string(i);
+		record["price"] = float(i) * 0.25f;
+		record["tags"] = { "new", "sale" };
+		record["size"]["w"] = i % 10;
+		record["size"]["h"] = i % 7;
+		tree.push_back(record);
+	}
+	return tree;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class Op_>
+double measure(const char* _name, unsigned _reps, Op_ _op) {
+	auto start = chrono::high_resolution_clock::now();
+	for(unsigned i = 0; i < _reps; ++i)
+		_op(i);
+	chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+	double ms = elapsed.count() / _reps;
+	cout << _name << ": " << ms << " ms\n";
+	return ms;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	const unsigned cReps = 5;
+	Json tree = makeTree(100000);
+
+	vector<Json> copies(cReps);
+	measure("copy", cReps, [&](unsigned _i) {
+		copies[_i] = tree;
+	});
+	// Clones the outer array and a single record
+	measure("modify one record of a copy", cReps, [&](unsigned _i) {
+		copies[_i](_i)["id"] = -1;
+	});
+	// Only the changed record is visited
+	measure("diff against a modified copy", cReps, [&](unsigned _i) {
+		copies[_i] = tree.diff(copies[_i]);
+	});
+	Json rebuilt = makeTree(100000);
+	rebuilt(99999)["id"] = -1;
+	measure("diff against a modified rebuild", cReps, [&](unsigned _i) {
+		copies[_i] = tree.diff(rebuilt);
+	});
+	copies.clear();
+
+	Json equal = makeTree(100000);
+	bool same = true;
+	measure("compare with an equal rebuild", cReps, [&](unsigned) {
+		same = same && tree == equal;
+	});
+	measure("compare with a modified rebuild", cReps, [&](unsigned) {
+		same = same && !(tree == rebuilt);
+	});
+	measure("hash", 1, [&](unsigned) {
+		same = same && tree.hash() == equal.hash() && tree.hash() != rebuilt.hash();
+	});
+	// Cached hashes tell them apart right away
+	measure("compare with a modified rebuild, hashed", cReps, [&](unsigned) {
+		same = same && !(tree == rebuilt);
+	});
+	if(!same)
+		cout << "Comparisons failed\n";
+
+	// Make every tree the only owner of its nodes, so destroying it really frees them
+	vector<Json> trees;
+	for(unsigned i = 0; i < cReps; ++i)
+		trees.push_back(makeTree(100000));
+	measure("destruction", cReps, [&](unsigned _i) {
+		trees[_i].setNull();
+	});
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Replays the inputs the fuzzers found to be slow, through every fuzz target, and reports the time each one takes per
+// byte. Inputs over budget fail the run, so performance cliffs are caught like crashes.
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../fuzz/inputs.h"
+#include "../../fuzz/targets.h"
+
+using namespace cjson::fuzz;
+using namespace std;
+
+struct Target {
+	const char* name;
+	void (*run)(const uint8_t*, size_t);
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Average time of a run, repeating it for long enough to measure
+double measure(const Target& _target, const Input& _input) {
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(_input.data.data());
+	unsigned reps = 0;
+	auto start = chrono::steady_clock::now();
+	chrono::duration<double> elapsed(0);
+	do {
+		_target.run(data, _input.data.size());
+		++reps;
+		elapsed = chrono::steady_clock::now() - start;
+	} while(elapsed.count() < 0.02);
+	return elapsed.count() / reps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Usage: corpus_bench [budget in ns per byte] [corpus directory]
+int main(int _argc, const char** _argv)
+{
+	double budget = _argc > 1 ? atof(_argv[1]) : 10000;
+	string path = _argc > 2 ? _argv[2] : CJSON_FUZZ_CORPUS "/slow";
+	vector<Input> inputs;
+	if(!loadInputs(path, inputs) || inputs.empty()) {
+		cerr << "No inputs in " << path << "\n";
+		return 1;
+	}
+	const Target targets[] = { { "parse", parse }, { "roundtrip", roundTrip }, { "mutation", mutation } };
+
+	bool over = false;
+	cout << "Budget: " << budget << " ns per byte\n";
+	for(const Input& input : inputs) {
+		string name = input.name.substr(input.name.find_last_of("/\\") + 1);
+		cout << left << setw(24) << name << right << setw(8) << input.data.size() << " bytes";
+		for(const Target& target : targets) {
+			double seconds = measure(target, input);
+			double perByte = seconds * 1e9 / double(max<size_t>(input.data.size(), 1));
+			cout << "  " << target.name << ": " << fixed << setprecision(1) << perByte << " ns/B";
+			if(perByte > budget) {
+				cout << " (over budget)";
+				over = true;
+			}
+		}
+		cout << "\n";
+	}
+	return over ? 1 : 0;
+}
\ No newline at end of file
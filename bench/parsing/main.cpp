@@ -0,0 +1,233 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Parsing throughput benchmark
+#include <chrono>
+#include <cjson/columns.h>
+#include <cjson/json.h>
+#include <cjson/parseContext.h>
+#include <cjson/parser.h>
+#include <cjson/query.h>
+#include <cjson/utf8.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Record {
+	int id;
+	std::string name;
+	float price;
+	std::string description;
+};
+
+CJSON_REFLECT(Record, id, name, price, description)
+
+using namespace cjson;
+using namespace std;
+
+//----------------------------------------------------------------------------------------------------------------------
+// A document of records with text fields, a quarter of them with non ASCII characters.
+string makeDocument(size_t _records) {
+	stringstream ss;
+	ss << "[";
+	for(size_t i = 0; i < _records; ++i) {
+		if(i)
+			ss << ",";
+		ss << "{\"id\":" << i << ",\"name\":\"record number " << i << "\",\"price\":" << i << ".25,";
+		ss << "\"description\":\"";
+		if(i % 4)
+			ss << "a plain ascii description of the item";
+		else
+			ss << "descripci\xc3\xb3n del art\xc3\xad" "culo \xe2\x82\xac";
+		ss << "\"}";
+	}
+	ss << "]";
+	return ss.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class Op_>
+double measure(const char* _name, size_t _bytes, unsigned _reps, Op_ _op) {
+	auto start = chrono::high_resolution_clock::now();
+	for(unsigned i = 0; i < _reps; ++i)
+		_op();
+	chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+	double mbps = double(_bytes) * _reps / elapsed.count() / (1024.0 * 1024.0);
+	cout << _name << ": " << mbps << " MB/s\n";
+	return mbps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	const unsigned cReps = 10;
+	string doc = makeDocument(20000);
+	cout << "Document size: " << doc.size() << " bytes\n";
+
+	measure("parse", doc.size(), cReps, [&]() {
+		Json j;
+		Parser p(doc.c_str());
+		p.parse(j);
+	});
+	// Many small documents, like a service handling requests would see
+	string message = makeDocument(4);
+	const unsigned cMessages = 50000;
+	measure("small documents", message.size() * cMessages, 1, [&]() {
+		for(unsigned i = 0; i < cMessages; ++i) {
+			Json j;
+			j.parse(message.c_str());
+		}
+	});
+	ParseContext context;
+	measure("small documents, reused context", message.size() * cMessages, 1, [&]() {
+		for(unsigned i = 0; i < cMessages; ++i) {
+			Json j;
+			context.parse(message.data(), message.size(), j);
+		}
+	});
+	Schema record = Schema::object({
+		{ "id", Schema::ofType(Schema::Type::integer) },
+		{ "name", Schema::ofType(Schema::Type::text) },
+		{ "price", Schema::ofType(Schema::Type::real) },
+		{ "description", Schema::ofType(Schema::Type::text) },
+	});
+	Schema schema = Schema::array(record);
+	measure("parse with schema", doc.size(), cReps, [&]() {
+		Json j;
+		Parser p(doc.c_str());
+		p.parse(j, schema);
+	});
+	measure("parse + utf8 validation", doc.size(), cReps, [&]() {
+		Json j;
+		Parser p(doc.c_str());
+		p.setUtf8Validation(true);
+		p.parse(j);
+	});
+	measure("parse, strict", doc.size(), cReps, [&]() {
+		Json j;
+		StrictParser p(doc.c_str());
+		p.parse(j);
+	});
+	measure("parse, lenient", doc.size(), cReps, [&]() {
+		Json j;
+		LenientParser p(doc.c_str());
+		p.parse(j);
+	});
+	measure("utf8 validation alone", doc.size(), cReps * 10, [&]() {
+		isValidUtf8(doc.data(), doc.size());
+	});
+	measure("parse + convert to structs", doc.size(), cReps, [&]() {
+		Json j;
+		Parser p(doc.c_str());
+		p.parse(j);
+		vector<Record> records(j.size());
+		for(size_t i = 0; i < records.size(); ++i) {
+			const Json& element = j(i);
+			records[i].id = element["id"];
+			records[i].name = std::string(element["name"]);
+			records[i].price = element["price"];
+			records[i].description = std::string(element["description"]);
+		}
+	});
+	measure("read straight into structs", doc.size(), cReps, [&]() {
+		vector<Record> records;
+		Parser p(doc.c_str());
+		p.read(records);
+	});
+	measure("read into columns", doc.size(), cReps, [&]() {
+		vector<Column> columns = {
+			Column("id", Column::Type::int64),
+			Column("name", Column::Type::text),
+			Column("price", Column::Type::real),
+			Column("description", Column::Type::text),
+		};
+		Parser p(doc.c_str());
+		p.readColumns(columns);
+	});
+	measure("read one column", doc.size(), cReps, [&]() {
+		vector<Column> columns = { Column("price", Column::Type::real) };
+		Parser p(doc.c_str());
+		p.readColumns(columns);
+	});
+	Query query;
+	query.compile("$[*].price");
+	float total = 0.f;
+	measure("parse + query", doc.size(), cReps, [&]() {
+		Json j;
+		Parser p(doc.c_str());
+		p.parse(j);
+		query.select(j, [&total](const Json& _price) { total += float(_price); });
+	});
+	measure("query while parsing", doc.size(), cReps, [&]() {
+		QueryHandler handler(query, [&total](const Json& _price) { total += float(_price); });
+		Parser p(doc.c_str());
+		p.parse(handler);
+	});
+	if(total == 0.f)
+		cout << "Nothing matched\n";
+
+	// Arrays of numbers are stored packed
+	stringstream numbers;
+	numbers << "[";
+	for(int i = 0; i < 1000000; ++i)
+		numbers << (i ? "," : "") << i << ".5";
+	numbers << "]";
+	string numericDoc = numbers.str();
+	measure("parse numeric array", numericDoc.size(), cReps, [&]() {
+		Json j;
+		j.parse(numericDoc.c_str());
+	});
+	measure("parse numeric array, unpacked", numericDoc.size(), cReps, [&]() {
+		Json j;
+		Parser p(numericDoc.data(), numericDoc.size());
+		p.setArrayPacking(false);
+		p.parse(j);
+	});
+	Json packed;
+	packed.parse(numericDoc.c_str());
+	Json unpacked;
+	Parser unpackedParser(numericDoc.data(), numericDoc.size());
+	unpackedParser.setArrayPacking(false);
+	unpackedParser.parse(unpacked);
+	double sum = 0.0;
+	measure("sum packed reals", numericDoc.size(), cReps * 10, [&]() {
+		Span<const float> reals = packed.packedReals();
+		float partial = 0.f;
+		for(float x : reals)
+			partial += x;
+		sum += partial;
+	});
+	measure("sum through element access", numericDoc.size(), cReps * 10, [&]() {
+		const Json& elements = unpacked;
+		float partial = 0.f;
+		for(size_t i = 0; i < elements.size(); ++i)
+			partial += float(elements(i));
+		sum += partial;
+	});
+	if(sum == 0.0)
+		cout << "Nothing summed\n";
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Serializing into streams, strings and file descriptors
+#include <chrono>
+#include <cjson/json.h>
+#include <cjson/outputSink.h>
+#include <cjson/serializer.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace cjson;
+using namespace std;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Lots of small values a few levels deep, where the serializer writes many tiny pieces
+string makeDocument(size_t _records) {
+	stringstream ss;
+	ss << "[";
+	for(size_t i = 0; i < _records; ++i) {
+		if(i)
+			ss << ",\n";
+		ss << "{\"id\": " << i << ", \"name\": \"record number " << i << "\", \"price\": " << i << ".25, ";
+		ss << "\"position\": {\"x\": " << i % 640 << ", \"y\": " << i % 480 << ", \"layers\": [1, 2, 3]}, ";
+		ss << "\"tags\": [\"plain\", \"small\"], \"valid\": " << ((i % 3) ? "true" : "false") << "}";
+	}
+	ss << "]";
+	return ss.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Throughput in MB/s of serialized text
+template<class Op_>
+double measure(const char* _name, size_t _bytes, unsigned _reps, Op_ _op) {
+	auto start = chrono::high_resolution_clock::now();
+	for(unsigned i = 0; i < _reps; ++i)
+		_op();
+	chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+	double mbps = double(_bytes) * _reps / elapsed.count() / (1024.0 * 1024.0);
+	cout << _name << ": " << mbps << " MB/s\n";
+	return mbps;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	const unsigned cReps = 10;
+	const char* cPath = "serialization_bench.json";
+	Json document;
+	document.parse(makeDocument(50000).c_str());
+	size_t size = document.serialize().size();
+	cout << "Document size: " << size << " bytes\n";
+
+	measure("std::stringstream", size, cReps, [&]() {
+		stringstream out;
+		document.serialize(out);
+	});
+	measure("std::string", size, cReps, [&]() {
+		string text = document.serialize();
+	});
+	measure("std::ofstream", size, cReps, [&]() {
+		ofstream out(cPath, ios::binary);
+		document.serialize(out);
+	});
+	measure("FileSink", size, cReps, [&]() {
+		FILE* file = fopen(cPath, "wb");
+		{
+			FileSink sink(fileno(file));
+			document.serialize(sink);
+		}
+		fclose(file);
+	});
+	remove(cPath);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Memory and lookups on documents made of many short keys and strings
+#include <chrono>
+#include <cjson/json.h>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+using namespace cjson;
+using namespace std;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Count the bytes allocated by the documents
+size_t gAllocated = 0;
+
+void* operator new(size_t _size) {
+	void* p = malloc(_size + sizeof(max_align_t));
+	if(!p)
+		throw bad_alloc();
+	*static_cast<size_t*>(p) = _size;
+	gAllocated += _size;
+	return static_cast<char*>(p) + sizeof(max_align_t);
+}
+
+void operator delete(void* _p) noexcept {
+	if(!_p)
+		return;
+	char* block = static_cast<char*>(_p) - sizeof(max_align_t);
+	gAllocated -= *reinterpret_cast<size_t*>(block);
+	free(block);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Records with a dozen short keys each, most of them holding short strings
+string makeDocument(size_t _records) {
+	stringstream ss;
+	ss << "[";
+	for(size_t i = 0; i < _records; ++i) {
+		if(i)
+			ss << ",";
+		ss << "{\"id\":" << i << ",\"type\":\"order\",\"status\":\"" << ((i % 3) ? "open" : "closed") << "\",";
+		ss << "\"country\":\"ES\",\"currency\":\"EUR\",\"sku\":\"SKU-" << i % 1000 << "\",\"qty\":" << i % 10 << ",";
+		ss << "\"channel\":\"web\",\"lang\":\"es-ES\",\"tier\":\"gold\",\"region\":\"south\",";
+		ss << "\"note\":\"a longer free text note that doesn't fit inline\"}";
+	}
+	ss << "]";
+	return ss.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class Op_>
+double measure(const char* _name, unsigned _reps, Op_ _op) {
+	auto start = chrono::high_resolution_clock::now();
+	for(unsigned i = 0; i < _reps; ++i)
+		_op();
+	chrono::duration<double, milli> elapsed = chrono::high_resolution_clock::now() - start;
+	double ms = elapsed.count() / _reps;
+	cout << _name << ": " << ms << " ms\n";
+	return ms;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	const unsigned cReps = 5;
+	const size_t cRecords = 100000;
+	string text = makeDocument(cRecords);
+
+	size_t before = gAllocated;
+	Json doc;
+	doc.parse(text.c_str());
+	cout << "Document memory: " << (gAllocated - before) / cRecords << " bytes per record\n";
+
+	measure("parse", cReps, [&]() {
+		Json j;
+		j.parse(text.c_str());
+	});
+	const Json& records = doc;
+	size_t matches = 0;
+	measure("look up keys", cReps, [&]() {
+		for(size_t i = 0; i < cRecords; ++i) {
+			const Json& record = records(i);
+			matches += record["status"] == "open";
+			matches += record["region"] == "south";
+			matches += record["currency"] == "USD";
+		}
+	});
+	measure("compare strings", cReps, [&]() {
+		for(size_t i = 0; i + 1 < cRecords; ++i)
+			matches += records(i)["sku"] == records(i + 1)["sku"];
+	});
+	if(!matches)
+		cout << "Nothing matched\n";
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Runs a fuzz target on saved inputs, for compilers without libFuzzer. The inputs are the files and directories given
+// as arguments, or stdin if there are none, which is how AFL runs targets built with its compiler wrappers.
+// Inputs that take longer than -timeout=<seconds> fail the run like a crash would.
+#include "inputs.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* _data, size_t _size);
+
+using namespace cjson::fuzz;
+using namespace std;
+
+const char* gCurrentInput = "";
+
+//----------------------------------------------------------------------------------------------------------------------
+// Name the input that crashed, then crash as usual
+void reportCrash(int _signal) {
+	fprintf(stderr, "Crashed on input %s\n", gCurrentInput);
+	signal(_signal, SIG_DFL);
+	raise(_signal);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int _argc, const char** _argv)
+{
+	double timeout = 10;
+	vector<Input> inputs;
+	bool paths = false;
+	for(int i = 1; i < _argc; ++i) {
+		if(strncmp(_argv[i], "-timeout=", 9) == 0)
+			timeout = atof(_argv[i] + 9);
+		else if(_argv[i][0] == '-')
+			continue; // Other libFuzzer flags don't apply
+		else {
+			paths = true;
+			if(!loadInputs(_argv[i], inputs)) {
+				cerr << "Can't read " << _argv[i] << "\n";
+				return 1;
+			}
+		}
+	}
+	if(!paths) {
+		stringstream content;
+		content << cin.rdbuf();
+		Input input = { "stdin", content.str() };
+		inputs.push_back(input);
+	}
+
+	signal(SIGABRT, reportCrash);
+	signal(SIGSEGV, reportCrash);
+	signal(SIGFPE, reportCrash);
+	bool failed = false;
+	double slowest = 0;
+	string slowestName;
+	for(const Input& input : inputs) {
+		gCurrentInput = input.name.c_str();
+		auto start = chrono::steady_clock::now();
+		LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data.data()), input.data.size());
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+		if(elapsed.count() > timeout) {
+			cerr << "Slow input: " << input.name << " took " << elapsed.count() << " s\n";
+			failed = true;
+		}
+		if(elapsed.count() >= slowest) {
+			slowest = elapsed.count();
+			slowestName = input.name;
+		}
+	}
+	cout << "Ran " << inputs.size() << " inputs";
+	if(!inputs.empty())
+		cout << ", slowest " << slowestName << " in " << slowest * 1000 << " ms";
+	cout << "\n";
+	return failed ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "inputs.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+namespace cjson {
+	namespace fuzz {
+
+		namespace {
+			//----------------------------------------------------------------------------------------------------------
+			bool readFile(const std::string& _path, std::string& _data) {
+				std::ifstream file(_path, std::ios::binary);
+				if(!file)
+					return false;
+				std::stringstream content;
+				content << file.rdbuf();
+				_data = content.str();
+				return true;
+			}
+
+			//----------------------------------------------------------------------------------------------------------
+			// Names of the files in a directory. \c false if _path isn't a directory.
+			bool listDirectory(const std::string& _path, std::vector<std::string>& _names) {
+#ifdef _WIN32
+				WIN32_FIND_DATAA entry;
+				HANDLE find = FindFirstFileA((_path + "\\*").c_str(), &entry);
+				if(find == INVALID_HANDLE_VALUE)
+					return false;
+				do {
+					if(!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+						_names.push_back(entry.cFileName);
+				} while(FindNextFileA(find, &entry));
+				FindClose(find);
+#else
+				DIR* directory = opendir(_path.c_str());
+				if(!directory)
+					return false;
+				while(dirent* entry = readdir(directory)) {
+					if(entry->d_name[0] != '.') // Hidden files, and the directory itself
+						_names.push_back(entry->d_name);
+				}
+				closedir(directory);
+#endif
+				std::sort(_names.begin(), _names.end());
+				return true;
+			}
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		bool loadInputs(const std::string& _path, std::vector<Input>& _inputs) {
+			std::vector<std::string> names;
+			if(!listDirectory(_path, names)) {
+				Input input = { _path, std::string() };
+				if(!readFile(_path, input.data))
+					return false;
+				_inputs.push_back(input);
+				return true;
+			}
+			for(const std::string& name : names) {
+				Input input = { _path + "/" + name, std::string() };
+				if(readFile(input.name, input.data))
+					_inputs.push_back(input);
+			}
+			return true;
+		}
+
+	}	// namespace fuzz
+}	// namespace cjson
\ No newline at end of file
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Loading of fuzzer inputs from files and directories
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_FUZZ_INPUTS_H_
+#define _CJSON_FUZZ_INPUTS_H_
+
+#include <string>
+#include <vector>
+
+namespace cjson {
+	namespace fuzz {
+
+		struct Input {
+			std::string name;
+			std::string data;
+		};
+
+		/// Append the input in _path, or every file in it if it is a directory, in name order.
+		/// \return \c false if _path can't be read.
+		bool loadInputs(const std::string& _path, std::vector<Input>& _inputs);
+
+	}	// namespace fuzz
+}	// namespace cjson
+
+#endif // _CJSON_FUZZ_INPUTS_H_
\ No newline at end of file
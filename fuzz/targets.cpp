@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "targets.h"
+#include <cjson/json.h>
+#include <cjson/parseContext.h>
+#include <cjson/parser.h>
+#include <cjson/saxHandler.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cjson {
+	namespace fuzz {
+
+		namespace {
+			//----------------------------------------------------------------------------------------------------------
+			// Checked even when NDEBUG is defined, which assert isn't
+			void check(bool _holds, const char* _property) {
+				if(!_holds) {
+					fprintf(stderr, "Property doesn't hold: %s\n", _property);
+					abort();
+				}
+			}
+
+			//----------------------------------------------------------------------------------------------------------
+			// Reals may not survive serialization with all of their bits, and then documents are only compared as text
+			bool hasReals(const Json& _doc) {
+				if(_doc.memoryStats().reals) // Packed ones aren't counted by type
+					return true;
+				std::vector<const Json*> pending(1, &_doc);
+				while(!pending.empty()) {
+					const Json& value = *pending.back();
+					pending.pop_back();
+					if(value.isArray()) {
+						if(value.packedReals().size())
+							return true;
+						if(!value.isPacked()) {
+							for(const Json& element : value.asArray())
+								pending.push_back(&element);
+						}
+					}
+					else if(value.isObject()) {
+						for(auto member : value.items())
+							pending.push_back(&member.value);
+					}
+				}
+				return false;
+			}
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		void parse(const uint8_t* _data, size_t _size) {
+			const char* text = reinterpret_cast<const char*>(_data);
+			Parser parser(text, _size);
+			Json tree;
+			bool parsed = parser.parse(tree);
+			const ParseError error = parser.error();
+			check(parsed != bool(error), "the error is set exactly when parsing fails");
+			check(error.offset <= _size, "errors are located inside the input");
+			if(!parsed)
+				error.message();
+
+			// Every way of reading the input agrees on the result
+			std::istringstream stream(std::string(text, _size));
+			Parser streamed(stream);
+			Json fromStream;
+			check(streamed.parse(fromStream) == parsed, "streams parse like memory");
+			check(streamed.error().code == error.code && streamed.error().offset == error.offset,
+				"streams fail like memory");
+			Parser events(text, _size);
+			Json built;
+			JsonBuilder builder(built);
+			check(events.parse(builder) == parsed, "events parse like trees");
+			ParseContext context;
+			Json pooled;
+			check(context.parse(text, _size, pooled) == parsed, "pooled nodes parse like plain ones");
+			Parser unpacked(text, _size);
+			unpacked.setArrayPacking(false);
+			Json plain;
+			check(unpacked.parse(plain) == parsed, "packing doesn't change what parses");
+			if(parsed) {
+				check(fromStream == tree && built == tree && pooled == tree && plain == tree, "same documents");
+				check(fromStream.hash() == tree.hash() && plain.hash() == tree.hash(), "same hashes");
+			}
+
+			// Validation only rejects more
+			Parser validating(text, _size);
+			validating.setUtf8Validation(true);
+			Json valid;
+			if(validating.parse(valid))
+				check(parsed && valid == tree, "validation doesn't change documents");
+
+			// Strict parsers accept less than the default ones, lenient parsers more. Slashes may start comments
+			// inside unquoted keys.
+			StrictParser strict(text, _size);
+			Json standard;
+			if(strict.parse(standard))
+				check(parsed && standard == tree, "strict parsing doesn't change documents");
+			if(parsed && !memchr(text, '/', _size)) {
+				LenientParser lenient(text, _size);
+				Json extended;
+				check(lenient.parse(extended) && extended == tree, "lenient parsing accepts standard documents");
+			}
+
+			// Documents after the first one, and typed reads
+			for(int i = 0; i < 16 && parsed; ++i)
+				parsed = parser.parse(tree);
+			Parser reader(text, _size);
+			std::vector<int> integers;
+			reader.read(integers);
+			std::string terminated(text, _size);
+			Json doc;
+			doc.parse(terminated.c_str());
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		void roundTrip(const uint8_t* _data, size_t _size) {
+			Parser parser(reinterpret_cast<const char*>(_data), _size);
+			Json doc;
+			if(!parser.parse(doc))
+				return;
+			std::string first = doc.serialize();
+			std::ostringstream stream;
+			check(doc.serialize(stream) && stream.str() == first, "streams get the same serialization");
+			Json again;
+			check(again.parse(first.c_str()), "serialized documents parse");
+			check(again.serialize() == first, "serialization is stable");
+			if(!hasReals(doc))
+				check(again == doc && again.hash() == doc.hash(), "documents survive serialization");
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		void mutation(const uint8_t* _data, size_t _size) {
+			const char* text = reinterpret_cast<const char*>(_data);
+			const char* split = static_cast<const char*>(memchr(text, '\n', _size));
+			if(!split)
+				return;
+			Parser documentParser(text, size_t(split - text));
+			Parser patchParser(split + 1, _size - size_t(split - text) - 1);
+			Json doc, patch;
+			if(!documentParser.parse(doc) || !patchParser.parse(patch))
+				return;
+			const Json original = doc; // Shares the content of doc
+			const std::string serialized = doc.serialize();
+
+			Json patched = doc;
+			if(patched.applyPatch(patch)) {
+				Json difference = doc.diff(patched);
+				Json replayed = doc;
+				check(replayed.applyPatch(difference), "diffs apply");
+				check(replayed == patched, "diffs reproduce their target");
+				size_t operations = 0;
+				doc.diff(patched, [&operations](const Json&) { ++operations; });
+				check(operations == difference.size(), "streamed diffs match collected ones");
+			}
+			else
+				check(patched == doc, "failed patches are undone");
+
+			Json merged = doc;
+			merged.mergePatch(patch);
+			Json edited = doc;
+			if(edited.isObject() && patch.isObject()) {
+				for(auto member : patch.items())
+					edited[member.key] = member.value;
+			}
+			else if(edited.isArray()) {
+				edited.push_back(patch);
+				if(edited.size() > 1)
+					edited(0) = patch;
+			}
+			check(doc == original && doc.serialize() == serialized, "copies never change the original");
+		}
+
+	}	// namespace fuzz
+}	// namespace cjson
\ No newline at end of file
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Fuzz targets. Each one checks properties of the library on arbitrary input, and aborts when one doesn't hold.
+// They are shared by the fuzzers and by the benchmark that replays the corpus of slow inputs.
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_FUZZ_TARGETS_H_
+#define _CJSON_FUZZ_TARGETS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cjson {
+	namespace fuzz {
+
+		/// Parse through every input path: memory, streams, events, pooled nodes, typed reads. They must agree.
+		void parse(const uint8_t* _data, size_t _size);
+		/// Serialized documents parse back to the same serialization, and to the same document if it has no reals.
+		void roundTrip(const uint8_t* _data, size_t _size);
+		/// A document and a patch, separated by the first new line. Patches, diffs, merge patches and direct edits must
+		/// be consistent with each other, and never change copies of the document.
+		void mutation(const uint8_t* _data, size_t _size);
+
+	}	// namespace fuzz
+}	// namespace cjson
+
+#endif // _CJSON_FUZZ_TARGETS_H_
\ No newline at end of file
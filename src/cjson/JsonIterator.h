@@ -29,6 +29,11 @@
 #ifndef _CJSON_JSONITERATORS_H_
 #define _CJSON_JSONITERATORS_H_
 
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
 namespace cjson{
 	// Traits
 	template<class Type_>
@@ -44,11 +49,19 @@ namespace cjson{
 	};
 
 	// Template
+	/// Iterates over the elements of either an array or an object, whichever the Json turns out to be.
+	/// When the type is known, ArrayIterator and ObjectIterator do the same without checking it on every step.
 	template<class Type_>
 	class Iterator{
 	public:
 		typedef IteratorTrait<Type_>	Trait;
 
+		typedef std::forward_iterator_tag					iterator_category;
+		typedef typename std::remove_const<Type_>::type		value_type;
+		typedef std::ptrdiff_t								difference_type;
+		typedef Type_*										pointer;
+		typedef Type_&										reference;
+
 		Iterator();
 
 		Iterator(typename Trait::mArrayIteratorType _iterator);
@@ -72,6 +85,116 @@ namespace cjson{
 		typename Trait::mArrayIteratorType	mArrayIterator;
 		typename Trait::mObjIteratorType	mObjectIterator;
 	};
+
+	/// Random access iterator over the elements of an array
+	template<class Type_>
+	class ArrayIterator{
+	public:
+		typedef IteratorTrait<Type_>	Trait;
+
+		typedef std::random_access_iterator_tag				iterator_category;
+		typedef typename std::remove_const<Type_>::type		value_type;
+		typedef std::ptrdiff_t								difference_type;
+		typedef Type_*										pointer;
+		typedef Type_&										reference;
+
+		ArrayIterator();
+		explicit ArrayIterator(typename Trait::mArrayIteratorType _iterator);
+
+		Type_&	operator*() const;
+		Type_*	operator->() const;
+		Type_&	operator[](difference_type _n) const;
+
+		ArrayIterator&	operator++();
+		ArrayIterator	operator++(int);
+		ArrayIterator&	operator--();
+		ArrayIterator	operator--(int);
+		ArrayIterator&	operator+=(difference_type _n);
+		ArrayIterator&	operator-=(difference_type _n);
+		ArrayIterator	operator+(difference_type _n) const;
+		ArrayIterator	operator-(difference_type _n) const;
+		difference_type	operator-(const ArrayIterator& _other) const;
+
+		bool	operator==(const ArrayIterator& _other) const;
+		bool	operator!=(const ArrayIterator& _other) const;
+		bool	operator<(const ArrayIterator& _other) const;
+		bool	operator>(const ArrayIterator& _other) const;
+		bool	operator<=(const ArrayIterator& _other) const;
+		bool	operator>=(const ArrayIterator& _other) const;
+
+	private:
+		typename Trait::mArrayIteratorType	mIterator;
+	};
+
+	template<class Type_>
+	ArrayIterator<Type_> operator+(typename ArrayIterator<Type_>::difference_type _n, const ArrayIterator<Type_>& _it);
+
+	/// Member of an object, as seen through an ObjectIterator
+	template<class Type_>
+	struct Member {
+		const std::string&	key;
+		Type_&				value;
+	};
+
+	/// Iterator over the members of an object, in key order. It can also step back with operator--.
+	/// Dereferencing gives a Member by value, which refers to the key and value stored in the object. Since that isn't
+	/// a real reference, the iterator is only tagged as an input iterator, and algorithms that need forward iterators
+	/// should go through key() and value() on a Json::iterator instead.
+	template<class Type_>
+	class ObjectIterator{
+	public:
+		typedef IteratorTrait<Type_>	Trait;
+
+		/// Holds the Member that operator-> points to
+		struct MemberPointer {
+			Member<Type_> member;
+			const Member<Type_>* operator->() const { return &member; }
+		};
+
+		typedef std::input_iterator_tag			iterator_category;
+		typedef Member<Type_>					value_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef MemberPointer					pointer;
+		typedef Member<Type_>					reference;
+
+		ObjectIterator();
+		explicit ObjectIterator(typename Trait::mObjIteratorType _iterator);
+
+		Member<Type_>	operator*() const;
+		MemberPointer	operator->() const;
+		const std::string&	key() const;
+		Type_&				value() const;
+
+		ObjectIterator&	operator++();
+		ObjectIterator	operator++(int);
+		ObjectIterator&	operator--();
+		ObjectIterator	operator--(int);
+
+		bool	operator==(const ObjectIterator& _other) const;
+		bool	operator!=(const ObjectIterator& _other) const;
+
+	private:
+		typename Trait::mObjIteratorType	mIterator;
+	};
+
+	/// Range of elements or members, as returned by Json::asArray() and Json::items()
+	template<class Iterator_>
+	class View{
+	public:
+		typedef Iterator_	iterator;
+
+		View(Iterator_ _begin, Iterator_ _end, size_t _size) : mBegin(_begin), mEnd(_end), mSize(_size) {}
+
+		Iterator_	begin() const { return mBegin; }
+		Iterator_	end() const { return mEnd; }
+		size_t		size() const { return mSize; }
+		bool		empty() const { return mSize == 0; }
+
+	private:
+		Iterator_	mBegin;
+		Iterator_	mEnd;
+		size_t		mSize;
+	};
 }
 
 #include "JsonIterator.inl"
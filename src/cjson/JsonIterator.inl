@@ -118,4 +118,222 @@ namespace cjson{
 		return (*mObjectIterator).first;
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_>::ArrayIterator()
+		: mIterator()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_>::ArrayIterator(typename Trait::mArrayIteratorType _iterator)
+		: mIterator(_iterator)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	Type_& ArrayIterator<Type_>::operator*() const {
+		return **mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	Type_* ArrayIterator<Type_>::operator->() const {
+		return *mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	Type_& ArrayIterator<Type_>::operator[](difference_type _n) const {
+		return *mIterator[_n];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_>& ArrayIterator<Type_>::operator++() {
+		++mIterator;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_> ArrayIterator<Type_>::operator++(int) {
+		ArrayIterator res(*this);
+		++mIterator;
+		return res;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_>& ArrayIterator<Type_>::operator--() {
+		--mIterator;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_> ArrayIterator<Type_>::operator--(int) {
+		ArrayIterator res(*this);
+		--mIterator;
+		return res;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_>& ArrayIterator<Type_>::operator+=(difference_type _n) {
+		mIterator += _n;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_>& ArrayIterator<Type_>::operator-=(difference_type _n) {
+		mIterator -= _n;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_> ArrayIterator<Type_>::operator+(difference_type _n) const {
+		return ArrayIterator(mIterator + _n);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_> ArrayIterator<Type_>::operator-(difference_type _n) const {
+		return ArrayIterator(mIterator - _n);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	typename ArrayIterator<Type_>::difference_type ArrayIterator<Type_>::operator-(const ArrayIterator& _other) const {
+		return mIterator - _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ArrayIterator<Type_>::operator==(const ArrayIterator& _other) const {
+		return mIterator == _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ArrayIterator<Type_>::operator!=(const ArrayIterator& _other) const {
+		return mIterator != _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ArrayIterator<Type_>::operator<(const ArrayIterator& _other) const {
+		return mIterator < _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ArrayIterator<Type_>::operator>(const ArrayIterator& _other) const {
+		return mIterator > _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ArrayIterator<Type_>::operator<=(const ArrayIterator& _other) const {
+		return mIterator <= _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ArrayIterator<Type_>::operator>=(const ArrayIterator& _other) const {
+		return mIterator >= _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ArrayIterator<Type_> operator+(typename ArrayIterator<Type_>::difference_type _n, const ArrayIterator<Type_>& _it) {
+		return _it + _n;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ObjectIterator<Type_>::ObjectIterator()
+		: mIterator()
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ObjectIterator<Type_>::ObjectIterator(typename Trait::mObjIteratorType _iterator)
+		: mIterator(_iterator)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	Member<Type_> ObjectIterator<Type_>::operator*() const {
+		Member<Type_> member = { mIterator->first, *mIterator->second };
+		return member;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	typename ObjectIterator<Type_>::MemberPointer ObjectIterator<Type_>::operator->() const {
+		MemberPointer pointer = { **this };
+		return pointer;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	const std::string& ObjectIterator<Type_>::key() const {
+		return mIterator->first;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	Type_& ObjectIterator<Type_>::value() const {
+		return *mIterator->second;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ObjectIterator<Type_>& ObjectIterator<Type_>::operator++() {
+		++mIterator;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ObjectIterator<Type_> ObjectIterator<Type_>::operator++(int) {
+		ObjectIterator res(*this);
+		++mIterator;
+		return res;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ObjectIterator<Type_>& ObjectIterator<Type_>::operator--() {
+		--mIterator;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	ObjectIterator<Type_> ObjectIterator<Type_>::operator--(int) {
+		ObjectIterator res(*this);
+		--mIterator;
+		return res;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ObjectIterator<Type_>::operator==(const ObjectIterator& _other) const {
+		return mIterator == _other.mIterator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Type_>
+	bool ObjectIterator<Type_>::operator!=(const ObjectIterator& _other) const {
+		return mIterator != _other.mIterator;
+	}
+
 }	//	 namespace cjson;
\ No newline at end of file
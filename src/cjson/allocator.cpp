@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "allocator.h"
+
+#include <new>
+
+namespace cjson {
+
+	namespace {
+		//--------------------------------------------------------------------------------------------------------------
+		void* defaultAllocate(size_t _size, void*) {
+			return ::operator new(_size);
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		void defaultDeallocate(void* _p, size_t, void*) {
+			::operator delete(_p);
+		}
+
+		Allocator gAllocator = { defaultAllocate, defaultDeallocate, nullptr };
+		thread_local AllocationCounters gCounters = { 0, 0, 0, 0 };
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void setAllocator(const Allocator& _allocator) {
+		if(!_allocator.allocate && !_allocator.deallocate)
+			gAllocator = { defaultAllocate, defaultDeallocate, nullptr };
+		else
+			gAllocator = _allocator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const Allocator& getAllocator() {
+		return gAllocator;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void* allocateMemory(size_t _size) {
+		void* p = gAllocator.allocate(_size, gAllocator.user);
+		if(!p)
+			throw std::bad_alloc();
+		++gCounters.allocations;
+		gCounters.allocatedBytes += _size;
+		return p;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void freeMemory(void* _p, size_t _size) {
+		if(!_p)
+			return;
+		gAllocator.deallocate(_p, _size, gAllocator.user);
+		++gCounters.deallocations;
+		gCounters.freedBytes += _size;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const AllocationCounters& allocationCounters() {
+		return gCounters;
+	}
+
+}	// namespace cjson
\ No newline at end of file
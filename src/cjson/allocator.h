@@ -0,0 +1,95 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_ALLOCATOR_H_
+#define _CJSON_ALLOCATOR_H_
+
+#include <cstddef>
+
+namespace cjson {
+
+	/// \struct Allocator
+	/// \brief Where the memory of Json values comes from: nodes, containers, the elements and members held in them,
+	/// and strings too long to be stored inline. Object keys are std::strings, so the ones too long for the string
+	/// itself still come from the global operator new, as does the scratch memory of parsers and serializers.
+	/// Memory is given back to whichever allocator is set when it is freed, so the allocator should be set before
+	/// any Json is created. Switching later is only safe between allocators that can free each other's memory, like
+	/// one that counts allocations and forwards them to the default.
+	struct Allocator {
+		void*	(*allocate)(size_t _size, void* _user); ///< Must not return null
+		void	(*deallocate)(void* _p, size_t _size, void* _user); ///< _size is the one _p was allocated with
+		void*	user; ///< Passed back to both functions
+	};
+
+	/// Replace the allocator used for Json values. Not thread safe: set it before other threads use any Json.
+	/// Leaving both functions null restores the default, which uses the global operator new and delete.
+	void				setAllocator(const Allocator& _allocator);
+	const Allocator&	getAllocator();
+
+	void*	allocateMemory(size_t _size); ///< Through the current allocator
+	void	freeMemory(void* _p, size_t _size); ///< Through the current allocator
+
+	/// \struct AllocationCounters
+	/// \brief Memory taken and given back through allocateMemory() and freeMemory() by one thread, whichever Allocator
+	/// is set. Subtract the counters read before an operation, like a parse, a copy or serializing, from the ones read
+	/// after it to see what it allocated.
+	struct AllocationCounters {
+		size_t	allocations;
+		size_t	deallocations;
+		size_t	allocatedBytes;
+		size_t	freedBytes;
+
+		AllocationCounters operator-(const AllocationCounters& _before) const {
+			return { allocations - _before.allocations, deallocations - _before.deallocations,
+				allocatedBytes - _before.allocatedBytes, freedBytes - _before.freedBytes };
+		}
+	};
+
+	/// Counters of the calling thread, since it started
+	const AllocationCounters&	allocationCounters();
+
+	/// \class HookAllocator
+	/// \brief Standard allocator that takes its memory from the current Allocator, for the containers inside Json.
+	template<class T_>
+	class HookAllocator {
+	public:
+		typedef T_ value_type;
+
+		HookAllocator() {}
+		template<class U_>
+		HookAllocator(const HookAllocator<U_>&) {}
+
+		T_*		allocate(size_t _n) { return static_cast<T_*>(allocateMemory(_n * sizeof(T_))); }
+		void	deallocate(T_* _p, size_t _n) { freeMemory(_p, _n * sizeof(T_)); }
+
+		template<class U_>
+		bool operator==(const HookAllocator<U_>&) const { return true; }
+		template<class U_>
+		bool operator!=(const HookAllocator<U_>&) const { return false; }
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_ALLOCATOR_H_
\ No newline at end of file
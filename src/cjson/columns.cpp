@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "columns.h"
+#include <cassert>
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	Column::Column(const std::string& _path, Type _type)
+		: mPath(_path)
+		, mType(_type)
+		, mRows(0)
+	{
+		if(mType == Type::text)
+			mOffsets.push_back(0);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Column::isNull(size_t _row) const {
+		assert(_row < mRows);
+		return !(mValidity[_row / 8] & (1u << (_row % 8)));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::clear() {
+		truncate(0);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	std::string Column::text(size_t _row) const {
+		assert(mType == Type::text && _row < mRows);
+		return mCharacters.substr(mOffsets[_row], mOffsets[_row + 1] - mOffsets[_row]);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::addRow() {
+		if(mRows % 8 == 0)
+			mValidity.push_back(0);
+		++mRows;
+		switch(mType) {
+		case Type::int64:
+			mIntegers.push_back(0);
+			break;
+		case Type::real:
+			mReals.push_back(0.0);
+			break;
+		case Type::boolean:
+			mBooleans.push_back(0);
+			break;
+		case Type::text:
+			mOffsets.push_back(mCharacters.size());
+			break;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::truncate(size_t _rows) {
+		assert(_rows <= mRows);
+		mRows = _rows;
+		mValidity.resize((_rows + 7) / 8);
+		if(_rows % 8) // Clear the bits of the removed rows that share a byte with the kept ones
+			mValidity.back() &= uint8_t((1u << (_rows % 8)) - 1);
+		switch(mType) {
+		case Type::int64:
+			mIntegers.resize(_rows);
+			break;
+		case Type::real:
+			mReals.resize(_rows);
+			break;
+		case Type::boolean:
+			mBooleans.resize(_rows);
+			break;
+		case Type::text:
+			mOffsets.resize(_rows + 1);
+			mCharacters.resize(mOffsets.back());
+			break;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::setInteger(int64_t _value) {
+		mIntegers.back() = _value;
+		setValid();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::setReal(double _value) {
+		mReals.back() = _value;
+		setValid();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::setBoolean(bool _value) {
+		mBooleans.back() = _value;
+		setValid();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// A repeated key replaces the text of the row
+	void Column::setText(const std::string& _value) {
+		mCharacters.resize(mOffsets[mRows - 1]);
+		mCharacters += _value;
+		mOffsets.back() = mCharacters.size();
+		setValid();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Column::setValid() {
+		mValidity.back() |= uint8_t(1u << ((mRows - 1) % 8));
+	}
+
+}	// namespace cjson
\ No newline at end of file
@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_COLUMNS_H_
+#define _CJSON_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cjson {
+
+	template<class Options_> class BasicParser;
+
+	/// \class Column
+	/// \brief Values of one field across the records of an array, stored contiguously.
+	/// Parser::readColumns fills columns straight from the input, so arrays of records can be loaded for analysis
+	/// without building a Json node per record. Missing and null values are marked in a validity bitmap, and leave a
+	/// zero (or an empty string) in the values so every row keeps its slot.
+	class Column {
+	public:
+		enum class Type {
+			int64,
+			real, ///< Stored as double
+			boolean,
+			text, ///< Characters of all the rows back to back, delimited by offsets
+		};
+
+		/// \param _path Member names separated by dots, e.g. "pos.x" for the x member of the pos member of each record
+		Column(const std::string& _path, Type _type);
+
+		const std::string&	path() const { return mPath; }
+		Type				type() const { return mType; }
+		size_t				size() const { return mRows; } ///< Number of rows
+		bool				isNull(size_t _row) const;
+		void				clear(); ///< Remove all rows
+
+		/// One bit per row, set for the rows that have a value. Row i is bit i % 8 of byte i / 8.
+		const std::vector<uint8_t>&	validity() const { return mValidity; }
+		const std::vector<int64_t>&	integers() const { return mIntegers; } ///< Only for int64 columns
+		const std::vector<double>&	reals() const { return mReals; } ///< Only for real columns
+		const std::vector<uint8_t>&	booleans() const { return mBooleans; } ///< 0 or 1. Only for boolean columns.
+		// Text columns
+		const std::string&			characters() const { return mCharacters; }
+		/// size() + 1 entries. The text of row i goes from offsets()[i] to offsets()[i + 1] in characters().
+		const std::vector<size_t>&	offsets() const { return mOffsets; }
+		std::string					text(size_t _row) const;
+
+	private:
+		template<class> friend class BasicParser;
+
+		void	addRow(); ///< Append a null row
+		void	truncate(size_t _rows);
+		// Fill in the last row
+		void	setInteger(int64_t _value);
+		void	setReal(double _value);
+		void	setBoolean(bool _value);
+		void	setText(const std::string& _value);
+		void	setValid();
+
+		std::string				mPath;
+		Type					mType;
+		size_t					mRows;
+		std::vector<uint8_t>	mValidity;
+		std::vector<int64_t>	mIntegers;
+		std::vector<double>		mReals;
+		std::vector<uint8_t>	mBooleans;
+		std::string				mCharacters;
+		std::vector<size_t>		mOffsets;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_COLUMNS_H_
\ No newline at end of file
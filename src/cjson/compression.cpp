@@ -0,0 +1,630 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "compression.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#ifdef CJSON_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CJSON_ZSTD
+#include <zstd.h>
+#endif
+
+namespace cjson {
+
+	namespace {
+		/// Size of the blocks of data handed to the codecs, compressed or not
+		const size_t cBlockSize = 64 * 1024;
+		/// Uncompressed input kept after it has been read, so readers can seek back into it
+		const size_t cHistorySize = 64 * 1024;
+
+		enum class Status {
+			more, ///< Call again, with more input or room for output
+			done, ///< All the input is consumed, and the requested flush is complete
+			error,
+		};
+
+		enum class Flush {
+			none,
+			sync, ///< Make everything compressed so far decodable
+			finish, ///< End the compressed data
+		};
+
+		//--------------------------------------------------------------------------------------------------------------
+		/// Moves data from one buffer to another, compressing or decompressing it. Both buffers are advanced over what
+		/// is consumed and produced.
+		class Codec {
+		public:
+			Codec() : mError(nullptr) {}
+			virtual ~Codec() {}
+			const char* error() const { return mError; }
+
+		protected:
+			Status fail(const char* _error) {
+				mError = _error;
+				return Status::error;
+			}
+
+			const char* mError;
+		};
+
+		class Decoder : public Codec {
+		public:
+			/// Returns done at the end of the compressed data. _lastInput tells that no more input will come.
+			virtual Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, bool _lastInput) = 0;
+		};
+
+		class Encoder : public Codec {
+		public:
+			virtual Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, Flush _flush) = 0;
+		};
+
+		//--------------------------------------------------------------------------------------------------------------
+		size_t copy(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd) {
+			size_t n = std::min(size_t(_inEnd - _in), size_t(_outEnd - _out));
+			if(n)
+				memcpy(_out, _in, n);
+			_in += n;
+			_out += n;
+			return n;
+		}
+
+		class CopyDecoder : public Decoder {
+		public:
+			Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, bool _lastInput) override {
+				copy(_in, _inEnd, _out, _outEnd);
+				return (_lastInput && _in == _inEnd) ? Status::done : Status::more;
+			}
+		};
+
+		class CopyEncoder : public Encoder {
+		public:
+			Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, Flush) override {
+				copy(_in, _inEnd, _out, _outEnd);
+				return _in == _inEnd ? Status::done : Status::more;
+			}
+		};
+
+#ifdef CJSON_ZLIB
+		//--------------------------------------------------------------------------------------------------------------
+		const int cGzipWindowBits = 15 + 16; // Largest window, with a gzip header instead of a zlib one
+
+		class GzipDecoder : public Decoder {
+		public:
+			GzipDecoder() : mMemberStart(true) {
+				memset(&mStream, 0, sizeof(mStream));
+				if(inflateInit2(&mStream, cGzipWindowBits) != Z_OK)
+					fail("couldn't initialize zlib");
+			}
+
+			~GzipDecoder() {
+				inflateEnd(&mStream);
+			}
+
+			Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, bool _lastInput) override {
+				if(mError)
+					return Status::error;
+				mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(_in));
+				mStream.avail_in = uInt(_inEnd - _in);
+				mStream.next_out = reinterpret_cast<Bytef*>(_out);
+				mStream.avail_out = uInt(_outEnd - _out);
+				int result = inflate(&mStream, Z_NO_FLUSH);
+				const char* in = reinterpret_cast<const char*>(mStream.next_in);
+				char* out = reinterpret_cast<char*>(mStream.next_out);
+				bool progress = in != _in || out != _out;
+				if(in != _in)
+					mMemberStart = false;
+				_in = in;
+				_out = out;
+				if(result == Z_STREAM_END) { // Files can hold several gzip members in a row
+					inflateReset(&mStream);
+					mMemberStart = true;
+					return Status::more;
+				}
+				if(result != Z_OK && result != Z_BUF_ERROR)
+					return fail(mStream.msg ? mStream.msg : "corrupt gzip data");
+				if(!progress && _lastInput && _in == _inEnd)
+					return mMemberStart ? Status::done : fail("truncated gzip data");
+				return Status::more;
+			}
+
+		private:
+			z_stream	mStream;
+			bool		mMemberStart; ///< Between members, where the input may end
+		};
+
+		//--------------------------------------------------------------------------------------------------------------
+		class GzipEncoder : public Encoder {
+		public:
+			GzipEncoder(int _level) {
+				memset(&mStream, 0, sizeof(mStream));
+				int level = _level ? _level : Z_DEFAULT_COMPRESSION;
+				if(deflateInit2(&mStream, level, Z_DEFLATED, cGzipWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+					fail("couldn't initialize zlib");
+			}
+
+			~GzipEncoder() {
+				deflateEnd(&mStream);
+			}
+
+			Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, Flush _flush) override {
+				if(mError)
+					return Status::error;
+				mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(_in));
+				mStream.avail_in = uInt(_inEnd - _in);
+				mStream.next_out = reinterpret_cast<Bytef*>(_out);
+				mStream.avail_out = uInt(_outEnd - _out);
+				int mode = _flush == Flush::finish ? Z_FINISH : _flush == Flush::sync ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+				int result = deflate(&mStream, mode);
+				_in = reinterpret_cast<const char*>(mStream.next_in);
+				_out = reinterpret_cast<char*>(mStream.next_out);
+				if(result == Z_STREAM_ERROR)
+					return fail("gzip compression failed");
+				if(_flush == Flush::finish)
+					return result == Z_STREAM_END ? Status::done : Status::more;
+				// With room left in the output, nothing is pending
+				return (_in == _inEnd && mStream.avail_out) ? Status::done : Status::more;
+			}
+
+		private:
+			z_stream mStream;
+		};
+#endif // CJSON_ZLIB
+
+#ifdef CJSON_ZSTD
+		//--------------------------------------------------------------------------------------------------------------
+		class ZstdDecoder : public Decoder {
+		public:
+			ZstdDecoder() : mStream(ZSTD_createDStream()), mFrameEnd(true) {
+				if(!mStream || ZSTD_isError(ZSTD_initDStream(mStream)))
+					fail("couldn't initialize zstd");
+			}
+
+			~ZstdDecoder() {
+				ZSTD_freeDStream(mStream);
+			}
+
+			Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, bool _lastInput) override {
+				if(mError)
+					return Status::error;
+				ZSTD_inBuffer in = { _in, size_t(_inEnd - _in), 0 };
+				ZSTD_outBuffer out = { _out, size_t(_outEnd - _out), 0 };
+				size_t result = ZSTD_decompressStream(mStream, &out, &in);
+				if(ZSTD_isError(result))
+					return fail(ZSTD_getErrorName(result));
+				_in += in.pos;
+				_out += out.pos;
+				bool progress = in.pos || out.pos;
+				if(progress) // Frames can follow each other
+					mFrameEnd = result == 0;
+				if(!progress && _lastInput && _in == _inEnd)
+					return mFrameEnd ? Status::done : fail("truncated zstd data");
+				return Status::more;
+			}
+
+		private:
+			ZSTD_DStream*	mStream;
+			bool			mFrameEnd; ///< Between frames, where the input may end
+		};
+
+		//--------------------------------------------------------------------------------------------------------------
+		class ZstdEncoder : public Encoder {
+		public:
+			ZstdEncoder(int _level) : mStream(ZSTD_createCStream()) {
+				int level = _level ? _level : ZSTD_CLEVEL_DEFAULT;
+				if(!mStream || ZSTD_isError(ZSTD_CCtx_setParameter(mStream, ZSTD_c_compressionLevel, level)))
+					fail("couldn't initialize zstd");
+			}
+
+			~ZstdEncoder() {
+				ZSTD_freeCStream(mStream);
+			}
+
+			Status run(const char*& _in, const char* _inEnd, char*& _out, char* _outEnd, Flush _flush) override {
+				if(mError)
+					return Status::error;
+				ZSTD_inBuffer in = { _in, size_t(_inEnd - _in), 0 };
+				ZSTD_outBuffer out = { _out, size_t(_outEnd - _out), 0 };
+				ZSTD_EndDirective mode = _flush == Flush::finish ? ZSTD_e_end
+					: _flush == Flush::sync ? ZSTD_e_flush : ZSTD_e_continue;
+				size_t pending = ZSTD_compressStream2(mStream, &out, &in, mode);
+				if(ZSTD_isError(pending))
+					return fail(ZSTD_getErrorName(pending));
+				_in += in.pos;
+				_out += out.pos;
+				if(_flush == Flush::none)
+					return _in == _inEnd ? Status::done : Status::more;
+				return pending == 0 ? Status::done : Status::more;
+			}
+
+		private:
+			ZSTD_CStream* mStream;
+		};
+#endif // CJSON_ZSTD
+
+		//--------------------------------------------------------------------------------------------------------------
+		const char* cUnsupported = "the library was built without support for this compression format";
+
+		Decoder* makeDecoder(Compression _format) {
+			switch(_format) {
+			case Compression::none: return new CopyDecoder();
+#ifdef CJSON_ZLIB
+			case Compression::gzip: return new GzipDecoder();
+#endif
+#ifdef CJSON_ZSTD
+			case Compression::zstd: return new ZstdDecoder();
+#endif
+			default: return nullptr;
+			}
+		}
+
+		Encoder* makeEncoder(Compression _format, int _level) {
+			switch(_format) {
+			case Compression::none: return new CopyEncoder();
+#ifdef CJSON_ZLIB
+			case Compression::gzip: return new GzipEncoder(_level);
+#endif
+#ifdef CJSON_ZSTD
+			case Compression::zstd: return new ZstdEncoder(_level);
+#endif
+			default: return nullptr;
+			}
+		}
+
+		/// Format given by the magic number at the start of the data
+		Compression detect(const char* _data, size_t _size) {
+			const unsigned char* p = reinterpret_cast<const unsigned char*>(_data);
+			if(_size >= 2 && p[0] == 0x1f && p[1] == 0x8b)
+				return Compression::gzip;
+			if(_size >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd)
+				return Compression::zstd;
+			return Compression::none;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool compressionSupported(Compression _format) {
+		switch(_format) {
+		case Compression::none:
+		case Compression::automatic:
+			return true;
+#ifdef CJSON_ZLIB
+		case Compression::gzip:
+			return true;
+#endif
+#ifdef CJSON_ZSTD
+		case Compression::zstd:
+			return true;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	/// The get area is a window over the uncompressed data: the history kept for seeking back, followed by the last
+	/// block decompressed
+	class DecompressingStream::Buffer : public std::streambuf {
+	public:
+		Buffer(std::istream& _source, Compression _format)
+			: mSource(_source)
+			, mFormat(_format)
+			, mError(compressionSupported(_format) ? nullptr : cUnsupported)
+			, mInput(cBlockSize)
+			, mInputNext(nullptr)
+			, mInputEnd(nullptr)
+			, mSourceEnded(false)
+			, mEnded(mError != nullptr)
+			, mOutput(cHistorySize + cBlockSize)
+			, mOutputOffset(0)
+		{
+		}
+
+		Compression format() const { return mFormat; }
+		const char* error() const { return mError; }
+
+	protected:
+		int_type underflow() override;
+		pos_type seekoff(off_type _offset, std::ios_base::seekdir _dir, std::ios_base::openmode _which) override;
+		pos_type seekpos(pos_type _pos, std::ios_base::openmode _which) override;
+
+	private:
+		void readSource();
+		bool start(); ///< Detect the format and create the decoder
+
+		std::istream&				mSource;
+		Compression					mFormat;
+		const char*					mError;
+		std::unique_ptr<Decoder>	mDecoder;
+		std::vector<char>			mInput; ///< Compressed data
+		const char*					mInputNext;
+		const char*					mInputEnd;
+		bool						mSourceEnded;
+		bool						mEnded; ///< No more data will be decompressed
+		std::vector<char>			mOutput;
+		size_t						mOutputOffset; ///< Offset in the uncompressed data of the start of mOutput
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	void DecompressingStream::Buffer::readSource() {
+		mSource.read(mInput.data(), std::streamsize(mInput.size()));
+		mInputNext = mInput.data();
+		mInputEnd = mInputNext + mSource.gcount();
+		mSourceEnded = !mSource;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool DecompressingStream::Buffer::start() {
+		readSource();
+		if(mFormat == Compression::automatic)
+			mFormat = detect(mInputNext, size_t(mInputEnd - mInputNext));
+		mDecoder.reset(makeDecoder(mFormat));
+		if(!mDecoder)
+			mError = cUnsupported;
+		else
+			mError = mDecoder->error();
+		return !mError;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	DecompressingStream::Buffer::int_type DecompressingStream::Buffer::underflow() {
+		if(gptr() < egptr())
+			return traits_type::to_int_type(*gptr());
+		if(mEnded || (!mDecoder && !start())) {
+			mEnded = true;
+			return traits_type::eof();
+		}
+		// Keep the end of what was read, to seek back into
+		char* base = mOutput.data();
+		size_t read = eback() ? size_t(gptr() - eback()) : 0;
+		size_t kept = std::min(read, cHistorySize);
+		if(kept)
+			memmove(base, gptr() - kept, kept);
+		mOutputOffset += read - kept;
+		char* begin = base + kept;
+		char* out = begin;
+		while(out == begin) {
+			if(mInputNext == mInputEnd && !mSourceEnded)
+				readSource();
+			Status status = mDecoder->run(mInputNext, mInputEnd, out, base + mOutput.size(), mSourceEnded);
+			if(status == Status::error)
+				mError = mDecoder->error();
+			if(status != Status::more) {
+				mEnded = true;
+				break;
+			}
+		}
+		setg(base, begin, out);
+		return out == begin ? traits_type::eof() : traits_type::to_int_type(*begin);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	DecompressingStream::Buffer::pos_type DecompressingStream::Buffer::seekoff(off_type _offset,
+		std::ios_base::seekdir _dir, std::ios_base::openmode _which)
+	{
+		if(_dir == std::ios_base::cur)
+			_offset += off_type(mOutputOffset) + off_type(gptr() - eback());
+		else if(_dir != std::ios_base::beg)
+			return pos_type(off_type(-1)); // The size isn't known until the end
+		return seekpos(pos_type(_offset), _which);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Only positions within the window are reachable
+	DecompressingStream::Buffer::pos_type DecompressingStream::Buffer::seekpos(pos_type _pos,
+		std::ios_base::openmode _which)
+	{
+		off_type pos = off_type(_pos);
+		if(!(_which & std::ios_base::in) || pos < off_type(mOutputOffset)
+			|| pos > off_type(mOutputOffset) + off_type(egptr() - eback()))
+			return pos_type(off_type(-1));
+		setg(eback(), eback() + (pos - off_type(mOutputOffset)), egptr());
+		return _pos;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	DecompressingStream::DecompressingStream(std::istream& _compressed, Compression _format)
+		: std::istream(nullptr)
+		, mBuffer(new Buffer(_compressed, _format))
+	{
+		rdbuf(mBuffer.get());
+		if(mBuffer->error())
+			setstate(std::ios_base::badbit);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	DecompressingStream::~DecompressingStream() {
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Compression DecompressingStream::format() const {
+		return mBuffer->format();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* DecompressingStream::error() const {
+		return mBuffer->error();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	/// The put area gathers small writes into a block, that is compressed once it fills up
+	class CompressingStream::Buffer : public std::streambuf {
+	public:
+		Buffer(std::ostream& _sink, Compression _format, int _level)
+			: mSink(_sink)
+			, mEncoder(makeEncoder(_format, _level))
+			, mError(mEncoder ? mEncoder->error() : cUnsupported)
+			, mInput(cBlockSize)
+			, mOutput(cBlockSize)
+			, mCompressed(0)
+			, mClosed(false)
+		{
+			setp(mInput.data(), mInput.data() + mInput.size());
+		}
+
+		bool close();
+		const char* error() const { return mError; }
+
+	protected:
+		int_type overflow(int_type _c) override;
+		std::streamsize xsputn(const char* _s, std::streamsize _n) override;
+		int sync() override;
+		pos_type seekoff(off_type _offset, std::ios_base::seekdir _dir, std::ios_base::openmode _which) override;
+
+	private:
+		bool compress(const char* _data, size_t _size, Flush _flush);
+		bool compressPending(Flush _flush); ///< Compress the put area, and empty it
+
+		std::ostream&				mSink;
+		std::unique_ptr<Encoder>	mEncoder;
+		const char*					mError;
+		std::vector<char>			mInput;
+		std::vector<char>			mOutput;
+		size_t						mCompressed; ///< Uncompressed bytes handed to the encoder so far
+		bool						mClosed;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool CompressingStream::Buffer::compress(const char* _data, size_t _size, Flush _flush) {
+		if(mError)
+			return false;
+		if(mClosed) {
+			mError = "the stream is already closed";
+			return false;
+		}
+		const char* in = _data;
+		const char* end = _data + _size;
+		for(;;) {
+			char* out = mOutput.data();
+			Status status = mEncoder->run(in, end, out, mOutput.data() + mOutput.size(), _flush);
+			if(status == Status::error) {
+				mError = mEncoder->error();
+				return false;
+			}
+			if(out != mOutput.data() && !mSink.write(mOutput.data(), out - mOutput.data())) {
+				mError = "couldn't write the compressed data";
+				return false;
+			}
+			if(status == Status::done) {
+				mCompressed += _size;
+				return true;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool CompressingStream::Buffer::compressPending(Flush _flush) {
+		bool compressed = compress(pbase(), size_t(pptr() - pbase()), _flush);
+		setp(mInput.data(), mInput.data() + mInput.size());
+		return compressed;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	CompressingStream::Buffer::int_type CompressingStream::Buffer::overflow(int_type _c) {
+		if(!compressPending(Flush::none))
+			return traits_type::eof();
+		if(!traits_type::eq_int_type(_c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(_c);
+			pbump(1);
+		}
+		return traits_type::not_eof(_c);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Writes larger than a block go straight to the encoder
+	std::streamsize CompressingStream::Buffer::xsputn(const char* _s, std::streamsize _n) {
+		if(_n <= 0)
+			return 0;
+		size_t size = size_t(_n);
+		if(size > size_t(epptr() - pptr())) {
+			if(!compressPending(Flush::none))
+				return 0;
+			if(size >= mInput.size())
+				return compress(_s, size, Flush::none) ? _n : 0;
+		}
+		memcpy(pptr(), _s, size);
+		pbump(int(size));
+		return _n;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	int CompressingStream::Buffer::sync() {
+		if(mClosed)
+			return mError ? -1 : 0;
+		return compressPending(Flush::sync) && mSink.flush() ? 0 : -1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Only tells the position, in uncompressed bytes
+	CompressingStream::Buffer::pos_type CompressingStream::Buffer::seekoff(off_type _offset,
+		std::ios_base::seekdir _dir, std::ios_base::openmode _which)
+	{
+		if(_offset != 0 || _dir != std::ios_base::cur || !(_which & std::ios_base::out))
+			return pos_type(off_type(-1));
+		return pos_type(off_type(mCompressed + size_t(pptr() - pbase())));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool CompressingStream::Buffer::close() {
+		if(mClosed)
+			return !mError;
+		bool closed = compressPending(Flush::finish);
+		mClosed = true;
+		setp(nullptr, nullptr); // Later writes fail
+		return mSink.flush() && closed;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	CompressingStream::CompressingStream(std::ostream& _compressed, Compression _format, int _level)
+		: std::ostream(nullptr)
+		, mBuffer(new Buffer(_compressed, _format, _level))
+	{
+		rdbuf(mBuffer.get());
+		if(mBuffer->error())
+			setstate(std::ios_base::badbit);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	CompressingStream::~CompressingStream() {
+		close();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool CompressingStream::close() {
+		if(!mBuffer->close()) {
+			setstate(std::ios_base::badbit);
+			return false;
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* CompressingStream::error() const {
+		return mBuffer->error();
+	}
+
+}	// namespace cjson
\ No newline at end of file
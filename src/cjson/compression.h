@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_COMPRESSION_H_
+#define _CJSON_COMPRESSION_H_
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace cjson {
+
+	/// Formats of compressed streams
+	enum class Compression {
+		none, ///< Data is passed through as is
+		gzip, ///< Needs zlib, see compressionSupported()
+		zstd, ///< Needs libzstd, see compressionSupported()
+		automatic, ///< Input only. Detected from the first bytes, which are passed through if they match no format.
+	};
+
+	/// Whether the library was built with the codec for a format. Both are optional dependencies.
+	bool compressionSupported(Compression _format);
+
+	/// \class DecompressingStream
+	/// \brief Input stream with the uncompressed content of a compressed stream.
+	/// Compressed data is read from the source in large blocks and decompressed one block at a time, as the reader
+	/// asks for more, so a Parser on this stream parses while decompressing and the whole plain text is never kept in
+	/// memory. The last 64 kB read can be sought back into, so parsers give back what they read ahead, and several
+	/// documents in a row can be parsed from the same stream.
+	/// Corrupt or truncated input ends the stream early, and error() tells why.
+	class DecompressingStream : public std::istream {
+	public:
+		explicit DecompressingStream(std::istream& _compressed, Compression _format = Compression::automatic);
+		~DecompressingStream();
+
+		/// Format of the source. Automatic until the first read detects it.
+		Compression format() const;
+		/// Why decompression stopped before the end of the source, or null if it didn't
+		const char* error() const;
+
+	private:
+		class Buffer;
+		std::unique_ptr<Buffer> mBuffer;
+	};
+
+	/// \class CompressingStream
+	/// \brief Output stream that compresses what is written to it into another stream.
+	/// Writes are gathered into large blocks that are compressed as they fill up, so a Serializer writing to this
+	/// stream compresses as it goes. The compressed data is only complete once the stream is closed.
+	/// Flushing the stream ends a compressed block, so everything written so far can be decompressed, at some cost in
+	/// compression ratio.
+	class CompressingStream : public std::ostream {
+	public:
+		/// \param _level Compression level of the codec, or 0 for its default
+		explicit CompressingStream(std::ostream& _compressed, Compression _format = Compression::gzip, int _level = 0);
+		~CompressingStream(); ///< Closes the stream
+
+		/// Compress what is left and write the end of the compressed data. Nothing can be written afterwards.
+		/// \return \c false if compressing or writing to the destination failed
+		bool close();
+		/// Why compression failed, or null if it didn't
+		const char* error() const;
+
+	private:
+		class Buffer;
+		std::unique_ptr<Buffer> mBuffer;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_COMPRESSION_H_
\ No newline at end of file
@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "frozen.h"
+#include <thread>
+#include <utility>
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	FrozenJson::FrozenJson() {
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	FrozenJson::FrozenJson(const Json& _document)
+		: mDocument(_document)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Unshareable containers are only found below other unshareable ones, so checking the root is enough. Keeping them
+	// would make every copy of the frozen document a deep copy, and leave it open to changes through old references.
+	FrozenJson::FrozenJson(Json&& _document) {
+		if(_document.mContainer && _document.mContainer->unshareable)
+			mDocument = _document; // Clones
+		else
+			mDocument = std::move(_document);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	SharedJson::SharedJson()
+		: mCurrent(0)
+	{
+		mReaders[0] = 0;
+		mReaders[1] = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	SharedJson::SharedJson(const Json& _initial)
+		: SharedJson()
+	{
+		mSlots[0] = FrozenJson(_initial);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Announce the read on the slot, then make sure it is still the current one. If it is, no writer can touch it
+	// until we are done, since writers wait for the readers of a slot before reusing it.
+	FrozenJson SharedJson::load() const {
+		for(;;) {
+			unsigned slot = mCurrent.load();
+			mReaders[slot].fetch_add(1);
+			if(mCurrent.load() == slot) {
+				FrozenJson snapshot = mSlots[slot];
+				mReaders[slot].fetch_sub(1);
+				return snapshot;
+			}
+			mReaders[slot].fetch_sub(1); // A new version came out in the meantime
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void SharedJson::store(const Json& _document) {
+		store(Json(_document));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void SharedJson::store(Json&& _document) {
+		std::lock_guard<std::mutex> lock(mWriteMutex);
+		unsigned previous = mCurrent.load();
+		unsigned next = 1 - previous;
+		waitForReaders(next);
+		mSlots[next] = FrozenJson(std::move(_document));
+		mCurrent.store(next);
+		// Release the previous version once nobody is copying it anymore. Snapshots taken of it stay valid.
+		waitForReaders(previous);
+		mSlots[previous] = FrozenJson();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void SharedJson::waitForReaders(unsigned _slot) const {
+		while(mReaders[_slot].load() != 0)
+			std::this_thread::yield();
+	}
+
+}	// namespace cjson
\ No newline at end of file
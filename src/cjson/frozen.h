@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_FROZEN_H_
+#define _CJSON_FROZEN_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include "json.h"
+
+namespace cjson {
+
+	/// \class FrozenJson
+	/// \brief Read only view of a document, safe to read from any number of threads at once without locking.
+	/// Freezing a Json is O(1): the frozen document shares the content of the original, and modifying the original
+	/// afterwards clones what it changes instead of touching the shared content. Containers the original has handed
+	/// out non-const references or iterators into are cloned once, when freezing, even if the document is moved in.
+	/// Those references keep changing the original only. Only const access is offered, so the non-const accessors of
+	/// Json, that insert keys or change the type of values, can't be reached by mistake.
+	/// Copies of a FrozenJson are also O(1), and can be handed to other threads.
+	class FrozenJson {
+	public:
+		FrozenJson(); ///< A null document
+		explicit FrozenJson(const Json& _document);
+		explicit FrozenJson(Json&& _document);
+
+		const Json&	operator*() const { return mDocument; }
+		const Json*	operator->() const { return &mDocument; }
+		const Json&	get() const { return mDocument; }
+
+		const Json&	operator[](const char* _key) const { return mDocument[_key]; }
+		const Json&	operator[](const std::string& _key) const { return mDocument[_key]; }
+		const Json&	operator()(size_t _index) const { return mDocument(_index); }
+
+	private:
+		Json mDocument;
+	};
+
+	/// \class SharedJson
+	/// \brief Publishes successive versions of a document to many reader threads.
+	/// Reading takes a FrozenJson snapshot without locking: a couple of atomic operations, and a retry if a new
+	/// version was published in the middle. Readers keep using their snapshot for as long as they want, and publishing
+	/// never disturbs them. Publishing is serialized between writers, and waits for the readers that are still taking
+	/// a snapshot of the version it replaces, so that version can be released right away (an RCU grace period).
+	class SharedJson {
+	public:
+		SharedJson(); ///< Starts with a null document
+		explicit SharedJson(const Json& _initial);
+
+		/// Snapshot of the current version. Lock free.
+		FrozenJson	load() const;
+		/// Make _document the current version. Readers that loaded the previous one keep it.
+		void		store(const Json& _document);
+		void		store(Json&& _document);
+
+	private:
+		SharedJson(const SharedJson&) = delete;
+		SharedJson& operator=(const SharedJson&) = delete;
+
+		void waitForReaders(unsigned _slot) const;
+
+		// Readers of a slot are counted while they copy it. The slot that isn't current is only written to once it
+		// has no readers left.
+		FrozenJson							mSlots[2];
+		mutable std::atomic<size_t>			mReaders[2];
+		std::atomic<unsigned>				mCurrent;
+		std::mutex							mWriteMutex;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_FROZEN_H_
\ No newline at end of file
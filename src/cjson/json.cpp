@@ -24,41 +24,60 @@
 // Simple Json C++ library
 //----------------------------------------------------------------------------------------------------------------------
 #include "json.h"
+#include "nodePool.h"
 #include "parser.h"
 #include "serializer.h"
 #include <cassert>
-#include <new> // Placement new
-#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 
 namespace cjson {
 
 	//------------------------------------------------------------------------------------------------------------------
 	bool Json::parse(const char* _code) {
+		ParseError error;
+		return parse(_code, error);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Json::parse(std::istream& _is) {
+		ParseError error;
+		return parse(_is, error);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Json::parse(const char* _code, ParseError& _error) {
 		setNull();
-		Parser p(_code);
+		Parser p(_code, strlen(_code)); // Parsed in place, the input outlives the parser
 		if(!p.parse(*this)) {
+			_error = p.error();
 			setNull();
 			return false;
 		}
+		_error = ParseError();
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Json::parse(std::istream& _is) {
+	bool Json::parse(std::istream& _is, ParseError& _error) {
 		setNull();
 		Parser p(_is);
 		if(!p.parse(*this)) {
+			_error = p.error();
 			setNull();
 			return false;
 		}
+		_error = ParseError();
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	std::string Json::serialize() const {
-		std::stringstream sstream;
-		if(serialize(sstream))
-			return sstream.str();
+		std::string text;
+		StringSink sink(text);
+		if(serialize(sink) && sink.flush())
+			return text;
 		else // Serialization went wrong.
 			return "";
 	}
@@ -69,6 +88,12 @@ namespace cjson {
 		return s.serialize(*this, _dst);
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	bool Json::serialize(OutputSink& _dst) const {
+		Serializer s;
+		return s.serialize(*this, _dst);
+	}
+
 	//------------------------------------------------------------------------------------------------------------------
 	void Json::setNull() {
 		clear(); // Clear internal elements if necessary (must be done before changing type)
@@ -105,38 +130,38 @@ namespace cjson {
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json::Json(const char* _s)
-		: mText(_s)
-		, mType(DataType::text)
+		: mType(DataType::text)
+		, mText(_s, strlen(_s))
 	{
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json::Json(const std::string& _s)
-		: mText(_s)
-		, mType(DataType::text)
+		: mType(DataType::text)
+		, mText(_s.data(), _s.size())
 	{
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json::Json(std::string&& _s)
-		: mText(std::move(_s))
-		, mType(DataType::text)
+		: mType(DataType::text)
+		, mText(_s.data(), _s.size())
 	{
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator=(bool _b) {
-		clear();
-		this->~Json();
-		new(this)Json(_b);
+		setNull();
+		mType = DataType::boolean;
+		mNumber.b = _b;
 		return *this;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator=(int _i) {
-		clear();
-		this->~Json();
-		new(this)Json(_i);
+		setNull();
+		mType = DataType::integer;
+		mNumber.i = _i;
 		return *this;
 	}
 
@@ -147,36 +172,38 @@ namespace cjson {
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator=(float _f) {
-		clear();
-		this->~Json();
-		new(this)Json(_f);
+		setNull();
+		mType = DataType::real;
+		mNumber.f = _f;
 		return *this;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator=(const char* _s) {
-		clear();
-		this->~Json();
-		new(this)Json(_s);
+		setText(_s, strlen(_s));
 		return *this;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator=(const std::string& _s) {
-		clear();
-		this->~Json();
-		new(this)Json(_s);
+		setText(_s.data(), _s.size());
 		return *this;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator=(std::string&& _s) {
-		clear();
-		this->~Json();
-		new(this)Json(std::move(_s));
+		setText(_s.data(), _s.size());
 		return *this;
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::setText(const char* _s, size_t _size) {
+		Text text(_s, _size); // _s may live in one of our own descendants
+		setNull();
+		mType = DataType::text;
+		mText = std::move(text);
+	}
+
 	//------------------------------------------------------------------------------------------------------------------
 	bool Json::operator==(const Json& _x) const {
 		if(mType != _x.mType)
@@ -188,29 +215,114 @@ namespace cjson {
 		case DataType::text:
 			return mText == _x.mText;
 		case DataType::array:
-			if(size() != _x.size())
+		{
+			if(mContainer == _x.mContainer) // Shared content
+				return true;
+			if(size() != _x.size() || !hashesMatch(_x))
 				return false;
+			if(mContainer->packing != DataType::null && _x.mContainer->packing != DataType::null) {
+				if(mContainer->packing != _x.mContainer->packing)
+					return false;
+				if(mContainer->packing == DataType::boolean) {
+					const Booleans& mine = mContainer->booleans;
+					const Booleans& theirs = _x.mContainer->booleans;
+					for(size_t i = 0; i < mine.size(); ++i) {
+						if(mine[i].b != theirs[i].b)
+							return false;
+					}
+					return true;
+				}
+				const Numbers& mine = mContainer->numbers;
+				const Numbers& theirs = _x.mContainer->numbers;
+				for(size_t i = 0; i < mine.size(); ++i) {
+					if(mine[i].i != theirs[i].i) // By their bits, like single numbers
+						return false;
+				}
+				return true;
+			}
 			for(size_t i = 0; i < size(); ++i) {
-				if(!(*mArray[i] == *_x.mArray[i]))
+				if(!(*array()[i] == *_x.array()[i]))
 					return false;
 			}
 			return true;
+		}
 		case DataType::object:
-			if(size() != _x.size())
+		{
+			if(mContainer == _x.mContainer)
+				return true;
+			if(size() != _x.size() || !hashesMatch(_x))
 				return false;
-			for(const auto& myElement : mObject) {
-				const std::string& key = myElement.first;
-				if(!_x.contains(key))
-					return false;
-				if(!(_x[key] == *myElement.second))
+			// Both dictionaries are sorted, so they can be walked together
+			auto other = _x.object().begin();
+			for(const auto& myElement : object()) {
+				if(myElement.first != other->first || !(*myElement.second == *other->second))
 					return false;
+				++other;
 			}
 			return true;
+		}
+		case DataType::boolean: // Only one byte of the union is set for booleans
+			return mNumber.b == _x.mNumber.b;
 		default:
 			return mNumber.i == _x.mNumber.i;
 		}
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	bool Json::hashesMatch(const Json& _x) const {
+		size_t mine = mContainer->hash.load(std::memory_order_relaxed);
+		size_t theirs = _x.mContainer->hash.load(std::memory_order_relaxed);
+		return !mine || !theirs || mine == theirs;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Json::hash() const {
+		auto combine = [](size_t _seed, size_t _value) {
+			return _seed ^ (_value + size_t(0x9e3779b97f4a7c15ull) + (_seed << 6) + (_seed >> 2));
+		};
+		size_t seed = size_t(mType) + 1;
+		switch(mType) {
+		case DataType::null:
+			return seed;
+		case DataType::boolean:
+			return combine(seed, mNumber.b);
+		case DataType::text:
+			return combine(seed, mText.hash());
+		case DataType::array:
+		case DataType::object:
+		{
+			size_t cached = mContainer->hash.load(std::memory_order_relaxed);
+			if(cached)
+				return cached;
+			if(mType == DataType::array && mContainer->packing != DataType::null) {
+				// Same as hashing a node for each number
+				size_t elementSeed = size_t(mContainer->packing) + 1;
+				for(Number number : mContainer->numbers)
+					seed = combine(seed, combine(elementSeed, size_t(unsigned(number.i))));
+				for(Boolean boolean : mContainer->booleans)
+					seed = combine(seed, combine(elementSeed, size_t(boolean.b)));
+			}
+			else if(mType == DataType::array) {
+				for(const Json* element : array())
+					seed = combine(seed, element->hash());
+			}
+			else {
+				for(const auto& element : object())
+					seed = combine(combine(seed, std::hash<std::string>()(element.first)), element.second->hash());
+			}
+			seed += !seed; // 0 means not computed yet
+			// References handed out of an unshareable container could change it without notice. Others can only
+			// change through mutableArray() or mutableObject(), on themselves and on every container above them, and
+			// those clear the cache. Threads sharing the container would all store the same value.
+			if(!mContainer->unshareable)
+				mContainer->hash.store(seed, std::memory_order_relaxed);
+			return seed;
+		}
+		default: // Numbers are compared by their bits
+			return combine(seed, size_t(unsigned(mNumber.i)));
+		}
+	}
+
 	//------------------------------------------------------------------------------------------------------------------
 	bool Json::operator==(bool _b) const {
 		assert(mType == DataType::boolean || mType == DataType::integer);
@@ -238,13 +350,13 @@ namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	bool Json::operator==(const char* _s) const {
 		assert(mType == DataType::text);
-		return mText == _s;
+		return mText.equals(_s, strlen(_s));
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	bool Json::operator==(const std::string& _s) const {
 		assert(mType == DataType::text);
-		return mText == _s;
+		return mText.equals(_s.data(), _s.size());
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
@@ -268,34 +380,38 @@ namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	Json::operator std::string() const {
 		assert(mType == DataType::text);
-		return mText;
+		return mText.str();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* Json::c_str() const {
+		assert(mType == DataType::text);
+		return mText.c_str();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	const Json& Json::operator()(size_t _n) const {
 		assert(mType == DataType::array);
-		return *mArray[_n];
+		return *array()[_n];
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator()(size_t _n) {
 		assert(mType == DataType::array);
-		return *mArray[_n];
+		return *exposedArray()[_n];
 	}
 	
 	//------------------------------------------------------------------------------------------------------------------
 	const Json& Json::operator[](const char* _key) const {
 		assert(mType == DataType::object);
-		return *mObject.find(_key)->second;
+		return *object().find(_key)->second;
 	}
 	
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator[](const char* _key) {
-		if(mType != DataType::object) {
-			clear();
-			mType = DataType::object;
-		}
-		Json*& objRef = mObject[_key]; // Pointer reference so we can point it to a new object
+		if(mType != DataType::object)
+			makeContainer(DataType::object);
+		Json*& objRef = exposedObject()[_key]; // Pointer reference so we can point it to a new object
 		if(objRef == nullptr)
 			objRef = new Json();
 		return *objRef;
@@ -304,16 +420,14 @@ namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	const Json& Json::operator[](const std::string& _key) const {
 		assert(mType == DataType::object);
-		return *mObject.find(_key)->second;
+		return *object().find(_key)->second;
 	}
 	
 	//------------------------------------------------------------------------------------------------------------------
 	Json& Json::operator[](const std::string& _key) {
-		if(mType != DataType::object) {
-			clear();
-			mType = DataType::object;
-		}
-		Json*& objRef = mObject[_key];
+		if(mType != DataType::object)
+			makeContainer(DataType::object);
+		Json*& objRef = exposedObject()[_key];
 		if(objRef == nullptr)
 			objRef = new Json();
 		return *objRef;
@@ -327,9 +441,9 @@ namespace cjson {
 		case cjson::Json::DataType::text:
 			return mText.size();
 		case cjson::Json::DataType::array:
-			return mArray.size();
+			return arraySize();
 		case cjson::Json::DataType::object:
-			return mObject.size();
+			return object().size();
 		default:
 			assert(false);
 			return size_t(-1);
@@ -339,69 +453,324 @@ namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	bool Json::contains(const std::string& _key) const {
 		assert(mType == DataType::object);
-		return mObject.find(_key) != mObject.end();
+		return object().find(_key) != object().end();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	void Json::clear() {
 		// Clear internal elements if necessary
 		switch(mType) {
-		case DataType::array:
-			for(const auto& element : mArray)
-				delete element;
-			mArray.clear();
+		case DataType::text:
+			mText.clear();
 			break;
+		case DataType::array:
 		case DataType::object:
-			for(const auto& element : mObject)
-				delete element.second;
-			mObject.clear();
+			release(mContainer);
+			mContainer = nullptr;
 			break;
 		default:
 			break;
 		}
 	}
 
-	//----------------------------------------------------------------------------------------------------------------------
-	Json::Dictionary Json::mapDeepCopy(const Json::Dictionary &_map) {
-		Dictionary copy;
-		assert(isObject());
+	//------------------------------------------------------------------------------------------------------------------
+	bool Json::isPacked() const {
+		return mType == DataType::array && mContainer->packing != DataType::null;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Span<const int> Json::packedIntegers() const {
+		if(mType != DataType::array || mContainer->packing != DataType::integer)
+			return Span<const int>();
+		const Numbers& numbers = mContainer->numbers;
+		return Span<const int>(&numbers.data()->i, numbers.size());
+	}
 
-		for (auto element : _map) {
-			copy[element.first] = new Json(*element.second);
+	//------------------------------------------------------------------------------------------------------------------
+	Span<const float> Json::packedReals() const {
+		if(mType != DataType::array || mContainer->packing != DataType::real)
+			return Span<const float>();
+		const Numbers& numbers = mContainer->numbers;
+		return Span<const float>(&numbers.data()->f, numbers.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Span<const bool> Json::packedBooleans() const {
+		if(mType != DataType::array || mContainer->packing != DataType::boolean)
+			return Span<const bool>();
+		const Booleans& booleans = mContainer->booleans;
+		return Span<const bool>(&booleans.data()->b, booleans.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Json::arraySize() const {
+		if(mContainer->packing == DataType::null)
+			return mContainer->array.size();
+		return mContainer->packing == DataType::boolean ? mContainer->booleans.size() : mContainer->numbers.size();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Readers of a shared container may get here at the same time. The first one creates the nodes, and the others
+	// wait for it. Locks are picked by the address of the container, so unrelated arrays rarely wait for each other.
+	void Json::materialize() const {
+		static std::mutex locks[16];
+		std::lock_guard<std::mutex> lock(locks[(reinterpret_cast<uintptr_t>(mContainer) / sizeof(Container)) % 16]);
+		Container& container = *mContainer;
+		if(container.unpacked.load(std::memory_order_relaxed))
+			return;
+		size_t size = arraySize();
+		NodeBlock* block = NodeBlock::create(size);
+		container.array.reserve(size);
+		for(Number number : container.numbers) {
+			Json* node = block->allocate();
+			node->mType = container.packing;
+			node->mNumber = number;
+			container.array.push_back(node);
+		}
+		for(Boolean boolean : container.booleans) {
+			Json* node = block->allocate();
+			*node = boolean.b;
+			container.array.push_back(node);
+		}
+		container.unpacked.store(true, std::memory_order_release);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::unpack() {
+		if(!mContainer->unpacked.load(std::memory_order_acquire))
+			materialize();
+		mContainer->packing = DataType::null;
+		mContainer->unpacked.store(false, std::memory_order_relaxed);
+		Numbers().swap(mContainer->numbers);
+		Booleans().swap(mContainer->booleans);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::share(const Json& _src) {
+		assert(mType == DataType::null);
+		mType = _src.mType;
+		switch(mType) {
+		case DataType::boolean:
+		case DataType::integer:
+		case DataType::real:
+			mNumber = _src.mNumber;
+			break;
+		case DataType::text:
+			mText = _src.mText;
+			break;
+		case DataType::array:
+		case DataType::object:
+			if(_src.mContainer->unshareable) // It may still change through references into it
+				mContainer = clone(*_src.mContainer, mType);
+			else {
+				mContainer = _src.mContainer;
+				mContainer->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+			break;
+		default: // Do nothing for null
+			break;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::makeContainer(DataType _type) {
+		assert(_type == DataType::array || _type == DataType::object);
+		clear();
+		mType = _type;
+		mContainer = new Container;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Only the direct children are cloned, and they share their own content with the originals. So modifying a deep
+	// element clones one container per level on the way to it.
+	void Json::detach() {
+		assert(mType == DataType::array || mType == DataType::object);
+		// If we hold the only reference, nobody else can take a new one while we are modifying this Json
+		if(mContainer->refs.load(std::memory_order_acquire) == 1)
+			return;
+		Container* shared = mContainer;
+		mContainer = clone(*shared, mType);
+		release(shared); // Other owners may have let go of it in the meantime
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// The children of each clone go in a single block. Unshareable containers are only found below other unshareable
+	// ones, since handing out a reference marks every container on the way to it. They are cloned through a work
+	// list rather than recursively, so deep trees can't overflow the stack.
+	Json::Container* Json::clone(const Container& _src, DataType _type) {
+		struct Pending {
+			Json*				node; ///< Clone waiting for its container
+			const Container*	src;
+		};
+		Container* root = nullptr;
+		std::vector<Pending> pending(1, Pending{ nullptr, &_src });
+		while(!pending.empty()) {
+			Pending next = pending.back();
+			pending.pop_back();
+			const Container& src = *next.src;
+			DataType type = next.node ? next.node->mType : _type;
+			Container* copy = new Container;
+			if(next.node)
+				next.node->mContainer = copy;
+			else
+				root = copy;
+			if(src.packing != DataType::null) { // Just the numbers, nodes are created again if needed
+				copy->packing = src.packing;
+				copy->numbers = src.numbers;
+				copy->booleans = src.booleans;
+				continue;
+			}
+			size_t children = type == DataType::array ? src.array.size() : src.object.size();
+			NodeBlock* block = children ? NodeBlock::create(children) : nullptr;
+			auto cloneChild = [&pending, block](const Json& _child) {
+				Json* node = block->allocate();
+				if(_child.mContainer && _child.mContainer->unshareable) {
+					node->mType = _child.mType;
+					pending.push_back(Pending{ node, _child.mContainer });
+				}
+				else
+					node->share(_child);
+				return node;
+			};
+			if(type == DataType::array) {
+				copy->array.reserve(children);
+				for(const Json* child : src.array)
+					copy->array.push_back(cloneChild(*child));
+			}
+			else {
+				for(const auto& element : src.object) // Already sorted
+					copy->object.emplace_hint(copy->object.end(), element.first, cloneChild(*element.second));
+			}
+		}
+		return root;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::release(Container* _container) {
+		if(_container->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+		// Last reference. Containers of the children that become unreferenced go to a work list instead of being
+		// released recursively.
+		std::vector<Container*> pending(1, _container);
+		while(!pending.empty()) {
+			Container* container = pending.back();
+			pending.pop_back();
+			auto releaseChild = [&pending](Json* _child) {
+				if(_child->mContainer) {
+					if(_child->mContainer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+						pending.push_back(_child->mContainer);
+					_child->mContainer = nullptr;
+					_child->mType = DataType::null;
+				}
+				freeNode(_child);
+			};
+			for(Json* child : container->array)
+				releaseChild(child);
+			for(const auto& element : container->object)
+				releaseChild(element.second);
+			delete container;
 		}
-		return copy;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::freeNode(Json* _node) {
+		NodeBlock* block = _node->mBlock;
+		if(block) {
+			_node->~Json();
+			block->release();
+		}
+		else
+			delete _node;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void* Json::operator new(size_t _size) {
+		return allocateMemory(_size);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::operator delete(void* _p, size_t _size) {
+		freeMemory(_p, _size);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	//------------------------------------------------------------------------------------------------------------------
+	// Values that aren't containers iterate over an empty dictionary
+	Json::Dictionary& Json::noElements() {
+		static Dictionary empty;
+		return empty;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json::Array& Json::noArrayElements() {
+		static Array empty;
+		return empty;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json::const_iterator Json::begin() const{
 		if (isArray())
-			return const_iterator(mArray.begin());
+			return const_iterator(array().begin());
+		else if (isObject())
+			return const_iterator(object().begin());
 		else
-			return const_iterator(mObject.begin());
+			return const_iterator(noElements().cbegin());
 	}
 	
 	//------------------------------------------------------------------------------------------------------------------
 	Json::iterator Json::begin(){
 		if (isArray())
-			return iterator(mArray.begin());
+			return iterator(exposedArray().begin());
+		else if (isObject())
+			return iterator(exposedObject().begin());
 		else
-			return iterator(mObject.begin());
+			return iterator(noElements().begin());
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json::const_iterator Json::end() const{
 		if (isArray())
-			return const_iterator(mArray.end());
+			return const_iterator(array().end());
+		else if (isObject())
+			return const_iterator(object().end());
 		else
-			return const_iterator(mObject.end());
+			return const_iterator(noElements().cend());
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	Json::iterator Json::end(){
 		if (isArray())
-			return iterator(mArray.end());
+			return iterator(exposedArray().end());
+		else if (isObject())
+			return iterator(exposedObject().end());
 		else
-			return iterator(mObject.end());
+			return iterator(noElements().end());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json::const_array_view Json::asArray() const {
+		const Array& elements = isArray() ? array() : noArrayElements();
+		return const_array_view(ArrayIterator<const Json>(elements.begin()), ArrayIterator<const Json>(elements.end()),
+			elements.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json::array_view Json::asArray() {
+		Array& elements = isArray() ? exposedArray() : noArrayElements();
+		return array_view(ArrayIterator<Json>(elements.begin()), ArrayIterator<Json>(elements.end()), elements.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json::const_object_view Json::items() const {
+		const Dictionary& members = isObject() ? object() : noElements();
+		return const_object_view(ObjectIterator<const Json>(members.begin()), ObjectIterator<const Json>(members.end()),
+			members.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json::object_view Json::items() {
+		Dictionary& members = isObject() ? exposedObject() : noElements();
+		return object_view(ObjectIterator<Json>(members.begin()), ObjectIterator<Json>(members.end()), members.size());
 	}
 	
 	//------------------------------------------------------------------------------------------------------------------
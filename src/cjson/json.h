@@ -26,23 +26,47 @@
 #ifndef _CJSON_JSON_H_
 #define _CJSON_JSON_H_
 
+#include <atomic>
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
 
+#include "allocator.h"
 #include "JsonIterator.h"
+#include "memoryStats.h"
+#include "parseError.h"
+#include "span.h"
+#include "text.h"
 
 namespace cjson {
 
+	template<class Options_> class BasicParser;
+	class OutputSink;
+
 	/// \class Json
 	/// \brief Encapsulates all the functionality to operate with json objects.
+	/// The content of arrays and objects is shared between copies and only cloned when one of them is modified, so
+	/// copying a Json is O(1) regardless of its size. Modifying an element through the non-const accessors clones just
+	/// the containers on the path to it, and the untouched siblings keep being shared.
+	/// Different threads can safely copy and modify their own Json values even if they share content.
+	/// References and iterators returned by the non-const accessors can be kept and used to modify the tree at any
+	/// time. Since they could reach content shared with a later copy, the containers they were taken from are never
+	/// shared again: copying them clones them, with the cost of a deep copy for the parts of the tree that were
+	/// accessed that way. Documents that were parsed, or only modified through push_back, patches and assignment to the
+	/// whole value, keep sharing.
+	/// Threading model: const methods can be called on the same Json from any number of threads at once. Non-const
+	/// methods need the Json to themselves, and that includes operator[] and operator(), which may insert elements or
+	/// change the type of the value. Different Json values can be used from different threads, even if they share
+	/// content. FrozenJson and SharedJson, in frozen.h, make read only access explicit.
+	/// Json values can be used as keys of std::unordered_map and std::unordered_set.
 	class Json {
 	public:
 		// ----- Basic construction and destruction -----
 		Json(); ///< Default constructor. Creates an empty json.
-		Json(const Json&); ///< Copy constructor. Performs a deep copy.
+		Json(const Json&); ///< Copy constructor. Shares the content of arrays and objects instead of copying it.
 		Json(Json&&); ///< Move constructor.
-		Json& operator=(const Json&); ///< Deep copy assignment.
+		Json& operator=(const Json&); ///< Copy assignment. Shares content like the copy constructor.
 		Json& operator=(Json&&); ///< Move asignment.
 		~Json(); ///< Destructor
 
@@ -50,9 +74,13 @@ namespace cjson {
 		/// param _code a string containing a formated json.
 		bool parse	(const char* _code);
 		bool parse	(std::istream&);
+		/// Parse, and describe what went wrong on failure. The Json is left null on failure.
+		bool parse	(const char* _code, ParseError& _error);
+		bool parse	(std::istream&, ParseError& _error);
 		/// generate a string with the formated content of the json object
 		std::string serialize() const;
 		bool		serialize(std::ostream&) const; ///< Serialize Json content into an output stream.
+		bool		serialize(OutputSink&) const; ///< Serialize into a sink, e.g. a FileSink. See outputSink.h.
 
 		// ----- Useful methods -----
 		void setNull	(); ///< Reset object to default construction state
@@ -101,6 +129,10 @@ namespace cjson {
 		bool operator==(float) const;
 		bool operator==(const char*) const;
 		bool operator==(const std::string&) const;
+		/// Structural hash, consistent with operator==. Arrays and objects cache theirs until they are modified, so
+		/// hashing a document again, or content shared with one already hashed, is O(1). Containers that have handed
+		/// out non-const references or iterators don't, since those could change them at any time.
+		size_t hash() const;
 
 		// ----- Conversion to base types -----
 		/// Cast to boolean
@@ -114,6 +146,8 @@ namespace cjson {
 				 operator int			() const;
 				 operator float			() const;
 				 operator std::string	() const;
+		/// Characters of a string, without copying them. Valid until the Json is modified.
+		const char*		c_str	() const;
 
 		// ----- Vector like access -----
 		const Json&		operator()	(size_t) const;
@@ -131,14 +165,55 @@ namespace cjson {
 		// ----- Common methods for array and object -----
 		size_t			size	() const;
 
+		// ----- Packed arrays -----
+		/// The parser stores arrays of numbers or booleans that all have the same type packed: the values are kept
+		/// contiguously, without a node for each of them, and booleans take a byte each. Nodes for the elements are
+		/// only created if something needs them, like operator() or iterating over the array, and modifying the array
+		/// turns it into a regular one. Size, comparison, hashing and serialization work on the packed values.
+		bool			isPacked		() const;
+		/// Numbers of an array packed as integers. Empty for anything else.
+		Span<const int>		packedIntegers	() const;
+		/// Numbers of an array packed as reals. Empty for anything else.
+		Span<const float>	packedReals		() const;
+		/// Values of an array packed as booleans. Empty for anything else.
+		Span<const bool>	packedBooleans	() const;
+
+		// ----- Patching -----
+		/// Apply an RFC 6902 JSON Patch, given as an array of operations.
+		/// Operations work in place: values are moved instead of copied, and only containers on the touched paths are
+		/// cloned, if their content is shared. When an operation fails, including a failed "test", the ones already
+		/// applied are undone, so the Json is left as it was.
+		/// \return \c false if the patch is malformed or any of its operations fails.
+		bool			applyPatch	(const Json& _patch);
+		/// Apply an RFC 7386 merge patch: members of _patch replace ours, and its null members remove them.
+		void			mergePatch	(const Json& _patch);
+		/// JSON Patch that turns this into _target.
+		/// Content shared by both sides is skipped without being visited, so diffing snapshots that were copied from
+		/// one another takes time proportional to what changed. Array elements are matched by position once the common
+		/// prefix and suffix are trimmed, which won't always give the shortest patch.
+		Json			diff		(const Json& _target) const;
+		/// Same, but hands each operation to _change as it is found instead of collecting them
+		void			diff		(const Json& _target,
+			const std::function<void(const Json& _operation)>& _change) const;
+
+		// ----- Memory -----
+		/// Nodes created with new are taken from the allocator set with setAllocator(), like the rest of the memory
+		/// held by Json values.
+		static void*	operator new	(size_t _size);
+		static void		operator delete	(void* _p, size_t _size);
+		static void*	operator new	(size_t, void* _p) { return _p; } ///< Placement new
+		static void		operator delete	(void*, void*) {}
+		/// Count the values in the document and the memory they hold. Walks the whole document.
+		MemoryStats		memoryStats() const;
+
 	private:
 		void clear();
+		void setText(const char* _s, size_t _size);
 
 	private:
-		typedef std::map<std::string,Json*>	Dictionary;
-		typedef std::vector<Json*>			Array;
-
-		Dictionary mapDeepCopy(const Dictionary &_map);
+		typedef std::map<std::string, Json*, std::less<std::string>, HookAllocator<std::pair<const std::string, Json*>>>
+											Dictionary;
+		typedef std::vector<Json*, HookAllocator<Json*>>	Array;
 
 		/// Possible types of data
 		enum class DataType {
@@ -149,20 +224,86 @@ namespace cjson {
 			text,
 			array,
 			object,
-		} mType;
+		};
 
 		/// Internal representation of data
 		union Number {
 			int i;
 			float f;
 			bool b;
-		}	mNumber;
-		std::string	mText;
-		Array		mArray;
-		Dictionary	mObject;
+		};
+		/// Element of an array packed as booleans. Wrapped so that std::vector doesn't store it as a bit.
+		struct Boolean {
+			bool b;
+		};
+		typedef std::vector<Number, HookAllocator<Number>>		Numbers;
+		typedef std::vector<Boolean, HookAllocator<Boolean>>	Booleans;
+
+		/// Content of an array or object, shared by all the copies of it
+		struct Container {
+			Container() : refs(1), hash(0), packing(DataType::null), unpacked(false), unshareable(false) {}
+			static void* operator new(size_t _size) { return allocateMemory(_size); }
+			static void operator delete(void* _p, size_t _size) { freeMemory(_p, _size); }
+
+			std::atomic<size_t>	refs; ///< Number of Json values sharing this container
+			std::atomic<size_t>	hash; ///< Cached hash of the content, 0 until computed
+			Array				array; ///< For packed arrays, only filled in once unpacked is set
+			Dictionary			object;
+			DataType			packing; ///< Type of the elements of a packed array. null for other containers.
+			std::atomic<bool>	unpacked; ///< Whether the nodes of a packed array have been created
+			Numbers				numbers; ///< Elements of an array packed as integers or reals
+			Booleans			booleans; ///< Elements of an array packed as booleans
+			/// References or iterators to the elements have been handed out, and may still be used to modify them.
+			/// Copies clone the container instead of sharing it.
+			bool				unshareable;
+		};
 
-		friend class Parser;
+		/// Storage for the children cloned from a shared container, or for nodes parsed by a ParseContext. It is
+		/// released once all of its nodes have been destroyed.
+		struct NodeBlock;
+
+		/// Take the value of _src, sharing its container if it has one. Must be null.
+		void		share(const Json& _src);
+		void		makeContainer(DataType _type); ///< Reset to an empty array or object
+		void		detach(); ///< Make sure our container isn't shared before modifying it
+		/// New container with the content of _src, which has the given type. Children share their own content, unless
+		/// it is unshareable too.
+		static Container*	clone(const Container& _src, DataType _type);
+		const Array&		array			() const; ///< Creates the nodes of a packed array if needed
+		const Dictionary&	object			() const;
+		Array&				mutableArray	(); ///< Detaches first
+		Dictionary&			mutableObject	(); ///< Detaches first
+		/// For references handed to the caller. Makes the container unshareable.
+		Array&				exposedArray	();
+		Dictionary&			exposedObject	();
+		// Destruction walks the tree with an explicit work list instead of recursion, so it works on trees of any depth
+		static void	release(Container* _container);
+		static void	freeNode(Json* _node);
+		static Dictionary& noElements();
+		static Array& noArrayElements();
+		/// \c false if both containers have cached hashes and they differ
+		bool		hashesMatch(const Json& _x) const;
+		size_t		arraySize() const;
+		/// Create the nodes of a packed array, keeping the values. Safe to call from several threads at once.
+		void		materialize() const;
+		/// Turn a packed array into a regular one. Needs the container to ourselves.
+		void		unpack();
+
+		DataType	mType;
+		Number		mNumber;
+		Text		mText;
+		Container*	mContainer = nullptr; ///< Only for arrays and objects
+		NodeBlock*	mBlock = nullptr; ///< Block this node was allocated from, if any. Never copied nor moved.
+
+		template<class> friend class BasicParser;
 		friend class Serializer;
+		friend class Schema;
+		friend class JsonBuilder;
+		friend class Validator;
+		friend class Patcher;
+		friend class Query;
+		friend class FrozenJson;
+		friend class NodePool;
 
 		// ----- Iterators -----
 		friend struct IteratorTrait<Json>;
@@ -177,11 +318,31 @@ namespace cjson {
 		iterator		begin();
 		const_iterator	end() const;
 		iterator		end();
+
+		typedef View<ArrayIterator<Json>>			array_view;
+		typedef View<ArrayIterator<const Json>>		const_array_view;
+		typedef View<ObjectIterator<Json>>			object_view;
+		typedef View<ObjectIterator<const Json>>	const_object_view;
+
+		/// Elements of an array, with random access iterators that can be used with std::sort and the like. Empty for
+		/// any other type. Like the other non-const accessors, the non-const version clones the array if it is shared.
+		const_array_view	asArray() const;
+		array_view			asArray();
+		/// Members of an object in key order, each one with its key and value. Empty for any other type.
+		const_object_view	items() const;
+		object_view			items();
 	};
 
 
 }	// namespace cjson
 
+namespace std {
+	template<>
+	struct hash<cjson::Json> {
+		size_t operator()(const cjson::Json& _x) const { return _x.hash(); }
+	};
+}
+
 #include "json.inl"
 
 #endif // _CJSON_JSON_H_
\ No newline at end of file
@@ -40,34 +40,6 @@ namespace cjson {
 		//std::cout << "Json::Json " << this << "\n";
 	}
 
-	//------------------------------------------------------------------------------------------------------------------
-	inline Json::Json(const Json& _x)
-		: mType (_x.mType)
-	{
-		//std::cout << "Json::Json(const &) " << this << "\n";
-		switch(mType) {
-		case DataType::boolean:
-		case DataType::integer:
-		case DataType::real:
-			mNumber = _x.mNumber;
-			break;
-		case DataType::text:
-			mText = _x.mText;
-			break;
-		case DataType::array:
-			mArray.reserve(_x.mArray.size());
-			for(auto element : _x.mArray)
-				mArray.push_back(new Json(*element));
-			break;
-		case DataType::object:
-			for(auto element : _x.mObject)
-				mObject.insert(std::make_pair(element.first, new Json(*element.second)));
-			break;
-		default: // Do nothing for null
-			break;
-		}
-	}
-
 	//------------------------------------------------------------------------------------------------------------------
 	inline Json::Json(Json&& _x)
 		: mType(_x.mType)
@@ -83,11 +55,9 @@ namespace cjson {
 			mText = std::move(_x.mText);
 			break;
 		case DataType::array:
-			mArray = std::move(_x.mArray);
-			_x.mType = DataType::null;
-			break;
 		case DataType::object:
-			mObject = std::move(_x.mObject);
+			mContainer = _x.mContainer;
+			_x.mContainer = nullptr;
 			_x.mType = DataType::null;
 			break;
 		default: // Do nothing for null
@@ -95,54 +65,43 @@ namespace cjson {
 		}
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	inline Json::Json(const Json& _x)
+		: mType(DataType::null)
+	{
+		share(_x);
+	}
+
 	//------------------------------------------------------------------------------------------------------------------
 	template<typename T_>
 	Json::Json(std::initializer_list<T_> _list)
-		:mType(DataType::array)
+		:mType(DataType::null)
 	{
 		//std::cout << "Json::Json(list) " << this << "\n";
-		mArray.reserve(_list.size());
+		makeContainer(DataType::array);
+		mContainer->array.reserve(_list.size());
 		for(const auto& element : _list)
-			mArray.push_back(new Json(element));
+			mContainer->array.push_back(new Json(element));
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	template<class T_>
 	Json::Json(const std::vector<T_>& _list)
-		:mType(DataType::array)
+		:mType(DataType::null)
 	{
 		//std::cout << "Json::Json (vector)" << this << "\n";
-		mArray.reserve(_list.size());
+		makeContainer(DataType::array);
+		mContainer->array.reserve(_list.size());
 		for(const auto& element : _list)
-			mArray.push_back(new Json(element));
+			mContainer->array.push_back(new Json(element));
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	inline Json& Json::operator=(const Json& _x)
 	{
-		clear();
-		mType = _x.mType;
-		switch(mType) {
-		case DataType::boolean:
-		case DataType::integer:
-		case DataType::real:
-			mNumber = _x.mNumber;
-			break;
-		case DataType::array:
-			mArray = _x.mArray;
-			// Deep copy
-			for (size_t i = 0; i < mArray.size(); ++i) {
-				mArray[i] = new Json(*mArray[i]);
-			}
-			break;
-		case DataType::object:
-			mObject = mapDeepCopy(_x.mObject);
-			break;
-		case DataType::text:
-			mText = _x.mText;
-			break;
-		default: // Do nothing for null
-			break;
+		if(this != &_x) {
+			Json copy(_x); // _x may be one of our own descendants, share its content before clearing
+			*this = std::move(copy);
 		}
 		return *this;
 	}
@@ -150,24 +109,25 @@ namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	inline Json& Json::operator=(Json&& _x)
 	{
+		if(this == &_x)
+			return *this;
+		Json content(std::move(_x)); // _x may be one of our own descendants, take its content before clearing
 		clear();
-		mType = _x.mType;
+		mType = content.mType;
 		switch(mType) {
 		case DataType::boolean:
 		case DataType::integer:
 		case DataType::real:
-			mNumber = _x.mNumber;
+			mNumber = content.mNumber;
 			break;
 		case DataType::array:
-			mArray = std::move(_x.mArray);
-			_x.mType = DataType::null;
-			break;
 		case DataType::object:
-			mObject = std::move(_x.mObject);
-			_x.mType = DataType::null;
+			mContainer = content.mContainer;
+			content.mContainer = nullptr;
+			content.mType = DataType::null;
 			break;
 		case DataType::text:
-			mText = _x.mText;
+			mText = std::move(content.mText);
 			break;
 		default: // Do nothing for null
 			break;
@@ -177,30 +137,14 @@ namespace cjson {
 
 	//------------------------------------------------------------------------------------------------------------------
 	inline Json::~Json() {
-		switch (mType)
-		{
-		case DataType::array:
-			for(const auto& element : mArray)
-				delete element;
-			break;
-		case DataType::object:
-			for(const auto& element : mObject)
-				delete element.second;
-			break;
-		default:
-			break;
-		}
+		clear();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
 	template<class T_>
 	Json& Json::operator=(std::initializer_list<T_> _list) {
-		clear();
-		mType = DataType::array;
-		mArray.reserve(_list.size());
-		for(auto element : _list)
-			mArray.push_back(new Json(element));
-		return *this;
+		Json array(_list); // Elements may refer to our own descendants
+		return *this = std::move(array);
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
@@ -236,10 +180,54 @@ namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	template<typename T_>
 	void Json::push_back(const T_& _element) {
+		Json* element = new Json(_element); // _element may be one of our own descendants
 		if(mType == DataType::null)
-			mType = DataType::array;
+			makeContainer(DataType::array);
 		assert(mType == DataType::array);
-		mArray.push_back(new Json(_element));
+		mutableArray().push_back(element);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	inline const Json::Array& Json::array() const {
+		if(mContainer->packing != DataType::null && !mContainer->unpacked.load(std::memory_order_acquire))
+			materialize();
+		return mContainer->array;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	inline const Json::Dictionary& Json::object() const {
+		return mContainer->object;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	inline Json::Array& Json::mutableArray() {
+		detach();
+		mContainer->hash.store(0, std::memory_order_relaxed); // We are about to be modified
+		if(mContainer->packing != DataType::null)
+			unpack();
+		return mContainer->array;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	inline Json::Dictionary& Json::mutableObject() {
+		detach();
+		mContainer->hash.store(0, std::memory_order_relaxed);
+		return mContainer->object;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// The caller may keep the references, and modify the elements after we have been copied
+	inline Json::Array& Json::exposedArray() {
+		Array& elements = mutableArray();
+		mContainer->unshareable = true;
+		return elements;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	inline Json::Dictionary& Json::exposedObject() {
+		Dictionary& members = mutableObject();
+		mContainer->unshareable = true;
+		return members;
 	}
 
 } // namespace cjson
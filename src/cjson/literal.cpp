@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "literal.h"
+#include <cassert>
+#include <memory>
+#include <utility>
+#include "parser.h"
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	StaticJson::~StaticJson() {
+		delete mDocument.load();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Threads reading for the first time at once may all parse the literal, but only one document is kept
+	const FrozenJson& StaticJson::build() const {
+		Json document;
+		StrictParser parser(mLiteral.text, mLiteral.size);
+		bool parsed = parser.parse(document);
+		assert(parsed && "Literals are validated when they are compiled");
+		(void)parsed;
+		std::unique_ptr<const FrozenJson> built(new FrozenJson(std::move(document)));
+		const FrozenJson* expected = nullptr;
+		if(mDocument.compare_exchange_strong(expected, built.get(), std::memory_order_acq_rel))
+			return *built.release();
+		return *expected;
+	}
+
+}	// namespace cjson
\ No newline at end of file
@@ -0,0 +1,273 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_LITERAL_H_
+#define _CJSON_LITERAL_H_
+
+#include <atomic>
+#include <cstddef>
+#include "frozen.h"
+
+namespace cjson {
+
+	/// Validation of json literals at compile time. Everything here is constexpr, and written in C++11's single
+	/// expression style: the validator is a state machine that consumes a character per step. Steps are chained as a
+	/// binary tree, so nesting of constexpr calls only grows with the logarithm of the size of the literal.
+	namespace literal {
+
+		/// What the validator expects next
+		enum Mode {
+			value,
+			firstElement, ///< A value or the end of an array that was just opened
+			firstKey, ///< A key or the end of an object that was just opened
+			key,
+			colon,
+			string,
+			escape,
+			hex, ///< Digits of a \u escape
+			afterValue, ///< A separator or the end of a container
+			minus,
+			zero,
+			integer,
+			point, ///< Right after the decimal point
+			fraction,
+			exponentStart,
+			exponentSign,
+			exponent,
+			word, ///< true, false or null
+		};
+
+		/// Containers open at once are tracked in the bits of a 64 bit integer
+		const unsigned cMaxDepth = 64;
+
+		struct State {
+			constexpr State(const char* _text, size_t _size, size_t _pos, unsigned long long _stack, unsigned _depth,
+				Mode _mode, unsigned _aux, bool _failed)
+				: text(_text), size(_size), pos(_pos), stack(_stack), depth(_depth), mode(_mode), aux(_aux)
+				, failed(_failed)
+			{}
+
+			const char*			text;
+			size_t				size;
+			size_t				pos;
+			unsigned long long	stack; ///< One bit per open container, set for objects
+			unsigned			depth;
+			Mode				mode;
+			/// Strings: 1 for keys, plus twice the digits left of a \u escape. Words: the word times 8, plus the
+			/// characters matched.
+			unsigned			aux;
+			bool				failed;
+		};
+
+		constexpr bool isSpace(int _c) { return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r'; }
+		constexpr bool isDigit(int _c) { return _c >= '0' && _c <= '9'; }
+		constexpr bool isHex(int _c) { return isDigit(_c) || (_c >= 'a' && _c <= 'f') || (_c >= 'A' && _c <= 'F'); }
+		constexpr bool isEscape(int _c) {
+			return _c == '"' || _c == '\\' || _c == '/' || _c == 'b' || _c == 'f' || _c == 'n' || _c == 'r' ||
+				_c == 't';
+		}
+		constexpr const char* wordText(unsigned _word) { return _word == 0 ? "true" : _word == 1 ? "false" : "null"; }
+
+		/// Next character, or -1 at the end of the literal
+		constexpr int current(const State& _s) { return _s.pos < _s.size ? int((unsigned char)_s.text[_s.pos]) : -1; }
+		constexpr bool inObject(const State& _s) { return _s.depth && ((_s.stack >> (_s.depth - 1)) & 1); }
+
+		//--------------------------------------------------------------------------------------------------------------
+		// Transitions
+		constexpr State to(const State& _s, Mode _mode, size_t _consumed = 1, unsigned _aux = 0) {
+			return State(_s.text, _s.size, _s.pos + _consumed, _s.stack, _s.depth, _mode, _aux, false);
+		}
+
+		constexpr State failure(const State& _s) {
+			return State(_s.text, _s.size, _s.pos, _s.stack, _s.depth, _s.mode, _s.aux, true);
+		}
+
+		constexpr State open(const State& _s, bool _object) {
+			return _s.depth == cMaxDepth ? failure(_s) : State(_s.text, _s.size, _s.pos + 1,
+				_s.stack | ((unsigned long long)(_object) << _s.depth), _s.depth + 1,
+				_object ? firstKey : firstElement, 0, false);
+		}
+
+		constexpr State close(const State& _s) {
+			return State(_s.text, _s.size, _s.pos + 1, _s.stack & ~(1ull << (_s.depth - 1)), _s.depth - 1,
+				afterValue, 0, false);
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		constexpr State startValue(const State& _s, int _c) {
+			return _c == '{' ? open(_s, true)
+				: _c == '[' ? open(_s, false)
+				: _c == '"' ? to(_s, string)
+				: _c == '-' ? to(_s, minus)
+				: _c == '0' ? to(_s, zero)
+				: isDigit(_c) ? to(_s, integer)
+				: _c == 't' ? to(_s, word, 1, 0 * 8 + 1)
+				: _c == 'f' ? to(_s, word, 1, 1 * 8 + 1)
+				: _c == 'n' ? to(_s, word, 1, 2 * 8 + 1)
+				: failure(_s);
+		}
+
+		/// Numbers end on the first character that can't continue them, which is left for the next step
+		constexpr State endNumber(const State& _s) { return to(_s, afterValue, 0); }
+
+		constexpr State afterInteger(const State& _s, int _c) {
+			return _c == '.' ? to(_s, point)
+				: (_c == 'e' || _c == 'E') ? to(_s, exponentStart)
+				: endNumber(_s);
+		}
+
+		constexpr State afterSeparator(const State& _s, int _c) {
+			return !_s.depth ? failure(_s) // Nothing but white space after the document
+				: _c == ',' ? to(_s, inObject(_s) ? key : value)
+				: _c == (inObject(_s) ? '}' : ']') ? close(_s)
+				: failure(_s);
+		}
+
+		constexpr State matchWord(const State& _s, int _c) {
+			return !wordText(_s.aux / 8)[_s.aux % 8] ? to(_s, afterValue, 0)
+				: _c == wordText(_s.aux / 8)[_s.aux % 8] ? to(_s, word, 1, _s.aux + 1)
+				: failure(_s);
+		}
+
+		constexpr State step(const State& _s, int _c) {
+			return _s.mode == value ? (isSpace(_c) ? to(_s, value) : startValue(_s, _c))
+				: _s.mode == firstElement ? (isSpace(_c) ? to(_s, firstElement) : _c == ']' ? close(_s)
+					: startValue(_s, _c))
+				: _s.mode == firstKey ? (isSpace(_c) ? to(_s, firstKey) : _c == '}' ? close(_s)
+					: _c == '"' ? to(_s, string, 1, 1) : failure(_s))
+				: _s.mode == key ? (isSpace(_c) ? to(_s, key) : _c == '"' ? to(_s, string, 1, 1) : failure(_s))
+				: _s.mode == colon ? (isSpace(_c) ? to(_s, colon) : _c == ':' ? to(_s, value) : failure(_s))
+				: _s.mode == afterValue ? (isSpace(_c) ? to(_s, afterValue) : afterSeparator(_s, _c))
+				: _s.mode == string ? (_c == '"' ? to(_s, _s.aux ? colon : afterValue)
+					: _c == '\\' ? to(_s, escape, 1, _s.aux)
+					: _c < 0x20 ? failure(_s) // Control characters must be escaped. Also the end of the literal.
+					: to(_s, string, 1, _s.aux))
+				: _s.mode == escape ? (_c == 'u' ? to(_s, hex, 1, (_s.aux & 1) | (4 << 1))
+					: isEscape(_c) ? to(_s, string, 1, _s.aux) : failure(_s))
+				: _s.mode == hex ? (!isHex(_c) ? failure(_s)
+					: (_s.aux >> 1) == 1 ? to(_s, string, 1, _s.aux & 1) : to(_s, hex, 1, _s.aux - 2))
+				: _s.mode == minus ? (_c == '0' ? to(_s, zero) : isDigit(_c) ? to(_s, integer) : failure(_s))
+				: _s.mode == zero ? afterInteger(_s, _c)
+				: _s.mode == integer ? (isDigit(_c) ? to(_s, integer) : afterInteger(_s, _c))
+				: _s.mode == point ? (isDigit(_c) ? to(_s, fraction) : failure(_s))
+				: _s.mode == fraction ? (isDigit(_c) ? to(_s, fraction)
+					: (_c == 'e' || _c == 'E') ? to(_s, exponentStart) : endNumber(_s))
+				: _s.mode == exponentStart ? ((_c == '+' || _c == '-') ? to(_s, exponentSign)
+					: isDigit(_c) ? to(_s, exponent) : failure(_s))
+				: _s.mode == exponentSign ? (isDigit(_c) ? to(_s, exponent) : failure(_s))
+				: _s.mode == exponent ? (isDigit(_c) ? to(_s, exponent) : endNumber(_s))
+				: matchWord(_s, _c);
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		constexpr bool finished(const State& _s) { return _s.failed || (_s.pos == _s.size && _s.mode == afterValue); }
+		constexpr State advance(const State& _s) { return finished(_s) ? _s : step(_s, current(_s)); }
+		/// Take 2^_log steps
+		constexpr State run(const State& _s, unsigned _log) {
+			return _log == 0 ? advance(_s) : run(run(_s, _log - 1), _log - 1);
+		}
+		constexpr unsigned stepsLog(size_t _steps, unsigned _log = 0) {
+			return (size_t(1) << _log) >= _steps ? _log : stepsLog(_steps, _log + 1);
+		}
+		/// Each character takes a step, and so does the end of each number and word
+		constexpr State validate(const char* _text, size_t _size) {
+			return run(State(_text, _size, 0, 0, 0, value, 0, false), stepsLog(2 * _size + 2));
+		}
+		constexpr bool accepted(const State& _s) {
+			return !_s.failed && _s.mode == afterValue && !_s.depth && _s.pos == _s.size;
+		}
+		constexpr size_t errorOffset(const State& _s) { return accepted(_s) ? size_t(-1) : _s.pos; }
+
+	}	// namespace literal
+
+	/// Whether the text is a single json document, following RFC 8259 strictly. Usable in constant expressions.
+	/// Control characters have to be escaped in strings, and arrays and objects can't nest deeper than 64 levels.
+	constexpr bool isValidJson(const char* _text, size_t _size) {
+		return literal::accepted(literal::validate(_text, _size));
+	}
+
+	/// Offset of the first character that makes the text invalid json, or size_t(-1) if it is valid.
+	/// An unexpected end of the text is reported at its size. Usable in constant expressions.
+	constexpr size_t jsonErrorOffset(const char* _text, size_t _size) {
+		return literal::errorOffset(literal::validate(_text, _size));
+	}
+
+	/// Only instantiated for valid literals, see CJSON_LITERAL
+	template<bool valid_>
+	struct ValidLiteral {
+		static_assert(valid_, "CJSON_LITERAL: the text is not valid json. jsonErrorOffset() tells where.");
+	};
+
+	/// \class JsonLiteral
+	/// \brief Text of a json document that was validated when it was compiled. Create them with CJSON_LITERAL.
+	struct JsonLiteral {
+		constexpr JsonLiteral(ValidLiteral<true>, const char* _text, size_t _size) : text(_text), size(_size) {}
+
+		const char*	text;
+		size_t		size;
+	};
+
+	/// \class StaticJson
+	/// \brief Constant document embedded in the program, e.g. a default configuration or a response skeleton.
+	/// Declared with static storage, a StaticJson is initialized at compile time, so it costs nothing at startup. The
+	/// document is parsed the first time it is read, once, and later reads just load a pointer. Any number of threads
+	/// can read it at once, including the first time. Copies of the document are O(1), see FrozenJson.
+	///     static const StaticJson cDefaults(CJSON_LITERAL(R"({"port": 8080, "hosts": ["localhost"]})"));
+	///     int port = cDefaults["port"];
+	class StaticJson {
+	public:
+		constexpr StaticJson(JsonLiteral _literal) : mLiteral(_literal), mDocument(nullptr) {}
+		~StaticJson();
+
+		const FrozenJson& get() const {
+			const FrozenJson* document = mDocument.load(std::memory_order_acquire);
+			return document ? *document : build();
+		}
+		const Json&	operator*() const { return *get(); }
+		const Json*	operator->() const { return &*get(); }
+		const Json&	operator[](const char* _key) const { return get()[_key]; }
+		const Json&	operator[](const std::string& _key) const { return get()[_key]; }
+		const Json&	operator()(size_t _index) const { return get()(_index); }
+
+		const JsonLiteral& literal() const { return mLiteral; }
+
+	private:
+		StaticJson(const StaticJson&) = delete;
+		StaticJson& operator=(const StaticJson&) = delete;
+
+		const FrozenJson& build() const; ///< Parse the literal, unless another thread is faster
+
+		JsonLiteral								mLiteral;
+		mutable std::atomic<const FrozenJson*>	mDocument;
+	};
+
+}	// namespace cjson
+
+/// Json literal validated at compile time. Invalid json doesn't compile.
+#define CJSON_LITERAL(_text) \
+	::cjson::JsonLiteral(::cjson::ValidLiteral<::cjson::isValidJson(_text, sizeof(_text) - 1)>(), \
+		_text, sizeof(_text) - 1)
+
+#endif // _CJSON_LITERAL_H_
\ No newline at end of file
@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "memoryStats.h"
+#include "json.h"
+#include <unordered_set>
+#include <vector>
+
+namespace cjson {
+
+	namespace {
+		// Estimated size of a node of the map holding the members of an object: a red-black tree node has a color and
+		// three links before the member itself
+		const size_t cMemberNodeBytes = 4 * sizeof(void*) + sizeof(std::pair<const std::string, Json*>);
+
+		//--------------------------------------------------------------------------------------------------------------
+		size_t keyBytes(const std::string& _key) {
+			const char* characters = _key.data();
+			const char* self = reinterpret_cast<const char*>(&_key);
+			bool inside = characters >= self && characters < self + sizeof(_key); // Stored inline by the library
+			return inside ? 0 : _key.capacity() + 1;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	MemoryStats::MemoryStats()
+		: nulls(0)
+		, booleans(0)
+		, integers(0)
+		, reals(0)
+		, strings(0)
+		, arrays(0)
+		, objects(0)
+		, packedNumbers(0)
+		, packedBooleans(0)
+		, sharedContainers(0)
+		, nodeBytes(0)
+		, stringBytes(0)
+		, containerBytes(0)
+		, keyBytes(0)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t MemoryStats::nodes() const {
+		return nulls + booleans + integers + reals + strings + arrays + objects;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t MemoryStats::totalBytes() const {
+		return nodeBytes + stringBytes + containerBytes + keyBytes;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Walks the tree with a work list, so it works on trees of any depth. Packed arrays are not materialized.
+	MemoryStats Json::memoryStats() const {
+		MemoryStats stats;
+		std::unordered_set<const Container*> visited;
+		std::vector<const Json*> pending(1, this);
+		while(!pending.empty()) {
+			const Json* value = pending.back();
+			pending.pop_back();
+			if(value != this)
+				stats.nodeBytes += sizeof(Json);
+			switch(value->mType) {
+			case DataType::null:
+				++stats.nulls;
+				break;
+			case DataType::boolean:
+				++stats.booleans;
+				break;
+			case DataType::integer:
+				++stats.integers;
+				break;
+			case DataType::real:
+				++stats.reals;
+				break;
+			case DataType::text:
+				++stats.strings;
+				stats.stringBytes += value->mText.allocatedBytes();
+				break;
+			case DataType::array:
+			case DataType::object: {
+				++(value->mType == DataType::array ? stats.arrays : stats.objects);
+				const Container* container = value->mContainer;
+				if(!visited.insert(container).second) {
+					++stats.sharedContainers;
+					break;
+				}
+				stats.containerBytes += sizeof(Container) + container->array.capacity() * sizeof(Json*)
+					+ container->numbers.capacity() * sizeof(Number) + container->booleans.capacity() * sizeof(Boolean)
+					+ container->object.size() * cMemberNodeBytes;
+				if(container->packing != DataType::null && !container->unpacked.load(std::memory_order_acquire)) {
+					stats.packedNumbers += container->numbers.size();
+					stats.packedBooleans += container->booleans.size();
+				}
+				else
+					pending.insert(pending.end(), container->array.begin(), container->array.end());
+				for(const auto& member : container->object) {
+					stats.keyBytes += keyBytes(member.first);
+					pending.push_back(member.second);
+				}
+				break;
+			}
+			}
+		}
+		return stats;
+	}
+
+}	// namespace cjson
\ No newline at end of file
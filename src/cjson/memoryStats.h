@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_MEMORYSTATS_H_
+#define _CJSON_MEMORYSTATS_H_
+
+#include <cstddef>
+
+namespace cjson {
+
+	/// \struct MemoryStats
+	/// \brief What a document is made of, and the memory it holds, as returned by Json::memoryStats().
+	/// Content shared between parts of the document is only counted once. Bytes are those requested from the
+	/// allocator, plus an estimate of the nodes of the std::map holding each object's members. Nodes allocated in
+	/// blocks count as their own size, without the unused part of the block.
+	/// The allocations made while parsing, copying or serializing a document are counted by allocationCounters(), in
+	/// allocator.h.
+	struct MemoryStats {
+		MemoryStats();
+
+		// Values by type, including the root
+		size_t	nulls;
+		size_t	booleans;
+		size_t	integers;
+		size_t	reals;
+		size_t	strings;
+		size_t	arrays;
+		size_t	objects;
+		size_t	packedNumbers; ///< Elements of packed arrays of numbers without a node of their own
+		size_t	packedBooleans; ///< Elements of packed arrays of booleans without a node of their own
+		size_t	sharedContainers; ///< Arrays and objects reached more than once
+
+		size_t	nodeBytes; ///< Nodes of all the values but the root, which belongs to the caller
+		size_t	stringBytes; ///< Strings too long to be stored inline
+		size_t	containerBytes; ///< Arrays and objects, with the storage for their elements and members
+		size_t	keyBytes; ///< Keys too long to be stored inside their std::string
+
+		size_t	nodes() const; ///< Values with a node, including the root
+		size_t	totalBytes() const;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_MEMORYSTATS_H_
\ No newline at end of file
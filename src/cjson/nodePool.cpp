@@ -0,0 +1,171 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "nodePool.h"
+#include <cassert>
+#include <new> // Placement new
+#include "allocator.h"
+
+namespace cjson {
+
+	const size_t NodePool::cBlockSize;
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json::NodeBlock* Json::NodeBlock::create(size_t _capacity, NodePool* _pool) {
+		static_assert(sizeof(NodeBlock) % alignof(Json) == 0, "Nodes following the block header must be aligned");
+		void* memory = allocateMemory(sizeof(NodeBlock) + _capacity * sizeof(Json));
+		NodeBlock* block = new(memory) NodeBlock;
+		block->live = _capacity;
+		block->used = 0;
+		block->capacity = _capacity;
+		block->pool = _pool;
+		return block;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json* Json::NodeBlock::allocate() {
+		assert(used < capacity);
+		Json* node = new(reinterpret_cast<Json*>(this + 1) + used++) Json();
+		node->mBlock = this;
+		return node;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::NodeBlock::release(size_t _count) {
+		if(live.fetch_sub(_count, std::memory_order_acq_rel) == _count) {
+			if(pool)
+				pool->recycle(this);
+			else
+				destroy();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Json::NodeBlock::destroy() {
+		size_t bytes = sizeof(NodeBlock) + capacity * sizeof(Json);
+		this->~NodeBlock();
+		freeMemory(this, bytes);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	NodePool::NodePool()
+		: mRefs(1)
+		, mOwned(true)
+		, mCurrent(nullptr)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	NodePool* NodePool::create() {
+		return new NodePool;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void NodePool::release() {
+		// Nodes not handed out yet count as live, let go of them
+		if(mCurrent) {
+			Json::NodeBlock* current = mCurrent;
+			mCurrent = nullptr;
+			if(current->used < current->capacity)
+				current->release(current->capacity - current->used);
+		}
+		std::vector<Json::NodeBlock*> blocks;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mOwned = false;
+			blocks.swap(mFree);
+		}
+		for(Json::NodeBlock* block : blocks)
+			destroy(block);
+		unref();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json* NodePool::allocate() {
+		if(!mCurrent) {
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				if(!mFree.empty()) {
+					mCurrent = mFree.back();
+					mFree.pop_back();
+				}
+			}
+			if(!mCurrent) {
+				mRefs.fetch_add(1, std::memory_order_relaxed);
+				mCurrent = Json::NodeBlock::create(cBlockSize, this);
+			}
+		}
+		Json* node = mCurrent->allocate();
+		// A full block is left to the nodes in it, it comes back once they are all destroyed
+		if(mCurrent->used == mCurrent->capacity)
+			mCurrent = nullptr;
+		return node;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void NodePool::trim() {
+		std::vector<Json::NodeBlock*> blocks;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			blocks.swap(mFree);
+		}
+		for(Json::NodeBlock* block : blocks)
+			destroy(block);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t NodePool::reservedBlocks() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mFree.size();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// May be called from any thread
+	void NodePool::recycle(Json::NodeBlock* _block) {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if(mOwned) {
+				_block->live.store(_block->capacity, std::memory_order_relaxed);
+				_block->used = 0;
+				mFree.push_back(_block);
+				return;
+			}
+		}
+		destroy(_block);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void NodePool::destroy(Json::NodeBlock* _block) {
+		_block->destroy();
+		unref();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void NodePool::unref() {
+		if(mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+
+}	// namespace cjson
\ No newline at end of file
@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_NODEPOOL_H_
+#define _CJSON_NODEPOOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "json.h"
+
+namespace cjson {
+
+	class NodePool;
+
+	/// Nodes are allocated in blocks. A block is released, or handed back to its pool, once all of its nodes have been
+	/// destroyed.
+	struct Json::NodeBlock {
+		std::atomic<size_t>	live; ///< Nodes not destroyed yet, counting the ones not handed out
+		size_t				used; ///< Nodes handed out so far
+		size_t				capacity;
+		NodePool*			pool; ///< Pool the block goes back to. Null for blocks that are simply deleted.
+
+		static NodeBlock* create(size_t _capacity, NodePool* _pool = nullptr);
+		Json* allocate();
+		/// Account for _count destroyed nodes
+		void release(size_t _count = 1);
+		void destroy();
+	};
+
+	/// \class NodePool
+	/// \brief Keeps the blocks of nodes used by a ParseContext, so they can be reused once the documents that used
+	/// them are gone.
+	/// Nodes can be destroyed from any thread, even after the owner of the pool has let go of it. The pool itself is
+	/// destroyed once the owner and all the outstanding blocks are gone.
+	class NodePool {
+	public:
+		static NodePool* create();
+		/// Called by the owner when it's done with the pool. Blocks still in use are deleted when they come back.
+		void release();
+
+		Json*	allocate(); ///< Only called from the owner's thread
+		/// Free the blocks that aren't in use
+		void	trim();
+		size_t	reservedBlocks() const; ///< Blocks kept for reuse
+
+		static const size_t cBlockSize = 256; ///< Nodes per block
+
+	private:
+		NodePool();
+		friend struct Json::NodeBlock;
+		void recycle(Json::NodeBlock* _block); ///< Called when all the nodes in a block have been destroyed
+		void destroy(Json::NodeBlock* _block);
+		void unref();
+
+		std::atomic<size_t>				mRefs; ///< The owner, plus every block that hasn't been deleted
+		mutable std::mutex				mMutex;
+		std::vector<Json::NodeBlock*>	mFree; ///< Blocks ready for reuse
+		bool							mOwned;
+		Json::NodeBlock*				mCurrent; ///< Block nodes are being allocated from
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_NODEPOOL_H_
\ No newline at end of file
@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "outputSink.h"
+
+#include <cerrno>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	OutputSink::OutputSink()
+		: mBegin(nullptr)
+		, mCursor(nullptr)
+		, mEnd(nullptr)
+		, mDrained(0)
+		, mPrecision(6)
+		, mFailed(false)
+	{}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void OutputSink::setBlock(char* _block, size_t _size) {
+		mBegin = mCursor = _block;
+		mEnd = _block + _size;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool OutputSink::flush() {
+		if(mCursor != mBegin)
+			drain(nullptr, 0);
+		return !mFailed;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Data of up to half a block is copied in, topping the block up before it goes out. Anything bigger is not worth
+	// copying, and goes out right after the block.
+	void OutputSink::drain(const char* _extra, size_t _extraSize) {
+		size_t half = size_t(mEnd - mBegin) / 2;
+		if(_extraSize > half) {
+			size_t used = size_t(mCursor - mBegin);
+			if(!mFailed && !consume(mBegin, used, _extra, _extraSize))
+				mFailed = true;
+			mDrained += used + _extraSize;
+			mCursor = mBegin;
+			return;
+		}
+		size_t fits = size_t(mEnd - mCursor) < _extraSize ? size_t(mEnd - mCursor) : _extraSize;
+		if(fits) {
+			memcpy(mCursor, _extra, fits);
+			mCursor += fits;
+		}
+		size_t used = size_t(mCursor - mBegin);
+		if(!mFailed && !consume(mBegin, used, nullptr, 0))
+			mFailed = true;
+		mDrained += used;
+		mCursor = mBegin;
+		if(_extraSize > fits) {
+			memcpy(mBegin, _extra + fits, _extraSize - fits);
+			mCursor += _extraSize - fits;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	FileSink::FileSink(int _fd, size_t _blockSize)
+		: mFd(_fd)
+		, mError(0)
+		, mBlock(_blockSize ? _blockSize : 1)
+	{
+		setBlock(mBlock.data(), mBlock.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	FileSink::~FileSink() {
+		flush();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool FileSink::consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) {
+#ifdef _WIN32
+		const char* parts[2] = { _block, _extra };
+		size_t sizes[2] = { _blockSize, _extraSize };
+		for(size_t i = 0; i < 2; ++i) {
+			while(sizes[i]) {
+				unsigned chunk = sizes[i] < (1u << 30) ? unsigned(sizes[i]) : (1u << 30);
+				int written = _write(mFd, parts[i], chunk);
+				if(written <= 0) {
+					mError = written < 0 ? errno : EIO;
+					return false;
+				}
+				parts[i] += written;
+				sizes[i] -= size_t(written);
+			}
+		}
+#else
+		iovec parts[2];
+		parts[0].iov_base = const_cast<char*>(_block);
+		parts[0].iov_len = _blockSize;
+		parts[1].iov_base = const_cast<char*>(_extra);
+		parts[1].iov_len = _extraSize;
+		iovec* part = parts;
+		int count = 2;
+		for(;;) {
+			// Skip what has already been written, including empty parts
+			while(count && !part->iov_len) {
+				++part;
+				--count;
+			}
+			if(!count)
+				break;
+			ssize_t written = ::writev(mFd, part, count);
+			if(written < 0 && errno == EINTR)
+				continue;
+			if(written <= 0) {
+				mError = written < 0 ? errno : EIO;
+				return false;
+			}
+			for(size_t left = size_t(written); left; ++part, --count) {
+				if(left < part->iov_len) { // Partial write
+					part->iov_base = static_cast<char*>(part->iov_base) + left;
+					part->iov_len -= left;
+					break;
+				}
+				left -= part->iov_len;
+				part->iov_len = 0;
+			}
+		}
+#endif
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	StreamSink::StreamSink(std::ostream& _dst)
+		: mDst(_dst)
+	{
+		setBlock(mBlock, sizeof(mBlock));
+		setPrecision(int(_dst.precision()));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	StreamSink::~StreamSink() {
+		flush();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool StreamSink::consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) {
+		mDst.write(_block, _blockSize);
+		if(_extraSize)
+			mDst.write(_extra, _extraSize);
+		return !mDst.fail();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	StringSink::StringSink(std::string& _dst)
+		: mDst(_dst)
+	{
+		setBlock(mBlock, sizeof(mBlock));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	StringSink::~StringSink() {
+		flush();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool StringSink::consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) {
+		mDst.append(_block, _blockSize);
+		if(_extraSize)
+			mDst.append(_extra, _extraSize);
+		return true;
+	}
+
+}	// namespace cjson
\ No newline at end of file
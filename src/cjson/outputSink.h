@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_OUTPUTSINK_H_
+#define _CJSON_OUTPUTSINK_H_
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cjson {
+
+	/// \class OutputSink
+	/// \brief Destination of serialized text, written through a block buffer.
+	/// The serializer writes lots of tiny pieces: brackets, commas, line breaks and tabs. Here they are copied into a
+	/// large block with no virtual call per piece, and the block is handed to the destination only when it fills up, is
+	/// flushed, or a write too big for what is left of it arrives. In the latter case the block and the write are
+	/// handed over together, so destinations that can gather them send both in a single call.
+	/// Once the destination fails, the rest of the output is discarded and good() returns \c false.
+	class OutputSink {
+	public:
+		virtual ~OutputSink() {}
+
+		void put(char _c) {
+			if(mCursor == mEnd)
+				drain(nullptr, 0);
+			*mCursor++ = _c;
+		}
+		void write(const char* _data, size_t _size) {
+			if(_size <= size_t(mEnd - mCursor)) {
+				std::memcpy(mCursor, _data, _size);
+				mCursor += _size;
+			}
+			else
+				drain(_data, _size);
+		}
+		void write(const char* _text) { write(_text, std::strlen(_text)); }
+
+		/// Hand everything written so far to the destination.
+		/// \return \c false if the destination failed, now or earlier
+		bool flush();
+		bool good() const { return !mFailed; }
+		/// Bytes written to the sink since it was created, including those still in the block
+		size_t position() const { return mDrained + size_t(mCursor - mBegin); }
+
+		/// Significant digits of real numbers, 6 by default like in std::ostream
+		int precision() const { return mPrecision; }
+		void setPrecision(int _precision) { mPrecision = _precision; }
+
+	protected:
+		OutputSink();
+		/// Derived classes provide the block, and must flush() in their destructor
+		void setBlock(char* _block, size_t _size);
+		/// Take the data in the block followed by _extra. Either can be empty.
+		/// \return \c false if the destination failed
+		virtual bool consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) = 0;
+
+	private:
+		OutputSink(const OutputSink&) = delete;
+		OutputSink& operator=(const OutputSink&) = delete;
+
+		void drain(const char* _extra, size_t _extraSize); ///< Empty the block, along with data that doesn't fit in it
+
+		char*	mBegin;
+		char*	mCursor;
+		char*	mEnd;
+		size_t	mDrained; ///< Bytes handed over to consume() so far
+		int		mPrecision;
+		bool	mFailed;
+	};
+
+	/// \class FileSink
+	/// \brief Writes straight to a file descriptor, such as an open file, pipe or socket, bypassing iostreams.
+	/// Full blocks go out in one write() call, and a block followed by a large string in a single writev(). The file
+	/// descriptor must be blocking, and it is not closed by the sink.
+	class FileSink : public OutputSink {
+	public:
+		static const size_t cDefaultBlockSize = 64 * 1024;
+
+		explicit FileSink(int _fd, size_t _blockSize = cDefaultBlockSize);
+		~FileSink(); ///< Flushes the sink
+
+		/// errno of the write that failed, or 0 if none did
+		int error() const { return mError; }
+
+	private:
+		bool consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) override;
+
+		int					mFd;
+		int					mError;
+		std::vector<char>	mBlock;
+	};
+
+	/// \class StreamSink
+	/// \brief Writes to a std::ostream in blocks. The precision of real numbers is taken from the stream.
+	class StreamSink : public OutputSink {
+	public:
+		explicit StreamSink(std::ostream& _dst);
+		~StreamSink(); ///< Flushes the sink
+
+	private:
+		bool consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) override;
+
+		std::ostream&	mDst;
+		char			mBlock[1024]; ///< The stream has a buffer of its own
+	};
+
+	/// \class StringSink
+	/// \brief Appends to a std::string
+	class StringSink : public OutputSink {
+	public:
+		explicit StringSink(std::string& _dst);
+		~StringSink(); ///< Flushes the sink
+
+	private:
+		bool consume(const char* _block, size_t _blockSize, const char* _extra, size_t _extraSize) override;
+
+		std::string&	mDst;
+		char			mBlock[4096];
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_OUTPUTSINK_H_
\ No newline at end of file
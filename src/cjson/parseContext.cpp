@@ -0,0 +1,136 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "parseContext.h"
+#include <cstring>
+#include "json.h"
+#include "nodePool.h"
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	BasicParseContext<Options_>::BasicParseContext()
+		: mPool(NodePool::create())
+	{
+		mParser.mPool = mPool;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	BasicParseContext<Options_>::~BasicParseContext() {
+		reset(); // Give back unread input to the last stream
+		mPool->release();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParseContext<Options_>::parse(const char* _code, Json& _dst) {
+		return parse(_code, strlen(_code), _dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParseContext<Options_>::parse(const char* _data, size_t _size, Json& _dst) {
+		mParser.setInput(_data, _size);
+		bool ok = parseInput(_dst);
+		mParser.setInput(nullptr, 0); // Don't keep pointers to the caller's data
+		return ok;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParseContext<Options_>::parse(std::istream& _in, Json& _dst) {
+		mParser.setInput(_in);
+		bool ok = parseInput(_dst);
+		mParser.setInput(nullptr, 0); // Give back what was read ahead
+		return ok;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParseContext<Options_>::parseInput(Json& _dst) {
+		if(mParser.parse(_dst))
+			return true;
+		_dst.setNull();
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	const ParseError& BasicParseContext<Options_>::error() const {
+		return mParser.error();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParseContext<Options_>::setUtf8Validation(bool _enable) {
+		mParser.setUtf8Validation(_enable);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParseContext<Options_>::setMaxDepth(size_t _maxDepth) {
+		mParser.setMaxDepth(_maxDepth);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Clearing vectors of pointers and PODs doesn't depend on their size, nor does it free their storage
+	template<class Options_>
+	void BasicParseContext<Options_>::reset() {
+		mParser.setInput(nullptr, 0);
+		mParser.mError = ParseError();
+		mParser.mStack.clear();
+		mParser.mSchemaStack.clear();
+		mParser.mOpenEvents.clear();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParseContext<Options_>::releaseMemory() {
+		reset();
+		mPool->trim();
+		std::vector<char>().swap(mParser.mBuffer);
+		std::vector<Json*>().swap(mParser.mStack);
+		std::vector<typename BasicParser<Options_>::SchemaFrame>().swap(mParser.mSchemaStack);
+		std::vector<char>().swap(mParser.mOpenEvents);
+		std::string().swap(mParser.mText);
+		std::string().swap(mParser.mKey);
+		std::string().swap(mParser.mNumberText);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	size_t BasicParseContext<Options_>::reservedNodes() const {
+		return mPool->reservedBlocks() * NodePool::cBlockSize;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// The contexts built with the library, one per parsing policy
+	template class BasicParseContext<StrictParsing>;
+	template class BasicParseContext<DefaultParsing>;
+	template class BasicParseContext<LenientParsing>;
+
+}	// namespace cjson
\ No newline at end of file
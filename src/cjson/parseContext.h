@@ -0,0 +1,90 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_PARSECONTEXT_H_
+#define _CJSON_PARSECONTEXT_H_
+
+#include <cstddef>
+#include <ios>
+#include "parseError.h"
+#include "parser.h"
+
+namespace cjson {
+
+	class Json;
+	class NodePool;
+
+	/// \class BasicParseContext
+	/// \brief Parses many documents in a row, keeping everything it allocates warm between them.
+	/// Input buffers and parsing stacks keep their capacity from one document to the next, and the nodes of the parsed
+	/// documents come from blocks that are reused once those documents are destroyed. Memory is only returned to the
+	/// system when releaseMemory() is called, or when the context is destroyed.
+	/// A context must only be used from one thread at a time, but the documents it parses are independent values that
+	/// can be handed to other threads and outlive the context.
+	/// Options_ is the policy of the parser the context uses, see StrictParsing.
+	template<class Options_>
+	class BasicParseContext {
+	public:
+		BasicParseContext();
+		~BasicParseContext();
+
+		/// Parse a document. _dst is left null on failure, and error() tells what went wrong.
+		bool parse(const char* _code, Json& _dst);
+		/// Parse a document in place, without copying it. The data is not needed once parse returns.
+		bool parse(const char* _data, size_t _size, Json& _dst);
+		bool parse(std::istream& _in, Json& _dst);
+
+		const ParseError& error() const;
+		void setUtf8Validation(bool _enable);
+		void setMaxDepth(size_t _maxDepth);
+
+		/// Forget the last input and error. O(1), everything allocated is kept for the next document.
+		void reset();
+		/// Free the memory kept for reuse. Nodes still used by parsed documents are freed along with them.
+		void releaseMemory();
+		/// Nodes allocated and ready for reuse
+		size_t reservedNodes() const;
+
+	private:
+		BasicParseContext(const BasicParseContext&) = delete;
+		BasicParseContext& operator=(const BasicParseContext&) = delete;
+
+		bool parseInput(Json& _dst);
+
+		BasicParser<Options_>	mParser;
+		NodePool*				mPool;
+	};
+
+	/// Parses with the default policy, see DefaultParsing
+	typedef BasicParseContext<DefaultParsing> ParseContext;
+
+	// Built with the library
+	extern template class BasicParseContext<StrictParsing>;
+	extern template class BasicParseContext<DefaultParsing>;
+	extern template class BasicParseContext<LenientParsing>;
+
+}	// namespace cjson
+
+#endif // _CJSON_PARSECONTEXT_H_
\ No newline at end of file
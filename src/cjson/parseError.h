@@ -0,0 +1,76 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_PARSEERROR_H_
+#define _CJSON_PARSEERROR_H_
+
+#include <cstddef>
+#include <string>
+
+namespace cjson {
+
+	/// Kinds of error the parser can report
+	enum class ParseErrorCode {
+		none,
+		unexpectedEnd, ///< The input ended in the middle of an element
+		unexpectedCharacter, ///< Found a character that can't start or continue an element
+		invalidLiteral, ///< Misspelled null, true or false
+		invalidNumber,
+		invalidEscape, ///< Unknown escape sequence in a string, or malformed \\u escape
+		invalidString, ///< Raw control character in a string, which strict parsing rejects
+		invalidUtf8, ///< Only reported when UTF-8 validation is enabled
+		missingColon, ///< Object key not followed by ':'
+		missingComma, ///< Elements of an array or object not separated by ','
+		depthLimitExceeded, ///< Arrays and objects nested deeper than the parser allows
+		typeMismatch, ///< The input doesn't match the type of the C++ value being read
+		rejected, ///< A SaxHandler stopped the parse
+	};
+
+	/// \class ParseError
+	/// \brief Describes where and why parsing failed.
+	/// Only the code and offset are tracked while parsing. Line, column and context are worked out from the input once
+	/// an error has been found, so they cost nothing when parsing succeeds.
+	struct ParseError {
+		ParseError();
+
+		ParseErrorCode	code;
+		size_t			offset; ///< Byte offset in the input where the error was found
+		size_t			line; ///< 1 based line number. 0 if it couldn't be recovered from the input.
+		size_t			column; ///< 1 based column, in bytes. 0 if it couldn't be recovered from the input.
+		std::string		context; ///< Excerpt of the input around the error
+		size_t			contextOffset; ///< Position of the error within context
+
+		/// \return \c true if there is an error
+		explicit operator bool() const { return code != ParseErrorCode::none; }
+
+		/// Short description of the error code
+		const char* description() const;
+		/// Human readable summary including the position, e.g. "line 3, column 7: unexpected character"
+		std::string message() const;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_PARSEERROR_H_
\ No newline at end of file
@@ -0,0 +1,72 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_PARSEOPTIONS_H_
+#define _CJSON_PARSEOPTIONS_H_
+
+namespace cjson {
+
+	/// \class StrictParsing
+	/// \brief Nothing but RFC 8259, for input that isn't trusted to be standard json.
+	/// Parse options are template policies of BasicParser: each flag says whether an extension to RFC 8259 is accepted.
+	/// They are compile time constants, so a parser carries no checks for the extensions its policy leaves out.
+	/// The library is built with parsers for StrictParsing, DefaultParsing and LenientParsing.
+	struct StrictParsing {
+		static const bool comments = false; ///< Line (//) and block (/* */) comments, wherever white space is allowed
+		static const bool trailingCommas = false; ///< A comma after the last element of an array or object
+		static const bool optionalCommas = false; ///< Elements separated by white space alone
+		static const bool unquotedKeys = false; ///< Object keys without quotes, which run up to the colon
+		static const bool nonFinite = false; ///< NaN, Infinity and -Infinity, read as reals
+		/// A leading '+', leading zeros, a decimal point without digits on one of its sides and an 'f' suffix on reals
+		static const bool looseNumbers = false;
+		/// Raw control characters (below 0x20), like tabs and new lines, inside strings
+		static const bool controlCharacters = false;
+		/// Anything after the top-level value, such as the next document of a stream. Without it, only white space may
+		/// follow the value.
+		static const bool trailingContent = false;
+	};
+
+	/// \class DefaultParsing
+	/// \brief What the parser has always accepted: trailing and optional commas, unquoted keys, loose numbers, control
+	/// characters and trailing content.
+	struct DefaultParsing : StrictParsing {
+		static const bool trailingCommas = true;
+		static const bool optionalCommas = true;
+		static const bool unquotedKeys = true;
+		static const bool looseNumbers = true;
+		static const bool controlCharacters = true;
+		static const bool trailingContent = true;
+	};
+
+	/// \class LenientParsing
+	/// \brief Every extension, for hand written files.
+	struct LenientParsing : DefaultParsing {
+		static const bool comments = true;
+		static const bool nonFinite = true;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_PARSEOPTIONS_H_
\ No newline at end of file
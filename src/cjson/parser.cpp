@@ -24,10 +24,19 @@
 // Simple Json C++ library
 //----------------------------------------------------------------------------------------------------------------------
 #include "parser.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <sstream>
 #include <string>
+#include "columns.h"
 #include "json.h"
+#include "nodePool.h"
+#include "simd.h"
+#include "utf8.h"
 
 #if defined(_WIN32) && defined(_DEBUG) // Trace memory leaks
 #define _CRTDBG_MAP_ALLOC
@@ -42,214 +51,1431 @@
 
 namespace cjson {
 
+	namespace {
+		/// Size of the blocks read from the input stream
+		const size_t cReadBlockSize = 16 * 1024;
+		/// Stands for a value parsed ahead of the generic dispatch. It is neither a character nor EOF.
+		const int cParsed = -2;
+
+		inline bool isSpace(int _c) { return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r'; }
+		inline bool isDigit(int _c) { return _c >= '0' && _c <= '9'; }
+		inline bool startsNumber(int _c) { return isDigit(_c) || _c == '-' || _c == '+'; }
+
+		// Out of range integers are clamped
+		inline int toInt(const std::string& _num) {
+			long long i = strtoll(_num.c_str(), nullptr, 10);
+			return int(std::max<long long>(INT_MIN, std::min<long long>(INT_MAX, i)));
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		// Find the end of a run of plain string characters, i.e. the first quote or backslash in [_p, _end), or the
+		// first control character if stopAtControl_ is set.
+		// Also reports whether the run contains any non ASCII byte, so pure ASCII runs can skip UTF-8 validation.
+		template<bool stopAtControl_>
+		const char* scanStringRun(const char* _p, const char* _end, bool& _nonAscii) {
+			uint32_t high = 0;
+			while(size_t(_end - _p) >= simd::cBlockSize) {
+				uint32_t stop = simd::matchMask(_p, '"', '\\');
+				if(stopAtControl_)
+					stop |= simd::controlMask(_p);
+				uint32_t blockHigh = simd::highBitMask(_p);
+				if(stop) {
+					unsigned n = simd::firstBit(stop);
+					high |= blockHigh & ((1u << n) - 1);
+					_nonAscii = high != 0;
+					return _p + n;
+				}
+				high |= blockHigh;
+				_p += simd::cBlockSize;
+			}
+			for(; _p != _end && *_p != '"' && *_p != '\\' && !(stopAtControl_ && (unsigned char)*_p < 0x20); ++_p)
+				high |= (unsigned char)*_p & 0x80;
+			_nonAscii = high != 0;
+			return _p;
+		}
+	}
+
+	template<class Options_>
+	const size_t BasicParser<Options_>::cDefaultMaxDepth;
+
 	//------------------------------------------------------------------------------------------------------------------
-	Parser::Parser(std::istream& _s)
-		:mIn(&_s)
-		,mOwnStream(false)
+	template<class Options_>
+	BasicParser<Options_>::BasicParser()
+		:mIn(nullptr)
+		,mBegin(nullptr)
+		,mCursor(nullptr)
+		,mEnd(nullptr)
+		,mBlockOffset(0)
+		,mStreamStart(-1)
+		,mValidateUtf8(false)
+		,mMaxDepth(cDefaultMaxDepth)
+		,mNumberStart(0)
+		,mReadDepth(0)
+		,mPool(nullptr)
+		,mPackArrays(true)
 	{
 		// Intentionally blank
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	Parser::Parser(const char* _s)
-		:mOwnStream(true)
+	template<class Options_>
+	BasicParser<Options_>::BasicParser(std::istream& _s)
+		:BasicParser()
+	{
+		mIn = &_s;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	BasicParser<Options_>::BasicParser(const char* _s)
+		:BasicParser()
+	{
+		mInput = _s;
+		mBegin = mCursor = mInput.data();
+		mEnd = mBegin + mInput.size();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	BasicParser<Options_>::BasicParser(const char* _data, size_t _size)
+		:BasicParser()
+	{
+		mBegin = mCursor = _data;
+		mEnd = _data + _size;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	BasicParser<Options_>::~BasicParser()
+	{
+		if(mIn)
+			returnUnreadInput();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Buffers and stacks keep their capacity, so switching input doesn't allocate
+	template<class Options_>
+	void BasicParser<Options_>::setInput(const char* _data, size_t _size) {
+		if(mIn)
+			returnUnreadInput();
+		mIn = nullptr;
+		mBegin = mCursor = _data;
+		mEnd = _data + _size;
+		mBlockOffset = 0;
+		mStreamStart = -1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParser<Options_>::setInput(std::istream& _in) {
+		if(mIn)
+			returnUnreadInput();
+		mIn = &_in;
+		mBegin = mCursor = mEnd = nullptr;
+		mBlockOffset = 0;
+		mStreamStart = -1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParser<Options_>::setUtf8Validation(bool _enable) {
+		mValidateUtf8 = _enable;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParser<Options_>::setArrayPacking(bool _enable) {
+		mPackArrays = _enable;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	const ParseError& BasicParser<Options_>::error() const {
+		return mError;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	const ProfileCounters& BasicParser<Options_>::profile() const {
+#ifdef CJSON_PROFILING
+		return mProfile;
+#else
+		static const ProfileCounters none;
+		return none;
+#endif
+	}
+
+#ifdef CJSON_PROFILING
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	size_t BasicParser<Options_>::profilePosition() const {
+		return offset();
+	}
+#endif
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParser<Options_>::setMaxDepth(size_t _maxDepth) {
+		mMaxDepth = _maxDepth;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::parse(Json& _dst)
 	{
-		mIn = new std::stringstream(std::string(_s));
+		CJSON_PROFILE_CALL(mProfile, "parse", [this]{ return profilePosition(); });
+		mError = ParseError();
+		_dst.setNull();
+		return parseElement(_dst) && endDocument();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	Parser::~Parser()
+	template<class Options_>
+	bool BasicParser<Options_>::parse(Json& _dst, const Schema& _schema)
 	{
-		if(mOwnStream)
-			delete mIn;
+		CJSON_PROFILE_CALL(mProfile, "parse", [this]{ return profilePosition(); });
+		mError = ParseError();
+		_dst.setNull();
+		return parseElement(_dst, &_schema) && endDocument();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parse(Json& _dst)
+	// Same structure as parseElement, reporting each element instead of storing it
+	template<class Options_>
+	bool BasicParser<Options_>::parse(SaxHandler& _handler)
 	{
+		CJSON_PROFILE_CALL(mProfile, "parse", [this]{ return profilePosition(); });
+		mError = ParseError();
+		mOpenEvents.clear();
+		for(;;) {
+			skipWhiteSpace();
+			size_t start = offset();
+			int c = peek();
+			bool opened = false;
+			bool accepted;
+			switch (c)
+			{
+			case 'n':
+				if(!readLiteral("null"))
+					return false;
+				accepted = _handler.null();
+				break;
+			case 't':
+			case 'f':
+				if(!readLiteral(c == 't' ? "true" : "false"))
+					return false;
+				accepted = _handler.boolean(c == 't');
+				break;
+			case '\"':
+				mText.clear();
+				if(!readString(mText))
+					return false;
+				accepted = _handler.string(mText);
+				break;
+			case '[':
+			case '{':
+				if(mOpenEvents.size() >= mMaxDepth)
+					return fail(ParseErrorCode::depthLimitExceeded, offset());
+				skip();
+				mOpenEvents.push_back(c == '[' ? ']' : '}');
+				CJSON_PROFILE_DEPTH(mOpenEvents.size());
+				accepted = (c == '[') ? _handler.beginArray() : _handler.beginObject();
+				opened = true;
+				break;
+			default:
+			{
+				if(!startsNumber(c) && !startsNonFinite(c))
+					return failUnexpected();
+				CJSON_PROFILE_SCOPE(number);
+				bool isReal;
+				if(!readNumberText(mNumberText, isReal))
+					return false;
+				if(isReal)
+					accepted = _handler.real(strtof(mNumberText.c_str(), nullptr));
+				else {
+					long long i = strtoll(mNumberText.c_str(), nullptr, 10);
+					accepted = _handler.integer(int(std::max<long long>(INT_MIN, std::min<long long>(INT_MAX, i))));
+				}
+			}
+			}
+			if(!accepted)
+				return fail(ParseErrorCode::rejected, start);
+
+			// Move to the next value, closing finished containers on the way up
+			bool more = false;
+			while(!mOpenEvents.empty()) {
+				char close = mOpenEvents.back();
+				if(!readSeparator(close, opened))
+					return false;
+				opened = false;
+				start = offset();
+				if(peek() == close) {
+					skip();
+					mOpenEvents.pop_back();
+					if(!(close == ']' ? _handler.endArray() : _handler.endObject()))
+						return fail(ParseErrorCode::rejected, start);
+					continue;
+				}
+				if(close == '}') {
+					if(!readKey(mKey))
+						return false;
+					if(!_handler.key(mKey))
+						return fail(ParseErrorCode::rejected, start);
+				}
+				more = true;
+				break;
+			}
+			if(!more)
+				return endDocument(); // Closed the outermost container, or parsed a single value
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Nesting is handled with an explicit stack of open containers instead of recursion, so the depth of the input is
+	// only bounded by mMaxDepth, never by the size of the thread's stack.
+	template<class Options_>
+	bool BasicParser<Options_>::parseElement(Json& _dst, const Schema* _schema)
+	{
+		mStack.clear();
+		mSchemaStack.clear();
+		Json* dst = &_dst; // Where the next value goes
+		const Schema* schema = _schema; // Expected shape of the next value. Null if unknown.
+		for(;;) {
+			// Parse a single value. Containers are just opened here, their elements go through the loop again.
+			skipWhiteSpace();
+			int c = peek();
+			bool opened = false;
+			if(schema && schema->type() == Schema::Type::integer && parseSmallInt(*dst))
+				c = cParsed;
+			switch (c)
+			{
+			case 'n': if(!parseNull(*dst)) return false; break;
+			case 't': if(!parseTrue(*dst)) return false; break;
+			case 'f': if(!parseFalse(*dst)) return false; break;
+			case '\"': if(!parseString(*dst)) return false; break;
+			case '[':
+			case '{':
+				if(mStack.size() >= mMaxDepth)
+					return fail(ParseErrorCode::depthLimitExceeded, offset());
+				skip();
+				dst->makeContainer((c == '[') ? Json::DataType::array : Json::DataType::object);
+				mStack.push_back(dst);
+				CJSON_PROFILE_DEPTH(mStack.size());
+				if(_schema) {
+					Schema::Type expected = (c == '[') ? Schema::Type::array : Schema::Type::object;
+					SchemaFrame frame = { (schema && schema->type() == expected) ? schema : nullptr, 0 };
+					mSchemaStack.push_back(frame);
+				}
+				opened = true;
+				break;
+			case cParsed:
+				break;
+			default:
+				// Is it a number?
+				if(startsNumber(c) || startsNonFinite(c)) {
+					if(!parseNumber(*dst))
+						return false;
+					break;
+				}
+				// Unsupported, return parsing error
+				return failUnexpected();
+			}
+
+			// Find the slot for the next value, closing finished containers on the way up
+			dst = nullptr;
+			while(!mStack.empty()) {
+				Json& container = *mStack.back();
+				bool isArray = container.mType == Json::DataType::array;
+				if(!readSeparator(isArray ? ']' : '}', opened))
+					return false;
+				opened = false;
+				if(peek() == (isArray ? ']' : '}')) {
+					skip();
+					mStack.pop_back();
+					if(_schema)
+						mSchemaStack.pop_back();
+					continue;
+				}
+				SchemaFrame* frame = _schema ? &mSchemaStack.back() : nullptr;
+				schema = nullptr;
+				if(isArray) {
+					Json::Container& elements = *container.mContainer;
+					int next = peek();
+					if(mPackArrays && elements.array.empty() && (startsNumber(next) || next == 't' || next == 'f')) {
+						if(!(startsNumber(next) ? parsePackedNumber(container) : parsePackedBoolean(container)))
+							return false;
+						continue; // Look for the next element of the same array
+					}
+					if(elements.packing != Json::DataType::null)
+						container.unpack();
+					// Containers being parsed are never shared, so they are filled in directly
+					elements.array.push_back(newNode());
+					dst = container.mContainer->array.back();
+					if(frame && frame->schema)
+						schema = frame->schema->elements();
+				}
+				else {
+					if(frame && frame->schema) {
+						// Try the key that usually comes next, then look up whatever key we find
+						const Schema& expected = *frame->schema;
+						int field = -1;
+						size_t next = frame->nextKey;
+						if(next < expected.fieldCount() && expected.isPlainKey(next) && matchKey(expected.key(next))) {
+							field = int(frame->nextKey);
+							mKey = expected.key(frame->nextKey);
+						}
+						else {
+							if(!readKey(mKey))
+								return false;
+							field = expected.findKey(mKey.data(), mKey.size());
+						}
+						if(field >= 0) {
+							schema = &expected.field(size_t(field));
+							frame->nextKey = size_t(field) + 1;
+						}
+					}
+					else if(!readKey(mKey))
+						return false;
+					Json*& slot = container.mContainer->object[mKey];
+					if(slot) // Repeated key, last value wins
+						slot->setNull();
+					else
+						slot = newNode();
+					dst = slot;
+				}
+				break;
+			}
+			if(!dst)
+				return true; // Closed the outermost container, or parsed a single value
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Only works when the whole key is in the current block, which is almost always the case
+	template<class Options_>
+	bool BasicParser<Options_>::matchKey(const std::string& _key) {
+		CJSON_PROFILE_SCOPE(string);
+		const char* p = mCursor;
+		size_t size = _key.size();
+		if(size_t(mEnd - p) < size + 2 || p[0] != '"' || p[size + 1] != '"' || memcmp(p + 1, _key.data(), size) != 0)
+			return false;
+		mCursor = p + size + 2;
 		skipWhiteSpace();
-		char c = mIn->peek();
-		switch (c)
-		{
-		case 'n': return parseNull(_dst);
-		case 't': return parseTrue(_dst);
-		case 'f': return parseFalse(_dst);
-		case '\"': return parseString(_dst);
-		case '[': return parseArray(_dst);
-		case '{': return parseObject(_dst);
-		default:
-			// Is it a number?
-			if(c >= '0' && c <= '9' || c == '+' || c == '-')
-				return parseNumber(_dst);
-			// Unsupported, return parsing error
+		if(peek() != ':') {
+			mCursor = p; // Let the generic path report the error
 			return false;
 		}
+		skip();
+		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseNull(Json& _dst) {
+	// Plain integers are converted as they are scanned, without going through a string. Anything else, like reals,
+	// long numbers or numbers split across blocks, is left to parseNumber.
+	template<class Options_>
+	bool BasicParser<Options_>::parseSmallInt(Json& _dst) {
+		CJSON_PROFILE_SCOPE(number);
+		const char* p = mCursor;
+		bool negative = p != mEnd && *p == '-';
+		if(negative)
+			++p;
+		const char* digits = p;
+		int value = 0;
+		while(p != mEnd && *p >= '0' && *p <= '9' && p - digits < 9)
+			value = value * 10 + (*p++ - '0');
+		if(p == digits || p == mEnd || (*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E')
+			return false;
+		// Leading zeros and suffixes are left to readNumberText, which rejects them unless numbers may be loose
+		if(!Options_::looseNumbers && ((*digits == '0' && p - digits > 1) || *p == 'f'))
+			return false;
+		mCursor = p;
+		_dst = negative ? -value : value;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Numbers are packed for as long as they all have the same type
+	template<class Options_>
+	bool BasicParser<Options_>::parsePackedNumber(Json& _array) {
+		CJSON_PROFILE_SCOPE(number);
+		bool isReal;
+		if(!readNumberText(mNumberText, isReal))
+			return false;
+		Json::DataType type = isReal ? Json::DataType::real : Json::DataType::integer;
+		Json::Container& elements = *_array.mContainer;
+		if(elements.packing == Json::DataType::null || elements.packing == type) {
+			elements.packing = type;
+			Json::Number number;
+			if(isReal)
+				number.f = strtof(mNumberText.c_str(), nullptr);
+			else
+				number.i = toInt(mNumberText);
+			elements.numbers.push_back(number);
+			return true;
+		}
+		// Mixed types, go on with a regular array
+		_array.unpack();
+		Json* node = newNode();
+		elements.array.push_back(node);
+		return isReal ? parseFloat(mNumberText, *node) : parseInt(mNumberText, *node);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Same for booleans
+	template<class Options_>
+	bool BasicParser<Options_>::parsePackedBoolean(Json& _array) {
+		Json value;
+		if(!(peek() == 't' ? parseTrue(value) : parseFalse(value)))
+			return false;
+		Json::Container& elements = *_array.mContainer;
+		if(elements.packing == Json::DataType::null || elements.packing == Json::DataType::boolean) {
+			elements.packing = Json::DataType::boolean;
+			elements.booleans.push_back(Json::Boolean{ value.mNumber.b });
+			return true;
+		}
+		_array.unpack(); // Mixed types
+		Json* node = newNode();
+		elements.array.push_back(node);
+		*node = std::move(value);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::parseNull(Json& _dst) {
+		CJSON_PROFILE_SCOPE(literal);
+		size_t start = offset();
 		char buff[4];
-		mIn->read(buff,4);
-		return 0 == strncmp("null",buff,4);
+		for(char& c : buff)
+			c = char(get());
+		return 0 == strncmp("null",buff,4) || fail(ParseErrorCode::invalidLiteral, start);
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseTrue(Json& _dst) {
+	template<class Options_>
+	bool BasicParser<Options_>::parseTrue(Json& _dst) {
+		CJSON_PROFILE_SCOPE(literal);
+		size_t start = offset();
 		_dst.mType = Json::DataType::boolean;
 		char buff[4];
-		mIn->read(buff,4);
+		for(char& c : buff)
+			c = char(get());
 		_dst = true;
-		return 0 == strncmp("true",buff,4);
+		return 0 == strncmp("true",buff,4) || fail(ParseErrorCode::invalidLiteral, start);
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseFalse(Json& _dst) {
+	template<class Options_>
+	bool BasicParser<Options_>::parseFalse(Json& _dst) {
+		CJSON_PROFILE_SCOPE(literal);
+		size_t start = offset();
 		_dst.mType = Json::DataType::boolean;
 		char buff[5];
-		mIn->read(buff,5);
+		for(char& c : buff)
+			c = char(get());
 		_dst = false;
-		return 0 == strncmp("false",buff,5);
+		return 0 == strncmp("false",buff,5) || fail(ParseErrorCode::invalidLiteral, start);
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseNumber(Json& _dst) {
-		// Skip all digits
-		std::string num;
-		if(mIn->peek() == '+')
-			mIn->ignore();
-		if(mIn->peek() == '-')
-			num += mIn->get();
-		while(cDigits.find(mIn->peek()) != std::string::npos) {
-			num += char(mIn->get());
-		}
-		int c = mIn->peek();
+	template<class Options_>
+	bool BasicParser<Options_>::parseNumber(Json& _dst) {
+		CJSON_PROFILE_SCOPE(number);
+		bool isReal;
+		if(!readNumberText(mNumberText, isReal))
+			return false;
 		// Either parse as a float or an int
-		if(c == '.') {
-			num += mIn->get();
+		if(isReal)
+			return parseFloat(mNumberText, _dst);
+		else
+			return parseInt(mNumberText, _dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readNumberText(std::string& _num, bool& _isReal) {
+		CJSON_PROFILE_SCOPE(number);
+		size_t start = offset();
+		// Skip all digits
+		_num.clear();
+		if(peek() == '+') {
+			if(!Options_::looseNumbers)
+				return fail(ParseErrorCode::invalidNumber, start);
+			skip();
+		}
+		if(peek() == '-')
+			_num += char(get());
+		size_t integer = _num.size(); // Where the integer part starts
+		while(isDigit(peek()))
+			_num += char(get());
+		size_t integerDigits = _num.size() - integer;
+		if(!integerDigits && startsNonFinite(peek())) {
+			_isReal = true;
+			return readNonFinite(_num);
+		}
+		bool strict = !Options_::looseNumbers;
+		if(strict && (!integerDigits || (integerDigits > 1 && _num[integer] == '0')))
+			return fail(ParseErrorCode::invalidNumber, start);
+		size_t fractionDigits = 0;
+		_isReal = peek() == '.';
+		if(_isReal) {
+			_num += char(get());
 			// Parse the rest of the number
-			while(cDigits.find(mIn->peek()) != std::string::npos) {
-				num += char(mIn->get());
+			while(isDigit(peek())) {
+				_num += char(get());
+				++fractionDigits;
 			}
-			if (mIn->peek() == 'f') {
-				mIn->ignore();
-			}
-			
-			return parseFloat(num, _dst);
+			if(strict && !fractionDigits)
+				return fail(ParseErrorCode::invalidNumber, start);
 		}
-		else
-			return parseInt(num, _dst);
+		if(!integerDigits && !fractionDigits)
+			return fail(ParseErrorCode::invalidNumber, start);
+		// Exponent, which is what the serializer writes for very large or small reals
+		if(peek() == 'e' || peek() == 'E') {
+			_isReal = true;
+			_num += char(get());
+			if(peek() == '+' || peek() == '-')
+				_num += char(get());
+			if(!isDigit(peek()))
+				return fail(ParseErrorCode::invalidNumber, start);
+			while(isDigit(peek()))
+				_num += char(get());
+		}
+		if(peek() == 'f') { // Float suffix, which is only skipped after reals
+			if(!Options_::looseNumbers)
+				return fail(ParseErrorCode::invalidNumber, offset());
+			if(_isReal)
+				skip();
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readNonFinite(std::string& _num) {
+		bool nan = peek() == 'N';
+		if(!readLiteral(nan ? "NaN" : "Infinity"))
+			return false;
+		_num += nan ? "nan" : "inf";
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Read into a buffer that keeps its capacity, so the only allocation left is the one for long strings
+	template<class Options_>
+	bool BasicParser<Options_>::parseString(Json& _dst) {
+		CJSON_PROFILE_SCOPE(string);
+		mText.clear();
+		if(!readString(mText))
+			return false;
+		_dst.setText(mText.data(), mText.size());
+		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseString(Json& _dst) {
-		mIn->ignore(1); // Skip opening quotes
-		bool escaped = false;
-		std::ostringstream oss;
+	template<class Options_>
+	bool BasicParser<Options_>::readString(std::string& _dst) {
+		CJSON_PROFILE_SCOPE(string);
+		skip(); // Skip opening quotes
+		Utf8Validator validator;
 		// Read until the first unescaped quote
-		for(int c = mIn->get(); (c != '"') || escaped; c = mIn->get()) {
-			if(mIn->eof())
-				return false; // Unterminated string
-			if(escaped || c == '\\')
-				escaped ^= 1; // Negate escape state
+		for(;;) {
+			if(mCursor == mEnd && !refill())
+				return fail(ParseErrorCode::unexpectedEnd, offset()); // Unterminated string
+			// Copy whole runs of plain characters at once
+			const char* run = mCursor;
+			bool nonAscii;
+			// Runs stop at raw control characters when they aren't accepted, so rejecting them takes no extra pass
+			mCursor = scanStringRun<!Options_::controlCharacters>(run, mEnd, nonAscii);
+			if(!Options_::controlCharacters && mCursor != mEnd && (unsigned char)*mCursor < 0x20)
+				return fail(ParseErrorCode::invalidString, offset());
+			_dst.append(run, mCursor);
+			if(mValidateUtf8 && nonAscii) {
+				const char* invalid = validator.feed(run, mCursor);
+				if(invalid)
+					return fail(ParseErrorCode::invalidUtf8, offsetOf(invalid));
+			}
+			if(mCursor == mEnd)
+				continue; // The run goes on in the next block
+			// A multi-byte sequence can't be interrupted by an escape or the closing quotes
+			if(mValidateUtf8 && !validator.complete())
+				return fail(ParseErrorCode::invalidUtf8, offset());
+			if(*mCursor++ == '"')
+				return true;
+			if(!parseEscape(_dst))
+				return false;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::parseEscape(std::string& _dst) {
+		size_t start = offset() - 1; // Include the backslash
+		int c = get();
+		switch(c) {
+		case '"':
+		case '\\':
+		case '/':
+			_dst += char(c);
+			return true;
+		case 'b': _dst += '\b'; return true;
+		case 'f': _dst += '\f'; return true;
+		case 'n': _dst += '\n'; return true;
+		case 'r': _dst += '\r'; return true;
+		case 't': _dst += '\t'; return true;
+		case 'u':
+		{
+			unsigned codePoint;
+			if(!readHex4(codePoint))
+				return fail(ParseErrorCode::invalidEscape, start);
+			if(codePoint >= 0xD800 && codePoint < 0xDC00) { // High surrogate, must be followed by a low one
+				unsigned low;
+				if(get() != '\\' || get() != 'u' || !readHex4(low) || low < 0xDC00 || low >= 0xE000)
+					return fail(ParseErrorCode::invalidEscape, start);
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+			}
+			else if(mValidateUtf8 && codePoint >= 0xDC00 && codePoint < 0xE000)
+				return fail(ParseErrorCode::invalidUtf8, start); // Unpaired low surrogate
+			appendUtf8(_dst, codePoint);
+			return true;
+		}
+		default:
+			return fail(ParseErrorCode::invalidEscape, start);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readHex4(unsigned& _value) {
+		_value = 0;
+		for(int i = 0; i < 4; ++i) {
+			int c = get();
+			unsigned digit;
+			if(c >= '0' && c <= '9')
+				digit = unsigned(c - '0');
+			else if(c >= 'a' && c <= 'f')
+				digit = unsigned(c - 'a' + 10);
+			else if(c >= 'A' && c <= 'F')
+				digit = unsigned(c - 'A' + 10);
 			else
-				oss << (char)c;
+				return false;
+			_value = (_value << 4) | digit;
 		}
-		_dst = oss.str(); // Do not include the quote we just read.
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseArray(Json& _dst) {
-		_dst.mType = Json::DataType::array;
-		mIn->ignore(); // Skip [
-		skipWhiteSpace();
-		Json element;
-		while(mIn->peek() != ']') {
-			// Parse element
-			if(!parse(element))
+	template<class Options_>
+	bool BasicParser<Options_>::parseInt(const std::string& _num, Json& _dst) {
+		_dst.mType = Json::DataType::integer;
+		_dst = toInt(_num);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::parseFloat(const std::string& _num, Json& _dst) {
+		_dst.mType = Json::DataType::real;
+		_dst = strtof(_num.c_str(), nullptr);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readKey(std::string& _key) {
+		_key.clear();
+		if(peek() == '"'){
+			if(!readString(_key))
 				return false;
-			_dst.push_back(element);
-			// Read upto the next element
-			skipWhiteSpace();
-			if(mIn->peek() == ',') {
-				mIn->ignore();
+		}
+		else { // Unquoted key
+			if(!Options_::unquotedKeys)
+				return failUnexpected();
+			while (peek() != ':') {
+				if(peek() == EOF)
+					return failUnexpected();
+				_key += char(get());
 				skipWhiteSpace();
 			}
 		}
-		mIn->ignore(); // Skip ]
+		skipWhiteSpace();
+		if(peek() != ':')
+			return peek() == EOF ? failUnexpected() : fail(ParseErrorCode::missingColon, offset());
+		skip();
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseObject(Json& _dst) {
-		_dst.mType = Json::DataType::object;
-		mIn->ignore(); // Skip {
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(bool& _dst) {
 		skipWhiteSpace();
-		std::string key;
-		while(mIn->peek() != '}') {
-			Json value;
-			// Parse element
-			if(!parseObjectEntry(key,value))
-				return false;
-			_dst[key] = value;
-			// Read upto the next element
-			skipWhiteSpace();
-			if(mIn->peek() == ',') {
-				mIn->ignore();
-				skipWhiteSpace();
-			}
+		if(peek() == 't') {
+			_dst = true;
+			return readLiteral("true");
 		}
-		mIn->ignore(); // Skip }
+		if(peek() == 'f') {
+			_dst = false;
+			return readLiteral("false");
+		}
+		return peek() == EOF ? failUnexpected() : fail(ParseErrorCode::typeMismatch, offset());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(int& _dst) {
+		long long value;
+		if(!readInteger(value))
+			return false;
+		if(value < INT_MIN || value > INT_MAX)
+			return fail(ParseErrorCode::invalidNumber, mNumberStart);
+		_dst = int(value);
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseInt(const std::string& _num, Json& _dst) {
-		_dst.mType = Json::DataType::integer;
-		int i;
-		std::stringstream(_num) >> i;
-		_dst = i;
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(unsigned& _dst) {
+		long long value;
+		if(!readInteger(value))
+			return false;
+		if(value < 0 || value > UINT_MAX)
+			return fail(ParseErrorCode::invalidNumber, mNumberStart);
+		_dst = unsigned(value);
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseFloat(const std::string& _num, Json& _dst) {
-		_dst.mType = Json::DataType::real;
-		float f;
-		std::stringstream(_num) >> f;
-		_dst = f;
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(float& _dst) {
+		double value;
+		if(!readValue(value))
+			return false;
+		_dst = float(value);
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Parser::parseObjectEntry(std::string& _oKey, Json& _dst) {
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(double& _dst) {
+		bool isReal;
+		if(!beginNumber() || !readNumberText(mNumberText, isReal))
+			return false;
+		_dst = strtod(mNumberText.c_str(), nullptr);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(std::string& _dst) {
 		skipWhiteSpace();
-		if(mIn->peek() == '"'){
-			Json key;
-			if(!parseString(key)) // Key 
+		if(peek() != '"')
+			return peek() == EOF ? failUnexpected() : fail(ParseErrorCode::typeMismatch, offset());
+		_dst.clear();
+		return readString(_dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(Json& _dst) {
+		_dst.setNull();
+		return parseElement(_dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readValue(std::vector<bool>& _dst) {
+		_dst.clear();
+		if(!beginContainer('['))
+			return false;
+		bool more;
+		for(bool first = true; ; first = false) {
+			if(!nextElement(']', first, more))
 				return false;
-			_oKey = std::string(key);
+			if(!more)
+				return true;
+			bool element;
+			if(!readValue(element))
+				return false;
+			_dst.push_back(element);
 		}
-		else { // Unquoted key
-			_oKey = "";
-			while (mIn->peek() != ':') {
-				if(mIn->eof())
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readInteger(long long& _dst) {
+		CJSON_PROFILE_SCOPE(number);
+		bool isReal;
+		if(!beginNumber() || !readNumberText(mNumberText, isReal))
+			return false;
+		if(isReal)
+			return fail(ParseErrorCode::typeMismatch, mNumberStart);
+		errno = 0;
+		_dst = strtoll(mNumberText.c_str(), nullptr, 10);
+		if(errno == ERANGE)
+			return fail(ParseErrorCode::invalidNumber, mNumberStart);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::beginNumber() {
+		skipWhiteSpace();
+		mNumberStart = offset();
+		int c = peek();
+		if(startsNumber(c) || startsNonFinite(c))
+			return true;
+		return c == EOF ? failUnexpected() : fail(ParseErrorCode::typeMismatch, mNumberStart);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readLiteral(const char* _literal) {
+		CJSON_PROFILE_SCOPE(literal);
+		size_t start = offset();
+		for(const char* c = _literal; *c; ++c) {
+			if(get() != (unsigned char)*c)
+				return fail(ParseErrorCode::invalidLiteral, start);
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::beginContainer(char _open) {
+		skipWhiteSpace();
+		if(peek() != _open)
+			return peek() == EOF ? failUnexpected() : fail(ParseErrorCode::typeMismatch, offset());
+		if(mReadDepth >= mMaxDepth)
+			return fail(ParseErrorCode::depthLimitExceeded, offset());
+		++mReadDepth;
+		CJSON_PROFILE_DEPTH(mReadDepth);
+		skip();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readSeparator(char _close, bool _first) {
+		skipWhiteSpace();
+		int c = peek();
+		if(c == ',' && !_first) {
+			skip();
+			skipWhiteSpace();
+			if(peek() == _close && !Options_::trailingCommas)
+				return fail(ParseErrorCode::unexpectedCharacter, offset());
+			return true;
+		}
+		if(_first || c == _close || Options_::optionalCommas)
+			return true;
+		return c == EOF ? failUnexpected() : fail(ParseErrorCode::missingComma, offset());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::nextElement(char _close, bool _first, bool& _more) {
+		if(!readSeparator(_close, _first))
+			return false;
+		_more = peek() != _close;
+		if(!_more) {
+			skip();
+			--mReadDepth;
+		}
+		else if(peek() == EOF)
+			return failUnexpected();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Checks the syntax like parseElement does, but keeps nothing. Strings and numbers go through the same scratch
+	// buffers every time, so skipping doesn't allocate once they have grown.
+	template<class Options_>
+	bool BasicParser<Options_>::skipValue() {
+		mOpenEvents.clear();
+		bool opened = false;
+		for(;;) {
+			int c;
+			if(mOpenEvents.empty()) {
+				skipWhiteSpace();
+				c = peek();
+			}
+			else {
+				if(!readSeparator(mOpenEvents.back(), opened))
+					return false;
+				opened = false;
+				c = peek();
+				if(c == mOpenEvents.back()) { // End of a container
+					skip();
+					mOpenEvents.pop_back();
+					if(mOpenEvents.empty())
+						return true;
+					continue;
+				}
+				if(mOpenEvents.back() == '}') {
+					if(!readKey(mText))
+						return false;
+					skipWhiteSpace();
+					c = peek();
+				}
+			}
+			bool isReal;
+			switch(c) {
+			case '{':
+			case '[':
+				if(mReadDepth + mOpenEvents.size() >= mMaxDepth)
+					return fail(ParseErrorCode::depthLimitExceeded, offset());
+				skip();
+				mOpenEvents.push_back(c == '{' ? '}' : ']');
+				CJSON_PROFILE_DEPTH(mReadDepth + mOpenEvents.size());
+				opened = true;
+				continue;
+			case '"':
+				mText.clear();
+				if(!readString(mText))
+					return false;
+				break;
+			case 'n':
+				if(!readLiteral("null"))
+					return false;
+				break;
+			case 't':
+				if(!readLiteral("true"))
 					return false;
-				_oKey = _oKey + char(mIn->get());
+				break;
+			case 'f':
+				if(!readLiteral("false"))
+					return false;
+				break;
+			default:
+				if(!startsNumber(c) && !startsNonFinite(c))
+					return failUnexpected();
+				if(!readNumberText(mNumberText, isReal))
+					return false;
+				break;
+			}
+			if(mOpenEvents.empty())
+				return true;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	/// Paths of the columns, as a tree of keys. Each key leads to a column, to deeper keys, or to both.
+	template<class Options_>
+	struct BasicParser<Options_>::ColumnNode {
+		std::vector<std::string>	keys;
+		std::vector<const char*>	names; ///< Point into keys, for the key table
+		std::vector<int>			columns; ///< Column of each key, or -1
+		std::vector<int>			children; ///< Node with the keys below each key, or -1
+		std::unique_ptr<KeyTable>	table;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readColumns(std::vector<Column>& _columns) {
+		CJSON_PROFILE_CALL(mProfile, "readColumns", [this]{ return profilePosition(); });
+		mError = ParseError();
+		mReadDepth = 0;
+
+		// Tree of keys
+		std::vector<ColumnNode> nodes(1);
+		for(size_t c = 0; c < _columns.size(); ++c) {
+			const std::string& path = _columns[c].path();
+			size_t node = 0;
+			for(size_t start = 0; ; ) {
+				size_t end = path.find('.', start);
+				std::string key = path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+				size_t k = 0;
+				while(k < nodes[node].keys.size() && nodes[node].keys[k] != key)
+					++k;
+				if(k == nodes[node].keys.size()) {
+					nodes[node].keys.push_back(key);
+					nodes[node].columns.push_back(-1);
+					nodes[node].children.push_back(-1);
+				}
+				if(end == std::string::npos) {
+					assert(nodes[node].columns[k] < 0 && "Repeated column path");
+					nodes[node].columns[k] = int(c);
+					break;
+				}
+				if(nodes[node].children[k] < 0) {
+					nodes[node].children[k] = int(nodes.size());
+					nodes.emplace_back();
+				}
+				node = size_t(nodes[node].children[k]);
+				start = end + 1;
+			}
+		}
+		for(ColumnNode& node : nodes) { // Keys don't move anymore
+			for(const std::string& key : node.keys)
+				node.names.push_back(key.c_str());
+			node.table.reset(new KeyTable(node.names.data(), node.names.size()));
+		}
+
+		size_t rows = _columns.empty() ? 0 : _columns[0].size();
+		auto failed = [&]() {
+			for(Column& column : _columns)
+				column.truncate(rows);
+			return false;
+		};
+		if(!beginContainer('['))
+			return failed();
+		bool more;
+		for(bool first = true; ; first = false) {
+			if(!nextElement(']', first, more))
+				return failed();
+			if(!more)
+				return endDocument() || failed();
+			for(Column& column : _columns)
+				column.addRow();
+			skipWhiteSpace();
+			if(peek() == 'n') {
+				if(!readLiteral("null"))
+					return failed();
+			}
+			else if(!readRecord(nodes, 0, _columns))
+				return failed();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readRecord(const std::vector<ColumnNode>& _nodes, size_t _node,
+		std::vector<Column>& _columns) {
+		if(!beginContainer('{'))
+			return false;
+		const ColumnNode& node = _nodes[_node];
+		bool more;
+		for(bool first = true; ; first = false) {
+			if(!nextElement('}', first, more))
+				return false;
+			if(!more)
+				return true;
+			if(!readKey(mKey))
+				return false;
+			int key = node.table->find(mKey.data(), mKey.size());
+			if(key >= 0) {
 				skipWhiteSpace();
+				int child = node.children[size_t(key)];
+				int column = node.columns[size_t(key)];
+				if(child >= 0 && (peek() == '{' || column < 0)) {
+					if(peek() == 'n') { // Nothing below a null
+						if(!readLiteral("null"))
+							return false;
+						continue;
+					}
+					if(!readRecord(_nodes, size_t(child), _columns))
+						return false;
+					continue;
+				}
+				if(column >= 0) {
+					if(!readCell(_columns[size_t(column)]))
+						return false;
+					continue;
+				}
 			}
+			if(!skipValue())
+				return false;
 		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::readCell(Column& _column) {
+		if(peek() == 'n')
+			return readLiteral("null");
+		switch(_column.type()) {
+		case Column::Type::int64:
+		{
+			long long value;
+			if(!readInteger(value))
+				return false;
+			_column.setInteger(value);
+			return true;
+		}
+		case Column::Type::real:
+		{
+			double value;
+			if(!readValue(value))
+				return false;
+			_column.setReal(value);
+			return true;
+		}
+		case Column::Type::boolean:
+		{
+			bool value;
+			if(!readValue(value))
+				return false;
+			_column.setBoolean(value);
+			return true;
+		}
+		case Column::Type::text:
+			if(!readValue(mText))
+				return false;
+			_column.setText(mText);
+			return true;
+		}
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	void BasicParser<Options_>::skipWhiteSpace() {
+		CJSON_PROFILE_SCOPE(whitespace);
+		for(;;) {
+			while(mCursor != mEnd && isSpace(*mCursor))
+				++mCursor;
+			if(mCursor != mEnd) {
+				if(!Options_::comments || *mCursor != '/' || !skipComment())
+					return;
+			}
+			else if(!refill())
+				return;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::endDocument() {
+		if(Options_::trailingContent)
+			return true;
 		skipWhiteSpace();
-		if(mIn->get() != ':')
+		return peek() == EOF || fail(ParseErrorCode::unexpectedCharacter, offset());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// A slash at the end of a block is kept by refill, so it is still there to fail on if it doesn't start a comment
+	template<class Options_>
+	bool BasicParser<Options_>::skipComment() {
+		if(mEnd - mCursor < 2)
+			refill();
+		if(mEnd - mCursor < 2 || (mCursor[1] != '/' && mCursor[1] != '*'))
 			return false;
-		parse(_dst); // Value
-		return true;
+		bool block = mCursor[1] == '*';
+		mCursor += 2;
+		for(int c = get(); c != EOF; c = get()) {
+			if(!block && c == '\n')
+				return true;
+			if(block && c == '*' && peek() == '/') {
+				skip();
+				return true;
+			}
+		}
+		return true; // Unterminated block comments fail on the end of the input
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	inline int BasicParser<Options_>::peek() {
+		if(mCursor == mEnd && !refill())
+			return EOF;
+		return (unsigned char)*mCursor;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	void Parser::skipWhiteSpace() {
-		while(cSpacers.find(mIn->peek()) != std::string::npos)
-			mIn->ignore();
+	template<class Options_>
+	inline int BasicParser<Options_>::get() {
+		int c = peek();
+		if(c != EOF)
+			++mCursor;
+		return c;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	inline void BasicParser<Options_>::skip() {
+		if(peek() != EOF)
+			++mCursor;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	inline Json* BasicParser<Options_>::newNode() {
+		return mPool ? mPool->allocate() : new Json();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Only what the stream already holds in its own buffer is taken, so input is never read from the source past the
+	// block that holds the end of the document. That keeps the rest of a pipe or socket for the next reader.
+	template<class Options_>
+	bool BasicParser<Options_>::refill() {
+		if(!mIn)
+			return false; // Reading from memory, everything is already in the buffer
+		if(mStreamStart == std::streampos(-1))
+			mStreamStart = mIn->tellg();
+		std::streambuf* in = mIn->rdbuf();
+		if(!in || in->sgetc() == EOF) { // sgetc fills the stream's buffer if it is empty
+			mIn->setstate(std::ios_base::eofbit);
+			return false; // Keep the last block around, it may be needed to locate errors
+		}
+		// Unconsumed input moves to the front of the new block. Only skipComment leaves any, a single slash.
+		size_t kept = size_t(mEnd - mCursor);
+		mBlockOffset += size_t(mCursor - mBegin);
+		if(mBuffer.empty())
+			mBuffer.resize(cReadBlockSize);
+		if(kept)
+			memmove(mBuffer.data(), mCursor, kept);
+		// Stream buffers that don't buffer report nothing available. Take one character at a time from those.
+		std::streamsize available = std::max<std::streamsize>(1, in->in_avail());
+		available = std::min(available, std::streamsize(mBuffer.size() - kept));
+		std::streamsize got = in->sgetn(mBuffer.data() + kept, available);
+		mBegin = mBuffer.data();
+		mCursor = mBegin;
+		mEnd = mBegin + kept + got;
+		return got > 0;
 	}
 
+	//------------------------------------------------------------------------------------------------------------------
+	// Give back whatever we didn't consume, so the next user of the stream starts reading right after the last parsed
+	// element. The unread characters are still in the stream's buffer, since refill took no more than it held, so they
+	// are put back without seeking, and that works on pipes too. Locating an error moves the stream, which empties its
+	// buffer; seekable streams are then moved back instead. The state of the stream is left alone.
+	template<class Options_>
+	void BasicParser<Options_>::returnUnreadInput() {
+		std::streambuf* in = mIn->rdbuf();
+		while(in && mEnd != mCursor && in->sungetc() != EOF)
+			--mEnd;
+		if(in && mEnd != mCursor)
+			in->pubseekoff(-std::streamoff(mEnd - mCursor), std::ios_base::cur, std::ios_base::in);
+		mBlockOffset += size_t(mCursor - mBegin);
+		mBegin = mCursor = mEnd = nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	inline size_t BasicParser<Options_>::offset() const {
+		return mBlockOffset + size_t(mCursor - mBegin);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	inline size_t BasicParser<Options_>::offsetOf(const char* _p) const {
+		return mBlockOffset + size_t(_p - mBegin);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::fail(ParseErrorCode _code, size_t _offset) {
+		mError.code = _code;
+		mError.offset = _offset;
+		locateError();
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	bool BasicParser<Options_>::failUnexpected() {
+		if(peek() == EOF)
+			return fail(ParseErrorCode::unexpectedEnd, offset());
+		return fail(ParseErrorCode::unexpectedCharacter, offset());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Line and column are not tracked while parsing. Instead, we go back to the start of the input and count lines up
+	// to the error. If the input can't be rewound, and the error isn't in the first block, only the context is known.
+	template<class Options_>
+	void BasicParser<Options_>::locateError() {
+		const size_t cContextRadius = 24;
+		ParseError& e = mError;
+		e.line = e.column = 0;
+		e.context.clear();
+		e.contextOffset = 0;
+
+		// Input around the error, from the current block
+		size_t blockEnd = mBlockOffset + size_t(mEnd - mBegin);
+		if(e.offset >= mBlockOffset && e.offset <= blockEnd) {
+			const char* at = mBegin + (e.offset - mBlockOffset);
+			const char* from = at - std::min<size_t>(cContextRadius, size_t(at - mBegin));
+			const char* to = at + std::min<size_t>(cContextRadius, size_t(mEnd - at));
+			e.context.assign(from, to);
+			e.contextOffset = size_t(at - from);
+		}
+
+		// Count lines up to the error
+		size_t line = 1;
+		size_t lineStart = 0; // Offset of the first character in the line
+		if(mBlockOffset == 0 && e.offset <= blockEnd) { // Everything is still in memory
+			for(const char* p = mBegin; p != mBegin + e.offset; ++p) {
+				if(*p == '\n') {
+					++line;
+					lineStart = size_t(p - mBegin) + 1;
+				}
+			}
+		}
+		else {
+			if(mStreamStart == std::streampos(-1))
+				return;
+			mIn->clear();
+			std::streampos resume = mIn->tellg();
+			if(resume == std::streampos(-1) || !mIn->seekg(mStreamStart)) {
+				mIn->clear();
+				return; // Not seekable
+			}
+			char block[4096];
+			size_t pos = 0;
+			while(pos < e.offset) {
+				mIn->read(block, std::streamsize(std::min(sizeof(block), e.offset - pos)));
+				size_t n = size_t(mIn->gcount());
+				if(n == 0)
+					break;
+				for(size_t i = 0; i < n; ++i) {
+					if(block[i] == '\n') {
+						++line;
+						lineStart = pos + i + 1;
+					}
+				}
+				pos += n;
+			}
+			mIn->clear();
+			mIn->seekg(resume);
+		}
+		e.line = line;
+		e.column = e.offset - lineStart + 1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	ParseError::ParseError()
+		: code(ParseErrorCode::none)
+		, offset(0)
+		, line(0)
+		, column(0)
+		, contextOffset(0)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* ParseError::description() const {
+		switch(code) {
+		case ParseErrorCode::none: return "no error";
+		case ParseErrorCode::unexpectedEnd: return "unexpected end of input";
+		case ParseErrorCode::unexpectedCharacter: return "unexpected character";
+		case ParseErrorCode::invalidLiteral: return "invalid literal";
+		case ParseErrorCode::invalidNumber: return "invalid number";
+		case ParseErrorCode::invalidEscape: return "invalid escape sequence";
+		case ParseErrorCode::invalidString: return "control character in string";
+		case ParseErrorCode::invalidUtf8: return "invalid UTF-8";
+		case ParseErrorCode::missingColon: return "expected ':' after object key";
+		case ParseErrorCode::missingComma: return "expected ',' between elements";
+		case ParseErrorCode::depthLimitExceeded: return "maximum nesting depth exceeded";
+		case ParseErrorCode::typeMismatch: return "value doesn't match the expected type";
+		case ParseErrorCode::rejected: return "rejected by the handler";
+		default: return "unknown error";
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	std::string ParseError::message() const {
+		std::stringstream ss;
+		if(line)
+			ss << "line " << line << ", column " << column;
+		else
+			ss << "offset " << offset;
+		ss << ": " << description();
+		return ss.str();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// The parsers built with the library, one per parsing policy
+	template class BasicParser<StrictParsing>;
+	template class BasicParser<DefaultParsing>;
+	template class BasicParser<LenientParsing>;
+
 }	// namespace cjson
\ No newline at end of file
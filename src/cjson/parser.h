@@ -26,27 +26,64 @@
 #ifndef _CJSON_PARSER_H_
 #define _CJSON_PARSER_H_
 
+#include <ios>
 #include <string>
+#include <type_traits>
+#include <vector>
+#include "parseError.h"
+#include "parseOptions.h"
+#include "profiling.h"
+#include "reflection.h"
+#include "saxHandler.h"
+#include "schema.h"
 
 namespace cjson {
 
+	class Column;
 	class Json;
+	class NodePool;
+	template<class Options_> class BasicParseContext;
 
-	///\ class Parser
+	///\ class BasicParser
 	///\ brief Parse strings of characters into Json objects
-	class Parser {
+	/// Options_ is the policy that decides which extensions to RFC 8259 are accepted, see StrictParsing.
+	template<class Options_>
+	class BasicParser {
 	public:
 		///\param _s The parser will read from this stream every time it is requested to parse a Json
-		/// It must provide valid, well formed, serialized Jsons.
-		Parser(std::istream& _s);
-		///\param _s The parser will read from this stream every time it is requested to parse a Json
-		/// It must provide valid, well formed, serialized Jsons.
-		Parser(const char* _s);
-		~Parser();
+		/// It must provide valid, well formed, serialized Jsons. Input the parser reads ahead is given back when it is
+		/// destroyed, so another parser can go on with the next document, even on a stream that can't seek.
+		BasicParser(std::istream& _s);
+		///\param _s The parser will read from this string every time it is requested to parse a Json
+		/// It is copied, so it doesn't need to outlive the parser.
+		BasicParser(const char* _s);
+		/// Read straight from the caller's memory, without copying it. The data must outlive the parser.
+		BasicParser(const char* _data, size_t _size);
+		~BasicParser();
 		/// Fill in the Json with content from the parser's stream.
 		///\ param _dst a Json object into which parse results will be stored
-		///\ return \c true if able to retrieve content from the current stream and parse from it, \c false on error
+		///\ return \c true if able to retrieve content from the current stream and parse from it, \c false on error.
+		/// On error, details are available through error().
 		bool parse(Json& _dst);
+		/// Parse a document that is expected to follow the given schema. Keys are compared against the one the schema
+		/// predicts before falling back to a generic read, and integers are converted directly. Input that doesn't
+		/// follow the schema is parsed just like parse(Json&) would.
+		bool parse(Json& _dst, const Schema& _schema);
+		/// Report the elements of the next document to a handler as they are found, without building a Json.
+		/// The events of a document that turns out to be malformed are reported up to the error.
+		bool parse(SaxHandler& _handler);
+		/// Fill in a C++ value straight from the input, without building any Json nodes on the way.
+		/// Supports the types CJSON_REFLECT does: reflected structs, std::vector, std::string, numbers, bool and Json.
+		/// Fields missing from the input keep their previous value, and keys that don't match any field are skipped.
+		/// Values of the wrong type fail with ParseErrorCode::typeMismatch.
+		template<class T_>
+		bool read(T_& _dst);
+		/// Read an array of records into columns, one row per record, without building any Json nodes. Each column
+		/// takes the member at its path, and the rest of the input is skipped without being stored. Rows are appended,
+		/// so several documents can be read into the same columns. Null records give rows of nulls.
+		/// Values of the wrong type fail with ParseErrorCode::typeMismatch, and the rows of the failed document are
+		/// removed.
+		bool readColumns(std::vector<Column>& _columns);
 
 		/// Replace the internal stream used to parse Jsons from.
 		///\param _new The new stream to read from.
@@ -54,28 +91,145 @@ namespace cjson {
 		std::istream& setStream(std::istream& _new);
 		std::istream& getStream() const;
 
+		/// Enable validation of UTF-8 in strings and keys. Disabled by default.
+		/// Validation happens while each string is scanned, so it doesn't take a separate pass over the input.
+		void setUtf8Validation(bool _enable);
+		/// Maximum nesting of arrays and objects. Deeper input fails with ParseErrorCode::depthLimitExceeded.
+		void setMaxDepth(size_t _maxDepth);
+		static const size_t cDefaultMaxDepth = 1024;
+		/// Store arrays of numbers or booleans of a single type packed, see Json::isPacked(). Enabled by default.
+		void setArrayPacking(bool _enable);
+
+		/// Description of the last parse error. Its code is ParseErrorCode::none if the last parse succeeded.
+		const ParseError& error() const;
+		/// Where the time of the last call went. All zero unless the library is built with CJSON_PROFILING.
+		const ProfileCounters& profile() const;
+
 	private:
+		bool parseElement(Json& _dst, const Schema* _schema = nullptr);
+		bool matchKey(const std::string& _key); ///< Consume the given key and the colon after it, if they come next
+		bool parseSmallInt(Json& _dst); ///< Convert integers of up to 9 digits in place. \c false if not possible.
+		bool parsePackedNumber(Json& _array); ///< Add the next number to an array that is being packed
+		bool parsePackedBoolean(Json& _array); ///< Add the next boolean to an array that is being packed
 		bool parseNull(Json& _dst);
 		bool parseFalse(Json& _dst);
 		bool parseTrue(Json& _dst);
 		bool parseNumber(Json& _dst);
 		bool parseString(Json& _dst);
-		bool parseArray(Json& _dst);
-		bool parseObject(Json& _dst);
+		bool readString(std::string& _dst);
+		bool parseEscape(std::string& _dst);
+		bool readHex4(unsigned& _value);
 		bool parseInt(const std::string& _num, Json& _dst);
 		bool parseFloat(const std::string& _num, Json& _dst);
-		bool parseObjectEntry(std::string& _key, Json& _value);
+		bool readKey(std::string& _key); ///< Read an object key and the colon after it
+		bool readNumberText(std::string& _num, bool& _isReal); ///< Characters of a number, without the f suffix
+		bool readNonFinite(std::string& _num); ///< NaN or Infinity, written the way strtod reads them
+		bool startsNonFinite(int _c) const { return Options_::nonFinite && (_c == 'N' || _c == 'I'); }
+		/// Consume the comma between two elements of a container, if there is one. Fails if it is missing or comes
+		/// right before the closing bracket, unless the policy accepts it.
+		bool readSeparator(char _close, bool _first);
+
+		// Direct reading into C++ values
+		struct FieldReader;
+		bool readValue(bool& _dst);
+		bool readValue(int& _dst);
+		bool readValue(unsigned& _dst);
+		bool readValue(float& _dst);
+		bool readValue(double& _dst);
+		bool readValue(std::string& _dst);
+		bool readValue(Json& _dst);
+		bool readValue(std::vector<bool>& _dst);
+		bool readInteger(long long& _dst);
+		bool beginNumber(); ///< Check that a number comes next, and remember where it starts
+		template<class T_>
+		bool readValue(std::vector<T_>& _dst);
+		template<class T_>
+		typename std::enable_if<IsReflected<T_>::value, bool>::type readValue(T_& _dst);
+		bool readLiteral(const char* _literal);
+		bool beginContainer(char _open); ///< Consume the opening bracket of an array or object
+		/// Move to the next element of an array or object, or consume the closing bracket if there are no more.
+		bool nextElement(char _close, bool _first, bool& _more);
+		bool skipValue();
+
+		// Reading into columns
+		struct ColumnNode;
+		bool readRecord(const std::vector<ColumnNode>& _nodes, size_t _node, std::vector<Column>& _columns);
+		bool readCell(Column& _column);
 
 		void skipWhiteSpace();
+		bool endDocument(); ///< Fail on anything but white space after the top-level value, unless it is accepted
+		bool skipComment(); ///< Skip the comment at the cursor. \c false if the slash doesn't start one.
 
-		std::istream* mIn;
-		bool mOwnStream; ///< Wether we have strong ownership of the input stream.
+		// Reuse by a ParseContext
+		template<class> friend class BasicParseContext;
+		BasicParser(); ///< No input
+		void setInput(const char* _data, size_t _size);
+		void setInput(std::istream& _in);
+		Json* newNode(); ///< Taken from the node pool, if there is one
 
-	private:
-		const std::string cSpacers = " \t\n\r";
-		const std::string cDigits = "0123456789";
+		// Buffered input
+		int		peek();
+		int		get();
+		void	skip();
+		bool	refill();
+		void	returnUnreadInput();
+		size_t	offset() const; ///< Offset in the input of the next character to consume
+		size_t	offsetOf(const char* _p) const; ///< Offset in the input of a character in the current buffer
+
+		bool fail(ParseErrorCode _code, size_t _offset); ///< Record a parse error. Always returns \c false.
+		bool failUnexpected(); ///< Fail on the character at the cursor, or on the end of the input.
+		void locateError(); ///< Fill in line, column and context of the current error
+
+		std::istream* mIn; ///< Null when reading from memory
+		std::string mInput; ///< Copy of the input, when constructed from a string
+
+		// The stream is read in large blocks and scanned directly from memory
+		std::vector<char>	mBuffer;
+		const char*			mBegin; ///< Start of the data read in the last block
+		const char*			mCursor; ///< Next character to consume
+		const char*			mEnd; ///< End of the data read in the last block
+		size_t				mBlockOffset; ///< Offset in the input of the first byte in the current block
+		std::streampos		mStreamStart; ///< Position in the stream of the first byte read, used to locate errors
+
+		bool		mValidateUtf8;
+		size_t		mMaxDepth;
+		ParseError	mError;
+
+		std::vector<Json*>	mStack; ///< Containers currently open, innermost last
+		/// When parsing with a schema, the schema of each open container and the index of its next expected key
+		struct SchemaFrame {
+			const Schema*	schema;
+			size_t			nextKey;
+		};
+		std::vector<SchemaFrame> mSchemaStack;
+		std::vector<char>	mOpenEvents; ///< Closing character of each container open while reporting events
+		std::string			mText; ///< Last string read
+		std::string			mKey; ///< Last object key read
+		std::string			mNumberText; ///< Last number read
+		size_t				mNumberStart; ///< Offset of the last number read into a C++ value
+		size_t				mReadDepth; ///< Containers currently open while reading C++ values
+		NodePool*			mPool; ///< Where parsed nodes come from. Null to allocate them one by one.
+		bool				mPackArrays;
+#ifdef CJSON_PROFILING
+		size_t				profilePosition() const; ///< Offset in the input, out of line for read()
+		ProfileCounters		mProfile;
+#endif
 	};
 
+	/// Accepts what cjson has always accepted. See DefaultParsing.
+	typedef BasicParser<DefaultParsing> Parser;
+	/// Only accepts standard json, for input that can't be trusted. See StrictParsing.
+	typedef BasicParser<StrictParsing> StrictParser;
+	/// Accepts every extension, for hand written files. See LenientParsing.
+	typedef BasicParser<LenientParsing> LenientParser;
+
+	// Built with the library
+	extern template class BasicParser<StrictParsing>;
+	extern template class BasicParser<DefaultParsing>;
+	extern template class BasicParser<LenientParsing>;
+
 }	// namespace cjson
 
+#include "parser.inl"
+
 #endif // _CJSON_PARSER_H_
\ No newline at end of file
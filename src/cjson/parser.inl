@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_PARSER_INL_
+#define _CJSON_PARSER_INL_
+
+#include "parser.h" // This will actually be ignored due to guards, but works for intellisense.
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	/// Reads each visited field straight from the parser's input
+	template<class Options_>
+	struct BasicParser<Options_>::FieldReader {
+		BasicParser& parser;
+
+		template<class T_>
+		bool operator()(T_& _field) const {
+			return parser.readValue(_field);
+		}
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	template<class T_>
+	bool BasicParser<Options_>::read(T_& _dst) {
+		CJSON_PROFILE_CALL(mProfile, "read", [this]{ return profilePosition(); });
+		mError = ParseError();
+		mReadDepth = 0;
+		return readValue(_dst) && endDocument();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	template<class T_>
+	bool BasicParser<Options_>::readValue(std::vector<T_>& _dst) {
+		_dst.clear();
+		if(!beginContainer('['))
+			return false;
+		bool more;
+		for(bool first = true; ; first = false) {
+			if(!nextElement(']', first, more))
+				return false;
+			if(!more)
+				return true;
+			_dst.emplace_back();
+			if(!readValue(_dst.back()))
+				return false;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Options_>
+	template<class T_>
+	typename std::enable_if<IsReflected<T_>::value, bool>::type BasicParser<Options_>::readValue(T_& _dst) {
+		if(!beginContainer('{'))
+			return false;
+		const KeyTable& keys = Reflection<T_>::keys();
+		FieldReader reader = { *this };
+		bool more;
+		for(bool first = true; ; first = false) {
+			if(!nextElement('}', first, more))
+				return false;
+			if(!more)
+				return true;
+			if(!readKey(mKey))
+				return false;
+			int field = keys.find(mKey.data(), mKey.size());
+			if(field < 0) {
+				if(!skipValue())
+					return false;
+			}
+			else if(!Reflection<T_>::visitField(_dst, size_t(field), reader))
+				return false;
+		}
+	}
+
+}	// namespace cjson
+
+#endif // _CJSON_PARSER_INL_
\ No newline at end of file
@@ -0,0 +1,500 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "json.h"
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cjson {
+
+	/// Applies the operations of a JSON Patch one by one, keeping what it takes to undo each of them
+	class Patcher {
+	public:
+		Patcher(Json& _root) : mRoot(_root) {}
+
+		bool apply(const Json& _operation);
+		void undo(); ///< Revert all the operations applied so far, latest first
+
+		/// JSON pointer to an element of _path. Escapes ~ and / in _token.
+		static std::string appendToken(const std::string& _path, const std::string& _token);
+
+	private:
+		typedef std::vector<std::string> Pointer;
+
+		/// How to revert an operation. The value added at path is removed, then the old value is put back at path if
+		/// there was one, then, for moves, the removed value goes back to from.
+		struct Undo {
+			Pointer	path;
+			Pointer	from;
+			Json	old;
+			bool	added = true;
+			bool	hadOld = false;
+			bool	isMove = false;
+		};
+
+		static bool	parsePointer(const Json& _text, Pointer& _pointer);
+		static bool	arrayIndex(const std::string& _token, size_t _size, size_t& _index);
+		/// Equality for "test". Unlike Json::operator==, numbers are compared by value, so 1 and 1.0 are equal.
+		static bool	sameValue(const Json& _a, const Json& _b);
+		const Json*	find(const Pointer& _path) const;
+		Json*		parentOf(const Pointer& _path); ///< Container holding the element at _path
+		/// Adds or replaces the value at _path. For arrays, the last token is changed into the actual index.
+		bool		insert(Pointer& _path, Json&& _value, Json& _replaced, bool& _hadOld);
+		bool		erase(const Pointer& _path, Json& _removed);
+
+		Json&				mRoot;
+		std::vector<Undo>	mUndo;
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Json::applyPatch(const Json& _patch) {
+		if(!_patch.isArray())
+			return false;
+		Patcher patcher(*this);
+		for(const Json& operation : _patch) {
+			if(!patcher.apply(operation)) {
+				patcher.undo();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Nested patches are applied with a work list, so their depth doesn't matter
+	void Json::mergePatch(const Json& _patch) {
+		std::vector<std::pair<Json*, const Json*>> pending(1, std::make_pair(this, &_patch));
+		while(!pending.empty()) {
+			Json& target = *pending.back().first;
+			const Json& patch = *pending.back().second;
+			pending.pop_back();
+			if(!patch.isObject()) {
+				target = patch;
+				continue;
+			}
+			if(!target.isObject())
+				target.makeContainer(DataType::object);
+			if(patch.object().empty())
+				continue;
+			Dictionary& members = target.mutableObject();
+			for(const auto& element : patch.object()) {
+				if(element.second->isNull()) {
+					auto member = members.find(element.first);
+					if(member != members.end()) {
+						freeNode(member->second);
+						members.erase(member);
+					}
+					continue;
+				}
+				Json*& member = members[element.first];
+				if(!member)
+					member = new Json();
+				pending.push_back(std::make_pair(member, element.second));
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json Json::diff(const Json& _target) const {
+		Json patch;
+		patch.makeContainer(DataType::array);
+		diff(_target, [&patch](const Json& _operation) {
+			patch.mContainer->array.push_back(new Json(_operation));
+		});
+		return patch;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Pairs of values to compare go to a work list, so the depth of the documents doesn't matter. Operations at one
+	// level never move the elements compared at the levels below it, so the order in which pairs are visited is free.
+	void Json::diff(const Json& _target, const std::function<void(const Json& _operation)>& _change) const {
+		struct Pair {
+			const Json* from;
+			const Json* to;
+			std::string path;
+		};
+		auto change = [&_change](const char* _op, const std::string& _path, const Json* _value) {
+			Json operation;
+			operation["op"] = _op;
+			operation["path"] = _path;
+			if(_value)
+				operation["value"] = *_value; // Shares the content
+			_change(operation);
+		};
+		std::vector<Pair> pending(1, Pair{ this, &_target, std::string() });
+		while(!pending.empty()) {
+			Pair pair = std::move(pending.back());
+			pending.pop_back();
+			const Json& from = *pair.from;
+			const Json& to = *pair.to;
+			if(from.mType != to.mType || !(from.isArray() || from.isObject())) {
+				if(!(from == to))
+					change("replace", pair.path, &to);
+				continue;
+			}
+			if(from.mContainer == to.mContainer)
+				continue; // Shared content
+			if(from.isObject()) { // Merged walk over both sorted sets of keys
+				auto a = from.object().begin(), aEnd = from.object().end();
+				auto b = to.object().begin(), bEnd = to.object().end();
+				while(a != aEnd || b != bEnd) {
+					if(b == bEnd || (a != aEnd && a->first < b->first)) {
+						change("remove", Patcher::appendToken(pair.path, a->first), nullptr);
+						++a;
+					}
+					else if(a == aEnd || b->first < a->first) {
+						change("add", Patcher::appendToken(pair.path, b->first), b->second);
+						++b;
+					}
+					else {
+						pending.push_back(Pair{ a->second, b->second, Patcher::appendToken(pair.path, a->first) });
+						++a;
+						++b;
+					}
+				}
+				continue;
+			}
+			const Array& a = from.array();
+			const Array& b = to.array();
+			size_t prefix = 0;
+			while(prefix < a.size() && prefix < b.size() && *a[prefix] == *b[prefix])
+				++prefix;
+			size_t suffix = 0;
+			while(suffix < a.size() - prefix && suffix < b.size() - prefix
+				&& *a[a.size() - 1 - suffix] == *b[b.size() - 1 - suffix])
+				++suffix;
+			size_t fromCount = a.size() - prefix - suffix;
+			size_t toCount = b.size() - prefix - suffix;
+			size_t paired = std::min(fromCount, toCount);
+			for(size_t i = prefix; i < prefix + paired; ++i)
+				pending.push_back(Pair{ a[i], b[i], Patcher::appendToken(pair.path, std::to_string(i)) });
+			std::string next = Patcher::appendToken(pair.path, std::to_string(prefix + paired));
+			for(size_t i = paired; i < fromCount; ++i)
+				change("remove", next, nullptr);
+			for(size_t i = paired; i < toCount; ++i)
+				change("add", Patcher::appendToken(pair.path, std::to_string(prefix + i)), b[prefix + i]);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Patcher::apply(const Json& _operation) {
+		if(!_operation.isObject() || !_operation.contains("op") || !_operation.contains("path"))
+			return false;
+		const Json& op = _operation["op"];
+		Pointer path;
+		if(!op.isString() || !parsePointer(_operation["path"], path))
+			return false;
+		const std::string name = op.mText.str();
+		bool needsValue = name == "add" || name == "replace" || name == "test";
+		bool needsFrom = name == "move" || name == "copy";
+		if(!needsValue && !needsFrom && name != "remove")
+			return false;
+		if(needsValue && !_operation.contains("value"))
+			return false;
+		Pointer from;
+		if(needsFrom && !(_operation.contains("from") && parsePointer(_operation["from"], from)))
+			return false;
+
+		if(name == "test") {
+			const Json* target = find(path);
+			return target && sameValue(*target, _operation["value"]);
+		}
+		Undo undo;
+		if(name == "remove") {
+			if(!erase(path, undo.old))
+				return false;
+			undo.path = std::move(path); // Reverted by adding the old value back
+			undo.added = false;
+			undo.hadOld = true;
+			mUndo.push_back(std::move(undo));
+			return true;
+		}
+		if(name == "replace") {
+			if(!find(path))
+				return false;
+			Json removed;
+			erase(path, removed);
+			Json unused;
+			bool replaced;
+			insert(path, Json(_operation["value"]), unused, replaced);
+			undo.path = std::move(path);
+			undo.old = std::move(removed);
+			undo.hadOld = true;
+			mUndo.push_back(std::move(undo));
+			return true;
+		}
+		Json value;
+		if(name == "move") {
+			if(from == path)
+				return true;
+			if(from.size() < path.size() && std::equal(from.begin(), from.end(), path.begin()))
+				return false; // Can't move a value into one of its own descendants
+			if(!erase(from, value))
+				return false;
+			undo.isMove = true;
+			undo.from = from;
+		}
+		else if(name == "copy") {
+			const Json* source = find(from);
+			if(!source)
+				return false;
+			value = *source; // Shares the content, if any
+		}
+		else
+			value = _operation["value"];
+		if(!insert(path, std::move(value), undo.old, undo.hadOld)) {
+			if(undo.isMove) { // Put the value back where it was
+				Json unused;
+				bool replaced;
+				insert(from, std::move(value), unused, replaced);
+			}
+			return false;
+		}
+		undo.path = std::move(path);
+		mUndo.push_back(std::move(undo));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Patcher::undo() {
+		while(!mUndo.empty()) {
+			Undo& undo = mUndo.back();
+			Json value, unused;
+			bool replaced;
+			if(undo.added)
+				erase(undo.path, value);
+			if(undo.hadOld)
+				insert(undo.path, std::move(undo.old), unused, replaced);
+			if(undo.isMove)
+				insert(undo.from, std::move(value), unused, replaced);
+			mUndo.pop_back();
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Patcher::parsePointer(const Json& _text, Pointer& _pointer) {
+		if(!_text.isString())
+			return false;
+		const std::string text = _text.mText.str();
+		if(!text.empty() && text[0] != '/')
+			return false;
+		for(size_t i = 0; i < text.size(); ++i) {
+			char c = text[i];
+			if(c == '/')
+				_pointer.emplace_back();
+			else if(c != '~')
+				_pointer.back() += c;
+			else if(i + 1 < text.size() && (text[i + 1] == '0' || text[i + 1] == '1'))
+				_pointer.back() += text[++i] == '0' ? '~' : '/';
+			else
+				return false;
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	std::string Patcher::appendToken(const std::string& _path, const std::string& _token) {
+		std::string path = _path;
+		path += '/';
+		for(char c : _token) {
+			if(c == '~')
+				path += "~0";
+			else if(c == '/')
+				path += "~1";
+			else
+				path += c;
+		}
+		return path;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Decimal index below _size, without leading zeros
+	bool Patcher::arrayIndex(const std::string& _token, size_t _size, size_t& _index) {
+		if(_token.empty() || _token.size() > 19 || (_token[0] == '0' && _token.size() > 1))
+			return false;
+		_index = 0;
+		for(char c : _token) {
+			if(c < '0' || c > '9')
+				return false;
+			_index = _index * 10 + size_t(c - '0');
+		}
+		return _index < _size;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Patcher::sameValue(const Json& _a, const Json& _b) {
+		if(_a.isNumber() && _b.isNumber()) {
+			double a = _a.mType == Json::DataType::integer ? double(_a.mNumber.i) : double(_a.mNumber.f);
+			double b = _b.mType == Json::DataType::integer ? double(_b.mNumber.i) : double(_b.mNumber.f);
+			return a == b;
+		}
+		if(_a.mType != _b.mType)
+			return false;
+		if(_a.isArray()) {
+			if(_a.mContainer == _b.mContainer)
+				return true;
+			const Json::Array& a = _a.array();
+			const Json::Array& b = _b.array();
+			if(a.size() != b.size())
+				return false;
+			for(size_t i = 0; i < a.size(); ++i) {
+				if(!sameValue(*a[i], *b[i]))
+					return false;
+			}
+			return true;
+		}
+		if(_a.isObject()) {
+			if(_a.mContainer == _b.mContainer)
+				return true;
+			if(_a.object().size() != _b.object().size())
+				return false;
+			// Both dictionaries are sorted, so they can be walked together
+			auto other = _b.object().begin();
+			for(const auto& element : _a.object()) {
+				if(element.first != other->first || !sameValue(*element.second, *other->second))
+					return false;
+				++other;
+			}
+			return true;
+		}
+		return _a == _b;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const Json* Patcher::find(const Pointer& _path) const {
+		const Json* node = &mRoot;
+		for(const std::string& token : _path) {
+			if(node->isObject()) {
+				auto element = node->object().find(token);
+				if(element == node->object().end())
+					return nullptr;
+				node = element->second;
+			}
+			else if(node->isArray()) {
+				size_t index;
+				if(!arrayIndex(token, node->array().size(), index))
+					return nullptr;
+				node = node->array()[index];
+			}
+			else
+				return nullptr;
+		}
+		return node;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// The path is only held while the operation runs, so the containers on it can be detached without making them
+	// unshareable
+	Json* Patcher::parentOf(const Pointer& _path) {
+		assert(!_path.empty());
+		Json* node = &mRoot;
+		for(size_t i = 0; i + 1 < _path.size(); ++i) {
+			const std::string& token = _path[i];
+			if(node->isObject()) {
+				if(!node->contains(token))
+					return nullptr;
+				node = node->mutableObject()[token];
+			}
+			else if(node->isArray()) {
+				size_t index;
+				if(!arrayIndex(token, node->array().size(), index))
+					return nullptr;
+				node = node->mutableArray()[index];
+			}
+			else
+				return nullptr;
+		}
+		return (node->isObject() || node->isArray()) ? node : nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Patcher::insert(Pointer& _path, Json&& _value, Json& _replaced, bool& _hadOld) {
+		_hadOld = false;
+		if(_path.empty()) { // Replace the whole document
+			_replaced = std::move(mRoot);
+			mRoot = std::move(_value);
+			_hadOld = true;
+			return true;
+		}
+		Json* parent = parentOf(_path);
+		if(!parent)
+			return false;
+		std::string& token = _path.back();
+		if(parent->isObject()) {
+			Json*& member = parent->mutableObject()[token];
+			if(member) {
+				_replaced = std::move(*member);
+				_hadOld = true;
+				*member = std::move(_value);
+			}
+			else
+				member = new Json(std::move(_value));
+			return true;
+		}
+		size_t size = parent->array().size();
+		size_t index = size;
+		if(token != "-" && !arrayIndex(token, size + 1, index))
+			return false;
+		Json::Array& elements = parent->mutableArray();
+		elements.insert(elements.begin() + index, new Json(std::move(_value)));
+		token = std::to_string(index);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Patcher::erase(const Pointer& _path, Json& _removed) {
+		if(_path.empty()) {
+			_removed = std::move(mRoot);
+			mRoot.setNull();
+			return true;
+		}
+		Json* parent = parentOf(_path);
+		if(!parent)
+			return false;
+		const std::string& token = _path.back();
+		if(parent->isObject()) {
+			if(!parent->contains(token))
+				return false;
+			Json::Dictionary& members = parent->mutableObject();
+			auto member = members.find(token);
+			_removed = std::move(*member->second);
+			Json::freeNode(member->second);
+			members.erase(member);
+			return true;
+		}
+		size_t index;
+		if(!arrayIndex(token, parent->array().size(), index))
+			return false;
+		Json::Array& elements = parent->mutableArray();
+		_removed = std::move(*elements[index]);
+		Json::freeNode(elements[index]);
+		elements.erase(elements.begin() + index);
+		return true;
+	}
+
+}	// namespace cjson
\ No newline at end of file
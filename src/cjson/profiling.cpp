@@ -0,0 +1,115 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "profiling.h"
+#include <algorithm>
+#include <atomic>
+
+namespace cjson {
+
+	namespace {
+		std::atomic<TraceHook*> gTraceHook(nullptr);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	ProfileCounters::ProfileCounters() {
+		reset();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	uint64_t ProfileCounters::totalTicks() const {
+		uint64_t total = 0;
+		for(uint64_t phase : ticks)
+			total += phase;
+		return total;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void ProfileCounters::reset() {
+		calls = 0;
+		bytes = 0;
+		maxDepth = 0;
+		std::fill(ticks, ticks + cProfilePhases, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	ProfileCounters& ProfileCounters::operator+=(const ProfileCounters& _x) {
+		calls += _x.calls;
+		bytes += _x.bytes;
+		maxDepth = std::max(maxDepth, _x.maxDepth);
+		for(size_t i = 0; i < cProfilePhases; ++i)
+			ticks[i] += _x.ticks[i];
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void setTraceHook(TraceHook* _hook) {
+		gTraceHook.store(_hook, std::memory_order_release);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	ProfileCounters& threadProfile() {
+		static thread_local ProfileCounters counters;
+		return counters;
+	}
+
+#ifdef CJSON_PROFILING
+	thread_local ProfileCall* ProfileCall::sActive = nullptr;
+
+	//------------------------------------------------------------------------------------------------------------------
+	ProfileCall::ProfileCall(ProfileCounters& _counters, const char* _event, std::function<size_t()> _position)
+		: mCounters(_counters)
+		, mEvent(_event)
+		, mPosition(std::move(_position))
+		, mStart(0)
+		, mPhase(ProfilePhase::structure)
+		, mMark(0)
+		, mNested(sActive != nullptr)
+	{
+		if(mNested)
+			return;
+		mCounters.reset();
+		if(TraceHook* hook = gTraceHook.load(std::memory_order_acquire))
+			hook->begin(mEvent);
+		mStart = mPosition();
+		sActive = this;
+		mMark = ticks();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	ProfileCall::~ProfileCall() {
+		if(mNested)
+			return;
+		enter(ProfilePhase::structure);
+		sActive = nullptr;
+		mCounters.calls = 1;
+		mCounters.bytes = mPosition() - mStart;
+		threadProfile() += mCounters;
+		if(TraceHook* hook = gTraceHook.load(std::memory_order_acquire))
+			hook->end(mEvent, mCounters);
+	}
+#endif // CJSON_PROFILING
+
+}	// namespace cjson
\ No newline at end of file
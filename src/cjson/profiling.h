@@ -0,0 +1,184 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_PROFILING_H_
+#define _CJSON_PROFILING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef CJSON_PROFILING
+#include <functional>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CJSON_PROFILE_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#include <chrono>
+#endif
+#endif // CJSON_PROFILING
+
+namespace cjson {
+
+	/// Whether the library was built with the CJSON_PROFILING option. Without it, all the counters stay at zero and
+	/// no trace events are sent, and the instrumentation isn't even compiled.
+#ifdef CJSON_PROFILING
+	const bool cProfilingEnabled = true;
+#else
+	const bool cProfilingEnabled = false;
+#endif
+
+	/// Parts of parsing and serializing that time is attributed to. Time not spent in any of the others, like
+	/// opening and closing arrays and objects, goes to structure.
+	enum class ProfilePhase {
+		structure,
+		whitespace,
+		string, ///< Strings and keys
+		number,
+		literal, ///< null, true and false
+	};
+	const size_t cProfilePhases = 5;
+
+	/// \struct ProfileCounters
+	/// \brief Where the time of a parse or serialization went.
+	/// Time is measured in ticks of the CPU's timestamp counter where there is one, and in nanoseconds elsewhere.
+	/// Each tick is charged to the innermost phase running at the time.
+	struct ProfileCounters {
+		ProfileCounters();
+
+		size_t		calls; ///< Calls counted, 1 for a single call
+		size_t		bytes; ///< Read by the parser, or written by the serializer
+		size_t		maxDepth; ///< Deepest nesting of arrays and objects
+		uint64_t	ticks[cProfilePhases]; ///< Indexed by ProfilePhase
+
+		uint64_t	phaseTicks(ProfilePhase _phase) const { return ticks[size_t(_phase)]; }
+		uint64_t	totalTicks() const;
+		void		reset();
+		ProfileCounters& operator+=(const ProfileCounters& _x);
+	};
+
+	/// \class TraceHook
+	/// \brief Receives an event when each parse or serialization starts and ends, to forward to a tracing system.
+	/// Events are sent from the thread doing the work. Names are "parse", "read", "readColumns" and "serialize".
+	class TraceHook {
+	public:
+		virtual ~TraceHook() {}
+		virtual void begin(const char* _event) = 0;
+		virtual void end(const char* _event, const ProfileCounters& _counters) = 0;
+	};
+
+	/// Send events to _hook, or to nobody if it is null. The hook is shared by all threads, and must outlive any call
+	/// that may still be using it.
+	void				setTraceHook(TraceHook* _hook);
+	/// Aggregate of all the calls made from the current thread. Can be reset.
+	ProfileCounters&	threadProfile();
+
+#ifdef CJSON_PROFILING
+	/// \class ProfileCall
+	/// \brief Measures one call to a parser or a serializer, from construction to destruction.
+	/// Calls made while another one is being measured on the same thread are counted as part of it.
+	class ProfileCall {
+	public:
+		/// _position tells how far into the input or output the call is, to count the bytes it went through
+		ProfileCall(ProfileCounters& _counters, const char* _event, std::function<size_t()> _position);
+		~ProfileCall();
+
+		/// Move to another phase. \return the phase that was running.
+		ProfilePhase enter(ProfilePhase _phase) {
+			uint64_t now = ticks();
+			mCounters.ticks[size_t(mPhase)] += now - mMark;
+			mMark = now;
+			ProfilePhase previous = mPhase;
+			mPhase = _phase;
+			return previous;
+		}
+		void depth(size_t _depth) {
+			if(_depth > mCounters.maxDepth)
+				mCounters.maxDepth = _depth;
+		}
+
+		static ProfileCall* active() { return sActive; }
+		static uint64_t ticks() {
+#ifdef CJSON_PROFILE_RDTSC
+			return __rdtsc();
+#else
+			return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+		}
+
+	private:
+		ProfileCall(const ProfileCall&) = delete;
+		ProfileCall& operator=(const ProfileCall&) = delete;
+
+		ProfileCounters&		mCounters;
+		const char*				mEvent;
+		std::function<size_t()>	mPosition;
+		size_t					mStart;
+		ProfilePhase			mPhase;
+		uint64_t				mMark; ///< When the current phase was entered
+		bool					mNested;
+
+		static thread_local ProfileCall* sActive;
+	};
+
+	/// \class ProfileScope
+	/// \brief Charges the time until its destruction to a phase of the call being measured, if any.
+	class ProfileScope {
+	public:
+		explicit ProfileScope(ProfilePhase _phase) : mCall(ProfileCall::active()), mPrevious(ProfilePhase::structure) {
+			if(mCall)
+				mPrevious = mCall->enter(_phase);
+		}
+		~ProfileScope() {
+			if(mCall)
+				mCall->enter(mPrevious);
+		}
+
+	private:
+		ProfileCall*	mCall;
+		ProfilePhase	mPrevious;
+	};
+#endif // CJSON_PROFILING
+
+}	// namespace cjson
+
+// Instrumentation points. They compile to nothing unless CJSON_PROFILING is defined.
+#ifdef CJSON_PROFILING
+#define CJSON_PROFILE_CALL(_counters, _event, _position) \
+	::cjson::ProfileCall cjsonProfileCall(_counters, _event, _position)
+#define CJSON_PROFILE_SCOPE(_phase) ::cjson::ProfileScope cjsonProfileScope(::cjson::ProfilePhase::_phase)
+#define CJSON_PROFILE_DEPTH(_depth) \
+	do { if(::cjson::ProfileCall* call = ::cjson::ProfileCall::active()) call->depth(_depth); } while(0)
+#else
+#define CJSON_PROFILE_CALL(_counters, _event, _position)
+#define CJSON_PROFILE_SCOPE(_phase)
+#define CJSON_PROFILE_DEPTH(_depth)
+#endif
+
+#endif // _CJSON_PROFILING_H_
\ No newline at end of file
@@ -0,0 +1,766 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "query.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+
+namespace cjson {
+
+	namespace {
+		//--------------------------------------------------------------------------------------------------------------
+		void addState(std::vector<size_t>& _states, size_t _state) {
+			if(std::find(_states.begin(), _states.end(), _state) == _states.end())
+				_states.push_back(_state);
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		bool hasState(const std::vector<size_t>& _states, size_t _state) {
+			return std::find(_states.begin(), _states.end(), _state) != _states.end();
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		// Normalized index of a slice bound, clamped to the array
+		long long sliceBound(long long _bound, long long _length, long long _low) {
+			if(_bound < 0)
+				_bound += _length;
+			return std::min(std::max(_bound, _low), _low < 0 ? _length - 1 : _length);
+		}
+	}
+
+	const size_t Query::cUnknownLength;
+
+	//------------------------------------------------------------------------------------------------------------------
+	Query::Query() {
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::compile(const std::string& _expression) {
+		mSteps.clear();
+		mExprs.clear();
+		mCompileError.clear();
+		mText = _expression;
+		mPos = 0;
+		skipSpaces();
+		bool ok = mPos < mText.size() && mText[mPos] == '$';
+		if(!ok)
+			fail("expected '$'");
+		++mPos;
+		for(skipSpaces(); ok && mPos < mText.size(); skipSpaces())
+			ok = parseSegment();
+		std::string().swap(mText);
+		if(!ok) { // A step without selectors, so nothing matches
+			mSteps.assign(1, Step{ false, false, std::vector<Selector>() });
+			mExprs.clear();
+		}
+		return ok;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const std::string& Query::compileError() const {
+		return mCompileError;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	std::vector<const Json*> Query::select(const Json& _document) const {
+		std::vector<const Json*> matches;
+		select(_document, [&matches](const Json& _match) { matches.push_back(&_match); });
+		return matches;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Query::select(const Json& _document, const std::function<void(const Json&)>& _match) const {
+		walk(_document, States(1, 0), _match);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::fail(const char* _problem) {
+		if(mCompileError.empty())
+			mCompileError = "offset " + std::to_string(mPos) + ": " + _problem;
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Query::skipSpaces() {
+		while(mPos < mText.size() && std::isspace((unsigned char)mText[mPos]))
+			++mPos;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::parseSegment() {
+		Step step = { false, false, std::vector<Selector>() };
+		Selector selector = { Selector::Kind::wildcard, std::string(), 0, 0, 1, false, false, 0 };
+		bool dot = mText[mPos] == '.';
+		if(dot) {
+			++mPos;
+			if(mPos < mText.size() && mText[mPos] == '.') {
+				step.recursive = true;
+				++mPos;
+			}
+		}
+		if(mPos < mText.size() && mText[mPos] == '[') {
+			if(dot && !step.recursive)
+				return fail("unexpected '['");
+			if(!parseBracket(step))
+				return false;
+		}
+		else if(!dot)
+			return fail("expected '.' or '['");
+		else if(mPos < mText.size() && mText[mPos] == '*') {
+			++mPos;
+			step.selectors.push_back(selector);
+		}
+		else {
+			selector.kind = Selector::Kind::name;
+			if(!parseName(selector.name))
+				return false;
+			step.selectors.push_back(selector);
+		}
+		for(const Selector& s : step.selectors) {
+			if(s.kind == Selector::Kind::index)
+				step.needsLength |= s.start < 0;
+			else if(s.kind == Selector::Kind::slice)
+				step.needsLength |= (s.hasStart && s.start < 0) || (s.hasEnd && s.end < 0) || s.step < 0;
+		}
+		mSteps.push_back(std::move(step));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::parseBracket(Step& _step) {
+		++mPos; // [
+		for(;;) {
+			Selector selector;
+			if(!parseSelector(selector))
+				return false;
+			_step.selectors.push_back(std::move(selector));
+			skipSpaces();
+			if(mPos >= mText.size())
+				return fail("expected ']'");
+			char c = mText[mPos++];
+			if(c == ']')
+				return true;
+			if(c != ',')
+				return --mPos, fail("expected ',' or ']'");
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::parseSelector(Selector& _selector) {
+		_selector = Selector{ Selector::Kind::wildcard, std::string(), 0, 0, 1, false, false, 0 };
+		skipSpaces();
+		if(mPos >= mText.size())
+			return fail("expected a selector");
+		char c = mText[mPos];
+		if(c == '*') {
+			++mPos;
+			return true;
+		}
+		if(c == '?') {
+			++mPos;
+			_selector.kind = Selector::Kind::filter;
+			return parseExpression(_selector.filter, 0);
+		}
+		if(c == '\'' || c == '"') {
+			_selector.kind = Selector::Kind::name;
+			return parseQuoted(_selector.name);
+		}
+		_selector.kind = Selector::Kind::index;
+		auto isNumber = [this]() {
+			return mPos < mText.size() && (mText[mPos] == '-' || std::isdigit((unsigned char)mText[mPos]));
+		};
+		if(isNumber()) {
+			if(!parseInteger(_selector.start))
+				return false;
+			_selector.hasStart = true;
+			skipSpaces();
+		}
+		if(mPos >= mText.size() || mText[mPos] != ':')
+			return _selector.hasStart || fail("expected a selector");
+		_selector.kind = Selector::Kind::slice;
+		++mPos;
+		skipSpaces();
+		if(isNumber()) {
+			if(!parseInteger(_selector.end))
+				return false;
+			_selector.hasEnd = true;
+			skipSpaces();
+		}
+		if(mPos < mText.size() && mText[mPos] == ':') {
+			++mPos;
+			skipSpaces();
+			if(isNumber() && !parseInteger(_selector.step))
+				return false;
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::parseName(std::string& _name) {
+		size_t start = mPos;
+		while(mPos < mText.size()) {
+			unsigned char c = mText[mPos];
+			if(!std::isalnum(c) && c != '_' && c != '$' && c != '-' && c < 0x80)
+				break;
+			++mPos;
+		}
+		if(mPos == start)
+			return fail("expected a name");
+		_name.assign(mText, start, mPos - start);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Single or double quoted. Backslash escapes the next character.
+	bool Query::parseQuoted(std::string& _text) {
+		char quote = mText[mPos++];
+		while(mPos < mText.size() && mText[mPos] != quote) {
+			if(mText[mPos] == '\\')
+				++mPos;
+			if(mPos < mText.size())
+				_text += mText[mPos++];
+		}
+		if(mPos >= mText.size())
+			return fail("unterminated string");
+		++mPos;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::parseInteger(long long& _value) {
+		const char* start = mText.c_str() + mPos;
+		char* end;
+		_value = std::strtoll(start, &end, 10);
+		if(end == start || (*start == '-' && end == start + 1))
+			return fail("expected an integer");
+		mPos += end - start;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Precedence 0 is ||, 1 is &&, 2 is a single test
+	bool Query::parseExpression(size_t& _expr, int _precedence) {
+		skipSpaces();
+		if(_precedence < 2) {
+			if(!parseExpression(_expr, _precedence + 1))
+				return false;
+			const char* op = _precedence ? "&&" : "||";
+			for(skipSpaces(); mText.compare(mPos, 2, op) == 0; skipSpaces()) {
+				mPos += 2;
+				size_t right;
+				if(!parseExpression(right, _precedence + 1))
+					return false;
+				ExprOp op = _precedence ? ExprOp::andOp : ExprOp::orOp;
+				mExprs.push_back(Expr{ op, _expr, right, Operand(), Operand() });
+				_expr = mExprs.size() - 1;
+			}
+			return true;
+		}
+		if(mPos < mText.size() && mText[mPos] == '!') {
+			++mPos;
+			size_t operand;
+			if(!parseExpression(operand, 2))
+				return false;
+			mExprs.push_back(Expr{ ExprOp::notOp, operand, 0, Operand(), Operand() });
+			_expr = mExprs.size() - 1;
+			return true;
+		}
+		if(mPos < mText.size() && mText[mPos] == '(') {
+			++mPos;
+			if(!parseExpression(_expr, 0))
+				return false;
+			skipSpaces();
+			if(mPos >= mText.size() || mText[mPos] != ')')
+				return fail("expected ')'");
+			++mPos;
+			return true;
+		}
+		Expr expr = { ExprOp::exists, 0, 0, Operand(), Operand() };
+		if(!parseOperand(expr.a))
+			return false;
+		skipSpaces();
+		const std::pair<const char*, ExprOp> cComparisons[] = {
+			{ "==", ExprOp::equal },
+			{ "!=", ExprOp::notEqual },
+			{ "<=", ExprOp::lessEqual },
+			{ ">=", ExprOp::greaterEqual },
+			{ "<", ExprOp::less },
+			{ ">", ExprOp::greater },
+		};
+		for(const auto& comparison : cComparisons) {
+			size_t size = std::char_traits<char>::length(comparison.first);
+			if(mText.compare(mPos, size, comparison.first) == 0) {
+				mPos += size;
+				expr.op = comparison.second;
+				if(!parseOperand(expr.b))
+					return false;
+				break;
+			}
+		}
+		if(expr.op == ExprOp::exists && !expr.a.isPath)
+			return fail("expected a comparison");
+		mExprs.push_back(std::move(expr));
+		_expr = mExprs.size() - 1;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::parseOperand(Operand& _operand) {
+		skipSpaces();
+		_operand.isPath = false;
+		if(mPos >= mText.size())
+			return fail("expected a value");
+		char c = mText[mPos];
+		if(c == '@') {
+			_operand.isPath = true;
+			for(++mPos; mPos < mText.size(); ) {
+				PathToken token = { std::string(), 0, false };
+				if(mText[mPos] == '.') {
+					++mPos;
+					if(!parseName(token.name))
+						return false;
+				}
+				else if(mText[mPos] == '[') {
+					++mPos;
+					skipSpaces();
+					if(mPos < mText.size() && (mText[mPos] == '\'' || mText[mPos] == '"')) {
+						if(!parseQuoted(token.name))
+							return false;
+					}
+					else if(parseInteger(token.index))
+						token.isIndex = true;
+					else
+						return false;
+					skipSpaces();
+					if(mPos >= mText.size() || mText[mPos] != ']')
+						return fail("expected ']'");
+					++mPos;
+				}
+				else
+					break;
+				_operand.path.push_back(std::move(token));
+			}
+			return true;
+		}
+		if(c == '\'' || c == '"') {
+			std::string text;
+			if(!parseQuoted(text))
+				return false;
+			_operand.literal = std::move(text);
+			return true;
+		}
+		if(c == '-' || std::isdigit((unsigned char)c)) {
+			const char* start = mText.c_str() + mPos;
+			char* end;
+			double number = std::strtod(start, &end);
+			if(end == start)
+				return fail("expected a number");
+			std::string text(start, static_cast<const char*>(end));
+			if(text.find_first_of(".eE") == std::string::npos && number >= INT_MIN && number <= INT_MAX)
+				_operand.literal = int(number);
+			else
+				_operand.literal = float(number);
+			mPos += end - start;
+			return true;
+		}
+		const char* cKeywords[] = { "true", "false", "null" };
+		for(const char* keyword : cKeywords) {
+			size_t size = std::char_traits<char>::length(keyword);
+			if(mText.compare(mPos, size, keyword) == 0) {
+				mPos += size;
+				if(keyword[0] != 'n')
+					_operand.literal = keyword[0] == 't';
+				return true;
+			}
+		}
+		return fail("expected a value");
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Query::advance(const States& _states, const std::string* _key, size_t _index, size_t _length,
+		const Json* _child, States& _next, States* _deferred) const
+	{
+		_next.clear();
+		for(size_t state : _states) {
+			if(state >= mSteps.size())
+				continue; // Already matched
+			const Step& step = mSteps[state];
+			if(step.needsLength && _length == cUnknownLength)
+				continue;
+			if(step.recursive)
+				addState(_next, state);
+			bool matched = false;
+			bool deferred = false;
+			for(const Selector& selector : step.selectors) {
+				if(selector.kind == Selector::Kind::filter && !_child)
+					deferred = true;
+				else if(matches(selector, _key, _index, _length, _child)) {
+					matched = true;
+					break;
+				}
+			}
+			if(matched)
+				addState(_next, state + 1);
+			else if(deferred && _deferred)
+				addState(*_deferred, state);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::matches(const Selector& _selector, const std::string* _key, size_t _index, size_t _length,
+		const Json* _child) const
+	{
+		switch(_selector.kind) {
+		case Selector::Kind::name:
+			return _key && *_key == _selector.name;
+		case Selector::Kind::wildcard:
+			return true;
+		case Selector::Kind::filter:
+			return passes(_selector.filter, *_child);
+		case Selector::Kind::index:
+			if(_key)
+				return false;
+			return _selector.start < 0 ? _selector.start + (long long)_length == (long long)_index
+				: (long long)_index == _selector.start;
+		case Selector::Kind::slice:
+		{
+			if(_key || _selector.step == 0)
+				return false;
+			long long index = (long long)_index;
+			if(_selector.step > 0) {
+				long long lower = 0;
+				long long upper = LLONG_MAX;
+				if(_length != cUnknownLength) {
+					long long length = (long long)_length;
+					lower = _selector.hasStart ? sliceBound(_selector.start, length, 0) : 0;
+					upper = _selector.hasEnd ? sliceBound(_selector.end, length, 0) : length;
+				}
+				else { // Streaming. Bounds aren't negative.
+					lower = _selector.hasStart ? _selector.start : 0;
+					upper = _selector.hasEnd ? _selector.end : LLONG_MAX;
+				}
+				return index >= lower && index < upper && (index - lower) % _selector.step == 0;
+			}
+			long long length = (long long)_length;
+			long long upper = _selector.hasStart ? sliceBound(_selector.start, length, -1) : length - 1;
+			long long lower = _selector.hasEnd ? sliceBound(_selector.end, length, -1) : -1;
+			return index > lower && index <= upper && (upper - index) % -_selector.step == 0;
+		}
+		}
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::passes(size_t _filter, const Json& _element) const {
+		return test(_filter, _element);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Query::test(size_t _expr, const Json& _element) const {
+		const Expr& expr = mExprs[_expr];
+		switch(expr.op) {
+		case ExprOp::orOp:
+			return test(expr.left, _element) || test(expr.right, _element);
+		case ExprOp::andOp:
+			return test(expr.left, _element) && test(expr.right, _element);
+		case ExprOp::notOp:
+			return !test(expr.left, _element);
+		default:
+			break;
+		}
+		auto resolve = [&_element](const Operand& _operand) -> const Json* {
+			if(!_operand.isPath)
+				return &_operand.literal;
+			const Json* node = &_element;
+			for(const PathToken& token : _operand.path) {
+				if(token.isIndex) {
+					if(!node->isArray())
+						return nullptr;
+					long long index = token.index < 0 ? token.index + (long long)node->size() : token.index;
+					if(index < 0 || index >= (long long)node->size())
+						return nullptr;
+					node = &(*node)(size_t(index));
+				}
+				else {
+					if(!node->isObject() || !node->contains(token.name))
+						return nullptr;
+					node = &(*node)[token.name];
+				}
+			}
+			return node;
+		};
+		const Json* a = resolve(expr.a);
+		if(expr.op == ExprOp::exists)
+			return a != nullptr;
+		const Json* b = resolve(expr.b);
+
+		// Missing values are only equal to each other
+		bool equal;
+		int order = 0; // Sign of a - b, when it means anything
+		bool ordered = false;
+		if(!a || !b)
+			equal = !a && !b;
+		else if(a->isNumber() && b->isNumber()) {
+			auto number = [](const Json& _x) {
+				return _x.mType == Json::DataType::integer ? double(_x.mNumber.i) : double(_x.mNumber.f);
+			};
+			double x = number(*a);
+			double y = number(*b);
+			equal = x == y;
+			order = x < y ? -1 : (x > y ? 1 : 0);
+			ordered = equal || order != 0; // Not NaN
+		}
+		else if(a->isString() && b->isString()) {
+			order = a->mText.compare(b->mText);
+			equal = order == 0;
+			ordered = true;
+		}
+		else
+			equal = *a == *b;
+
+		switch(expr.op) {
+		case ExprOp::equal: return equal;
+		case ExprOp::notEqual: return !equal;
+		case ExprOp::less: return ordered && order < 0;
+		case ExprOp::lessEqual: return equal || (ordered && order < 0);
+		case ExprOp::greater: return ordered && order > 0;
+		case ExprOp::greaterEqual: return equal || (ordered && order > 0);
+		default: return false;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Depth first with an explicit stack, children pushed in reverse so they come out in document order
+	void Query::walk(const Json& _value, const States& _states, const std::function<void(const Json&)>& _match) const {
+		struct Item {
+			const Json*	value;
+			States		states;
+		};
+		std::vector<Item> pending(1, Item{ &_value, _states });
+		std::vector<Item> children;
+		States next;
+		while(!pending.empty()) {
+			Item item = std::move(pending.back());
+			pending.pop_back();
+			const Json& value = *item.value;
+			if(hasState(item.states, mSteps.size()))
+				_match(value);
+			bool goesOn = false;
+			for(size_t state : item.states)
+				goesOn |= state < mSteps.size();
+			if(!goesOn)
+				continue;
+			children.clear();
+			if(value.isArray()) {
+				size_t size = value.size();
+				for(size_t i = 0; i < size; ++i) {
+					const Json& child = value(i);
+					advance(item.states, nullptr, i, size, &child, next, nullptr);
+					if(!next.empty())
+						children.push_back(Item{ &child, next });
+				}
+			}
+			else if(value.isObject()) {
+				for(auto i = value.begin(); i != value.end(); ++i) {
+					advance(item.states, &i.key(), 0, value.size(), &*i, next, nullptr);
+					if(!next.empty())
+						children.push_back(Item{ &*i, next });
+				}
+			}
+			for(auto i = children.rbegin(); i != children.rend(); ++i)
+				pending.push_back(std::move(*i));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	QueryHandler::QueryHandler(const Query& _query, const std::function<void(const Json&)>& _match)
+		: mQuery(_query)
+		, mMatch(_match)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::null() {
+		forward([](SaxHandler& _h) { _h.null(); });
+		scalar(Json());
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::boolean(bool _b) {
+		forward([_b](SaxHandler& _h) { _h.boolean(_b); });
+		scalar(Json(_b));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::integer(int _i) {
+		forward([_i](SaxHandler& _h) { _h.integer(_i); });
+		scalar(Json(_i));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::real(float _f) {
+		forward([_f](SaxHandler& _h) { _h.real(_f); });
+		scalar(Json(_f));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::string(const std::string& _s) {
+		forward([&_s](SaxHandler& _h) { _h.string(_s); });
+		scalar(Json(_s));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::beginArray() {
+		begin(true);
+		forward([](SaxHandler& _h) { _h.beginArray(); });
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::endArray() {
+		forward([](SaxHandler& _h) { _h.endArray(); });
+		end();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::beginObject() {
+		begin(false);
+		forward([](SaxHandler& _h) { _h.beginObject(); });
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::key(const std::string& _key) {
+		mFrames.back().key = _key;
+		forward([&_key](SaxHandler& _h) { _h.key(_key); });
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool QueryHandler::endObject() {
+		forward([](SaxHandler& _h) { _h.endObject(); });
+		end();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void QueryHandler::enter(Query::States& _streaming, Query::States& _built, Query::States& _filters) {
+		if(mFrames.empty())
+			_streaming.assign(1, 0);
+		else {
+			const Frame& parent = mFrames.back();
+			if(parent.states.empty())
+				return;
+			mQuery.advance(parent.states, parent.isArray ? nullptr : &parent.key, parent.count,
+				Query::cUnknownLength, nullptr, _streaming, &_filters);
+		}
+		// Matches, and steps that count from the end of arrays, need the value built
+		size_t stepCount = mQuery.mSteps.size();
+		for(size_t i = 0; i < _streaming.size(); ) {
+			size_t state = _streaming[i];
+			if(state == stepCount || mQuery.mSteps[state].needsLength) {
+				addState(_built, state);
+				_streaming.erase(_streaming.begin() + i);
+			}
+			else
+				++i;
+		}
+		// Filters that would only lead to states the value already has
+		for(size_t i = 0; i < _filters.size(); ) {
+			size_t next = _filters[i] + 1;
+			if(hasState(_streaming, next) || hasState(_built, next))
+				_filters.erase(_filters.begin() + i);
+			else
+				++i;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void QueryHandler::finish(const Json& _value, Query::States& _built, const Query::States& _filters) {
+		for(size_t state : _filters) {
+			for(const Query::Selector& selector : mQuery.mSteps[state].selectors) {
+				if(selector.kind == Query::Selector::Kind::filter && mQuery.passes(selector.filter, _value)) {
+					addState(_built, state + 1);
+					break;
+				}
+			}
+		}
+		if(!_built.empty())
+			mQuery.walk(_value, _built, mMatch);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void QueryHandler::scalar(const Json& _value) {
+		Query::States streaming, built, filters;
+		enter(streaming, built, filters);
+		if(!built.empty() || !filters.empty())
+			finish(_value, built, filters);
+		if(!mFrames.empty())
+			++mFrames.back().count;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void QueryHandler::begin(bool _isArray) {
+		Frame frame = { Query::States(), _isArray, 0, std::string(), false };
+		Query::States built, filters;
+		enter(frame.states, built, filters);
+		if(!built.empty() || !filters.empty()) {
+			frame.captured = true;
+			mCaptures.emplace_back(new Capture);
+			mCaptures.back()->states = std::move(built);
+			mCaptures.back()->filters = std::move(filters);
+		}
+		mFrames.push_back(std::move(frame));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void QueryHandler::end() {
+		if(mFrames.back().captured) {
+			std::unique_ptr<Capture> capture = std::move(mCaptures.back());
+			mCaptures.pop_back();
+			finish(capture->value, capture->states, capture->filters);
+		}
+		mFrames.pop_back();
+		if(!mFrames.empty())
+			++mFrames.back().count;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Event_>
+	void QueryHandler::forward(Event_ _event) {
+		for(auto& capture : mCaptures)
+			_event(capture->builder);
+	}
+
+}	// namespace cjson
\ No newline at end of file
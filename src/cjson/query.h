@@ -0,0 +1,204 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_QUERY_H_
+#define _CJSON_QUERY_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "json.h"
+#include "saxHandler.h"
+
+namespace cjson {
+
+	/// \class Query
+	/// \brief Picks values out of documents with a JSONPath expression, e.g. "$.items[?(@.qty > 0)].price".
+	/// The expression is compiled once into a list of steps. Queries run over Json trees, or over parsing events
+	/// through QueryHandler so matching values can be taken from documents too big to build as a whole.
+	/// Supported syntax:
+	///  - $ for the root, followed by any number of segments
+	///  - .name or ['name'] for members, [3] or [-1] for elements, .* or [*] for all of them
+	///  - [start:end:step] slices, where any of the three can be omitted
+	///  - ['a','b'] or [0,2] unions of the above
+	///  - .. before any of the above (..name, ..*, ..[0]) for recursive descent
+	///  - [?(expression)] filters. Expressions compare relative paths, like @.qty or @['a b'][0], with each other or
+	///    with numbers, strings, true, false and null, using == != < <= > >=. A lone path tests that it exists.
+	///    Tests combine with &&, ||, ! and parentheses.
+	/// Matches come in document order, and each value at most once.
+	class Query {
+	public:
+		Query(); ///< Matches the root
+		/// \return \c false if the expression isn't valid. See compileError().
+		bool compile(const std::string& _expression);
+		const std::string& compileError() const;
+
+		/// Matching values, pointing into _document
+		std::vector<const Json*>	select(const Json& _document) const;
+		void						select(const Json& _document, const std::function<void(const Json&)>& _match) const;
+
+	private:
+		friend class QueryHandler;
+
+		/// Relative path inside filter expressions
+		struct PathToken {
+			std::string	name;
+			long long	index;
+			bool		isIndex;
+		};
+
+		enum class ExprOp { orOp, andOp, notOp, exists, equal, notEqual, less, lessEqual, greater, greaterEqual };
+
+		struct Operand {
+			std::vector<PathToken>	path;
+			Json					literal; ///< Used when path is empty
+			bool					isPath;
+		};
+
+		/// Node of a filter expression. Nodes refer to each other by index.
+		struct Expr {
+			ExprOp	op;
+			size_t	left; ///< For the logical operators
+			size_t	right;
+			Operand	a; ///< For exists and comparisons
+			Operand	b;
+		};
+
+		struct Selector {
+			enum class Kind { name, index, slice, wildcard, filter };
+
+			Kind		kind;
+			std::string	name;
+			long long	start; ///< Index, or start of the slice
+			long long	end;
+			long long	step;
+			bool		hasStart;
+			bool		hasEnd;
+			size_t		filter; ///< Root of the filter expression
+		};
+
+		struct Step {
+			bool					recursive; ///< Also applies to all descendants
+			bool					needsLength; ///< Counts from the end of arrays, so can't be matched while streaming
+			std::vector<Selector>	selectors;
+		};
+
+		typedef std::vector<size_t> States; ///< Steps matched so far, one entry per way of getting there
+
+		// Compilation
+		bool	fail(const char* _problem);
+		void	skipSpaces();
+		bool	parseSegment();
+		bool	parseBracket(Step& _step);
+		bool	parseSelector(Selector& _selector);
+		bool	parseName(std::string& _name);
+		bool	parseQuoted(std::string& _text);
+		bool	parseInteger(long long& _value);
+		bool	parseExpression(size_t& _expr, int _precedence);
+		bool	parseOperand(Operand& _operand);
+
+		// Evaluation
+		/// States of a child of a value in the given states. Filters are evaluated when _child is given, otherwise the
+		/// states they apply to are left in _deferred. Steps that need the length of arrays are skipped when _length
+		/// is unknown.
+		void	advance(const States& _states, const std::string* _key, size_t _index, size_t _length,
+					const Json* _child, States& _next, States* _deferred) const;
+		bool	matches(const Selector& _selector, const std::string* _key, size_t _index, size_t _length,
+					const Json* _child) const;
+		bool	passes(size_t _filter, const Json& _element) const;
+		bool	test(size_t _expr, const Json& _element) const;
+		void	walk(const Json& _value, const States& _states, const std::function<void(const Json&)>& _match) const;
+
+		static const size_t cUnknownLength = size_t(-1);
+
+		std::vector<Step>	mSteps;
+		std::vector<Expr>	mExprs;
+		std::string			mCompileError;
+		// Compilation state
+		std::string			mText;
+		size_t				mPos = 0;
+	};
+
+	/// \class QueryHandler
+	/// \brief Runs a query on parsing events, without building the document.
+	/// Matching values are built and handed out as soon as they end, so nested matches come before the ones containing
+	/// them. Elements tested by a filter are built one at a time to evaluate it, and arrays indexed from the end are
+	/// built as a whole.
+	class QueryHandler : public SaxHandler {
+	public:
+		QueryHandler(const Query& _query, const std::function<void(const Json&)>& _match);
+
+		bool null() override;
+		bool boolean(bool _b) override;
+		bool integer(int _i) override;
+		bool real(float _f) override;
+		bool string(const std::string& _s) override;
+		bool beginArray() override;
+		bool endArray() override;
+		bool beginObject() override;
+		bool key(const std::string& _key) override;
+		bool endObject() override;
+
+	private:
+		struct Frame {
+			Query::States	states; ///< Steps still being matched on the children
+			bool			isArray;
+			size_t			count;
+			std::string		key;
+			bool			captured; ///< The container is being built, see Capture
+		};
+
+		/// A value that is being built to finish the query on it
+		struct Capture {
+			Json			value;
+			JsonBuilder		builder;
+			Query::States	states; ///< To go on with once the value is built
+			Query::States	filters; ///< Steps whose filters are waiting for the value
+
+			Capture() : builder(value) {}
+		};
+
+		/// States of the next value. Those that can only go on once the value has been built are left in _built and
+		/// _filters.
+		void	enter(Query::States& _streaming, Query::States& _built, Query::States& _filters);
+		/// Go on with the query on a built value
+		void	finish(const Json& _value, Query::States& _built, const Query::States& _filters);
+		void	scalar(const Json& _value);
+		void	begin(bool _isArray);
+		void	end();
+		template<class Event_>
+		void	forward(Event_ _event);
+
+		const Query&							mQuery;
+		std::function<void(const Json&)>		mMatch;
+		std::vector<Frame>						mFrames;
+		std::vector<std::unique_ptr<Capture>>	mCaptures; ///< Innermost last
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_QUERY_H_
\ No newline at end of file
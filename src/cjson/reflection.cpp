@@ -0,0 +1,82 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "reflection.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	KeyTable::KeyTable(const char* const* _names, size_t _count)
+		: mNames(_names)
+		, mSeed(0)
+		, mMask(0)
+	{
+		mSizes.reserve(_count);
+		for(size_t i = 0; i < _count; ++i)
+			mSizes.push_back(strlen(_names[i]));
+		// Try seeds until all the names land in different slots. Grow the table if it takes too long.
+		uint32_t tableSize = 2;
+		while(tableSize < 2 * _count)
+			tableSize *= 2;
+		for(;;) {
+			mMask = tableSize - 1;
+			for(mSeed = 1; mSeed <= 256; ++mSeed) {
+				mSlots.assign(tableSize, -1);
+				bool collision = false;
+				for(size_t i = 0; i < _count && !collision; ++i) {
+					int& slot = mSlots[hash(_names[i], mSizes[i], mSeed) & mMask];
+					if(slot != -1 && mSizes[slot] == mSizes[i] && memcmp(_names[slot], _names[i], mSizes[i]) == 0)
+						throw std::invalid_argument(std::string("Repeated field name: ") + _names[i]);
+					collision = slot != -1;
+					slot = int(i);
+				}
+				if(!collision)
+					return;
+			}
+			tableSize *= 2; // Different names always end up in different slots of a big enough table
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	int KeyTable::find(const char* _key, size_t _size) const {
+		int index = mSlots[hash(_key, _size, mSeed) & mMask];
+		if(index < 0 || mSizes[index] != _size || memcmp(mNames[index], _key, _size) != 0)
+			return -1;
+		return index;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// FNV-1a, starting from a seeded basis
+	uint32_t KeyTable::hash(const char* _key, size_t _size, uint32_t _seed) {
+		uint32_t h = 2166136261u ^ (_seed * 0x9E3779B9u);
+		for(size_t i = 0; i < _size; ++i)
+			h = (h ^ (unsigned char)_key[i]) * 16777619u;
+		return h ^ (h >> 16);
+	}
+
+}	// namespace cjson
\ No newline at end of file
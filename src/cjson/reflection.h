@@ -0,0 +1,156 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_REFLECTION_H_
+#define _CJSON_REFLECTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cjson {
+
+	/// \class Reflection
+	/// \brief Describes the fields of a struct, so Parser::read and Serializer::serialize can map it to json directly.
+	/// Specializations are generated by CJSON_REFLECT. Don't write them by hand.
+	template<class T_>
+	struct Reflection {};
+
+	/// \c value is \c true for types registered with CJSON_REFLECT
+	template<class T_>
+	class IsReflected {
+		template<class U_> static char test(decltype(&Reflection<U_>::cFieldCount));
+		template<class U_> static long test(...);
+	public:
+		static const bool value = sizeof(test<T_>(nullptr)) == 1;
+	};
+
+	/// \class KeyTable
+	/// \brief Perfect hash table from field names to their index.
+	/// The hash seed is searched for once, when the table is built, so that no two names collide. Looking up a key
+	/// then takes a single hash and at most one comparison.
+	class KeyTable {
+	public:
+		/// Throws std::invalid_argument if two of the names are equal, since one of the fields could never be found.
+		KeyTable(const char* const* _names, size_t _count);
+		/// \return the index of the name equal to the given key, or -1 if there is none.
+		int find(const char* _key, size_t _size) const;
+
+	private:
+		static uint32_t hash(const char* _key, size_t _size, uint32_t _seed);
+
+		const char* const*	mNames;
+		std::vector<size_t>	mSizes;
+		std::vector<int>	mSlots; ///< Index of the name in each slot, -1 for empty slots
+		uint32_t			mSeed;
+		uint32_t			mMask;
+	};
+
+}	// namespace cjson
+
+/// Register the fields of a struct for direct parsing and serialization, e.g.
+///   struct Point { int x; int y; std::string label; };
+///   CJSON_REFLECT(Point, x, y, label)
+/// Field types can be bool, int, unsigned, float, double, std::string, Json, std::vector of any of them, or other
+/// reflected structs. Must be used at global scope, with the fully qualified name of the struct. Up to 32 fields.
+#define CJSON_REFLECT(Type_, ...) \
+	namespace cjson { \
+		template<> \
+		struct Reflection<Type_> { \
+			static const size_t cFieldCount = CJSON_DETAIL_COUNT(__VA_ARGS__); \
+			static const char* const* names() { \
+				static const char* const cNames[] = { CJSON_DETAIL_FOR_EACH(CJSON_DETAIL_NAME, __VA_ARGS__) }; \
+				return cNames; \
+			} \
+			static const KeyTable& keys() { \
+				static const KeyTable cKeys(names(), cFieldCount); \
+				return cKeys; \
+			} \
+			/* Call _visitor(field) on the field with the given index */ \
+			template<class T_, class Visitor_> \
+			static bool visitField(T_& _x, size_t _field, Visitor_& _visitor) { \
+				switch(_field) { \
+				CJSON_DETAIL_FOR_EACH(CJSON_DETAIL_VISIT_FIELD, __VA_ARGS__) \
+				default: return false; \
+				} \
+			} \
+			/* Call _visitor(index, field) on every field, in order, until one of them returns false */ \
+			template<class T_, class Visitor_> \
+			static bool visitFields(T_& _x, Visitor_& _visitor) { \
+				CJSON_DETAIL_FOR_EACH(CJSON_DETAIL_VISIT_INDEXED, __VA_ARGS__) \
+				return true; \
+			} \
+		}; \
+	}
+
+// Implementation details of CJSON_REFLECT
+#define CJSON_DETAIL_EXPAND(_x) _x // Forces MSVC to expand __VA_ARGS__ into several arguments
+#define CJSON_DETAIL_NAME(_i, _field) #_field,
+#define CJSON_DETAIL_VISIT_FIELD(_i, _field) case _i: return _visitor(_x._field);
+#define CJSON_DETAIL_VISIT_INDEXED(_i, _field) if(!_visitor(size_t(_i), _x._field)) return false;
+#define CJSON_DETAIL_COUNT(...) CJSON_DETAIL_EXPAND(CJSON_DETAIL_COUNT_N(__VA_ARGS__, \
+	32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, \
+	16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define CJSON_DETAIL_COUNT_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, \
+	_16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _n, ...) _n
+#define CJSON_DETAIL_CONCAT(_a, _b) CJSON_DETAIL_CONCAT_IMPL(_a, _b)
+#define CJSON_DETAIL_CONCAT_IMPL(_a, _b) _a##_b
+#define CJSON_DETAIL_FOR_EACH(_m, ...) \
+	CJSON_DETAIL_EXPAND(CJSON_DETAIL_CONCAT(CJSON_DETAIL_FE_, CJSON_DETAIL_COUNT(__VA_ARGS__))(_m, 0, __VA_ARGS__))
+#define CJSON_DETAIL_FE_1(_m, _i, _x) _m(_i, _x)
+#define CJSON_DETAIL_FE_2(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_1(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_3(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_2(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_4(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_3(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_5(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_4(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_6(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_5(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_7(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_6(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_8(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_7(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_9(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_8(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_10(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_9(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_11(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_10(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_12(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_11(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_13(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_12(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_14(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_13(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_15(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_14(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_16(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_15(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_17(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_16(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_18(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_17(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_19(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_18(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_20(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_19(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_21(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_20(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_22(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_21(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_23(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_22(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_24(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_23(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_25(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_24(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_26(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_25(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_27(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_26(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_28(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_27(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_29(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_28(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_30(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_29(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_31(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_30(_m, _i+1, __VA_ARGS__))
+#define CJSON_DETAIL_FE_32(_m, _i, _x, ...) _m(_i, _x) CJSON_DETAIL_EXPAND(CJSON_DETAIL_FE_31(_m, _i+1, __VA_ARGS__))
+
+#endif // _CJSON_REFLECTION_H_
\ No newline at end of file
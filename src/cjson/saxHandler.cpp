@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "saxHandler.h"
+#include "json.h"
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	JsonBuilder::JsonBuilder(Json& _dst)
+		: mRoot(_dst)
+	{
+		mRoot.setNull();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::null() {
+		next();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::boolean(bool _b) {
+		next() = _b;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::integer(int _i) {
+		next() = _i;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::real(float _f) {
+		next() = _f;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::string(const std::string& _s) {
+		next() = _s;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::beginArray() {
+		Json& array = next();
+		array.makeContainer(Json::DataType::array);
+		mStack.push_back(&array);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::endArray() {
+		mStack.pop_back();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::beginObject() {
+		Json& object = next();
+		object.makeContainer(Json::DataType::object);
+		mStack.push_back(&object);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::key(const std::string& _key) {
+		mKey = _key;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool JsonBuilder::endObject() {
+		mStack.pop_back();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Json& JsonBuilder::next() {
+		if(mStack.empty())
+			return mRoot;
+		Json& container = *mStack.back();
+		if(container.isArray()) {
+			Json::Array& elements = container.mutableArray();
+			elements.push_back(new Json());
+			return *elements.back();
+		}
+		Json*& slot = container.mutableObject()[mKey];
+		if(slot) // Repeated key, last value wins
+			slot->setNull();
+		else
+			slot = new Json();
+		return *slot;
+	}
+
+}	// namespace cjson
\ No newline at end of file
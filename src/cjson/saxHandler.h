@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_SAXHANDLER_H_
+#define _CJSON_SAXHANDLER_H_
+
+#include <string>
+#include <vector>
+
+namespace cjson {
+
+	class Json;
+
+	/// \class SaxHandler
+	/// \brief Receives the elements of a document as Parser::parse(SaxHandler&) finds them, without building a Json.
+	/// Every callback returns \c false to stop parsing, which then fails with ParseErrorCode::rejected.
+	class SaxHandler {
+	public:
+		virtual ~SaxHandler() {}
+
+		virtual bool null() = 0;
+		virtual bool boolean(bool _b) = 0;
+		virtual bool integer(int _i) = 0;
+		virtual bool real(float _f) = 0;
+		virtual bool string(const std::string& _s) = 0;
+		virtual bool beginArray() = 0;
+		virtual bool endArray() = 0;
+		virtual bool beginObject() = 0;
+		/// Called before the value of each member of an object
+		virtual bool key(const std::string& _key) = 0;
+		virtual bool endObject() = 0;
+	};
+
+	/// \class JsonBuilder
+	/// \brief Builds a Json out of parsing events. Can be chained after handlers that filter or check the events.
+	class JsonBuilder : public SaxHandler {
+	public:
+		/// \param _dst Json to fill in. It is reset to null.
+		explicit JsonBuilder(Json& _dst);
+
+		bool null() override;
+		bool boolean(bool _b) override;
+		bool integer(int _i) override;
+		bool real(float _f) override;
+		bool string(const std::string& _s) override;
+		bool beginArray() override;
+		bool endArray() override;
+		bool beginObject() override;
+		bool key(const std::string& _key) override;
+		bool endObject() override;
+
+	private:
+		Json& next(); ///< Slot for the next value
+
+		Json&				mRoot;
+		std::vector<Json*>	mStack; ///< Containers currently open, innermost last
+		std::string			mKey; ///< Key of the next value, inside objects
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_SAXHANDLER_H_
\ No newline at end of file
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "schema.h"
+#include "json.h"
+#include "reflection.h"
+#include "utf8.h"
+#include <cassert>
+#include <vector>
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	struct Schema::Node {
+		Type						type;
+		std::vector<std::string>	keys;
+		std::vector<Schema>			fields; ///< For objects, the schema of each key. For arrays, the elements.
+		std::vector<const char*>	names; ///< Keys as C strings, for the key table
+		std::vector<bool>			plainKeys;
+		std::unique_ptr<KeyTable>	keyTable;
+
+		explicit Node(Type _type) : type(_type) {}
+
+		void buildKeyTable() {
+			for(const std::string& key : keys) {
+				names.push_back(key.c_str());
+				bool plain = isValidUtf8(key.data(), key.size());
+				for(char c : key)
+					plain = plain && (unsigned char)c >= 0x20 && c != '"' && c != '\\';
+				plainKeys.push_back(plain);
+			}
+			keyTable.reset(new KeyTable(names.data(), names.size()));
+		}
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema::Schema() {
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema::Schema(std::shared_ptr<const Node> _node)
+		: mNode(std::move(_node))
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema::Schema(const Json& _sample) {
+		if(_sample.isArray())
+			*this = array(_sample.size() ? Schema(_sample(0)) : Schema());
+		else if(_sample.isObject()) {
+			std::shared_ptr<Node> node = std::make_shared<Node>(Type::object);
+			for(auto i = _sample.begin(); i != _sample.end(); ++i) {
+				node->keys.push_back(i.key());
+				node->fields.push_back(Schema(*i));
+			}
+			node->buildKeyTable();
+			mNode = node;
+		}
+		else if(_sample.isBool())
+			*this = ofType(Type::boolean);
+		else if(_sample.isNumber())
+			*this = ofType(_sample.mType == Json::DataType::integer ? Type::integer : Type::real);
+		else if(_sample.isString())
+			*this = ofType(Type::text);
+		// Null samples say nothing about the type
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema Schema::ofType(Type _type) {
+		assert(_type != Type::array && _type != Type::object);
+		if(_type == Type::any)
+			return Schema();
+		return Schema(std::make_shared<Node>(_type));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema Schema::array(const Schema& _elements) {
+		std::shared_ptr<Node> node = std::make_shared<Node>(Type::array);
+		node->fields.push_back(_elements);
+		return Schema(node);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema Schema::object(std::initializer_list<std::pair<std::string, Schema>> _fields) {
+		std::shared_ptr<Node> node = std::make_shared<Node>(Type::object);
+		for(const auto& field : _fields) {
+			node->keys.push_back(field.first);
+			node->fields.push_back(field.second);
+		}
+		node->buildKeyTable();
+		return Schema(node);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Schema::Type Schema::type() const {
+		return mNode ? mNode->type : Type::any;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const Schema* Schema::elements() const {
+		assert(type() == Type::array);
+		return &mNode->fields[0];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Schema::fieldCount() const {
+		assert(type() == Type::object);
+		return mNode->keys.size();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const std::string& Schema::key(size_t _field) const {
+		return mNode->keys[_field];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Schema::isPlainKey(size_t _field) const {
+		return mNode->plainKeys[_field];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const Schema& Schema::field(size_t _field) const {
+		return mNode->fields[_field];
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	int Schema::findKey(const char* _key, size_t _size) const {
+		return mNode->keyTable->find(_key, _size);
+	}
+
+}	// namespace cjson
\ No newline at end of file
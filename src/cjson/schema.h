@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_SCHEMA_H_
+#define _CJSON_SCHEMA_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace cjson {
+
+	class Json;
+	template<class Options_> class BasicParser;
+
+	/// \class Schema
+	/// \brief Expected shape of a document: the type of each value, and the keys of each object in the order they
+	/// usually come in.
+	/// Parser::parse(Json&, const Schema&) uses it to predict the next key and skip the generic dispatch. Documents
+	/// that don't follow the schema are still parsed correctly, just without the speed up.
+	/// Schemas are immutable and cheap to copy.
+	class Schema {
+	public:
+		enum class Type {
+			any, ///< Unknown, parsed the generic way
+			boolean,
+			integer,
+			real,
+			text,
+			array,
+			object,
+		};
+
+		Schema(); ///< Matches anything
+		/// Take the schema from a sample document. Keys are expected in the order Json keeps them, which is also the
+		/// order the Serializer writes them in. Arrays take the schema of their first element.
+		explicit Schema(const Json& _sample);
+
+		static Schema ofType(Type _type); ///< Schema for values that aren't arrays nor objects
+		static Schema array(const Schema& _elements);
+		/// Fields in the order they are expected in the input
+		static Schema object(std::initializer_list<std::pair<std::string, Schema>> _fields);
+
+		Type	type() const;
+
+	private:
+		template<class> friend class BasicParser;
+
+		const Schema*		elements() const; ///< Schema of the elements of an array
+		size_t				fieldCount() const;
+		const std::string&	key(size_t _field) const;
+		/// Valid UTF-8 without quotes, backslashes nor control characters, so it appears verbatim in the input
+		bool				isPlainKey(size_t _field) const;
+		const Schema&		field(size_t _field) const;
+		int					findKey(const char* _key, size_t _size) const; ///< -1 if there is no such field
+
+		struct Node;
+		explicit Schema(std::shared_ptr<const Node> _node);
+		std::shared_ptr<const Node> mNode; ///< Null for Type::any
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_SCHEMA_H_
\ No newline at end of file
@@ -26,93 +26,276 @@
 #include "serializer.h"
 #include "json.h"
 
+#include <algorithm>
 #include <cassert>
+#include <clocale>
+#include <cstdio>
 
 using namespace std;
 
 namespace cjson {
 	//------------------------------------------------------------------------------------------------------------------
 	bool Serializer::serialize(const Json& _j, ostream& _dst) {
-		return push(_j, _dst);
+		StreamSink sink(_dst);
+		return serialize(_j, sink) && sink.flush();
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Serializer::push(const Json& _j, ostream& _oStream, size_t _tab, bool _skipFirstRowTab) {
+	bool Serializer::serialize(const Json& _j, OutputSink& _dst) {
+		CJSON_PROFILE_CALL(mProfile, "serialize", [&_dst]{ return _dst.position(); });
+		return push(_j, _dst) && _dst.good();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const ProfileCounters& Serializer::profile() const {
+#ifdef CJSON_PROFILING
+		return mProfile;
+#else
+		static const ProfileCounters none;
+		return none;
+#endif
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::push(const Json& _j, OutputSink& _dst, size_t _tab, bool _skipFirstRowTab) {
 		if(!_skipFirstRowTab)
-			tabify(_oStream, _tab);
+			tabify(_dst, _tab);
 		switch (_j.mType)
 		{
-		case Json::DataType::null:
-			_oStream << "null";
+		case Json::DataType::null: {
+			CJSON_PROFILE_SCOPE(literal);
+			_dst.write("null", 4);
 			return true;
+		}
 		case Json::DataType::boolean:
-			return push(_j.mNumber.b, _oStream);
-		case Json::DataType::integer:
-			_oStream << _j.mNumber.i;
+			return push(_j.mNumber.b, _dst);
+		case Json::DataType::integer: {
+			CJSON_PROFILE_SCOPE(number);
+			pushInt(_j.mNumber.i, _dst);
 			return true;
-		case Json::DataType::real:
-			_oStream << _j.mNumber.f;
+		}
+		case Json::DataType::real: {
+			CJSON_PROFILE_SCOPE(number);
+			pushReal(_j.mNumber.f, _dst);
 			return true;
+		}
 		case Json::DataType::text:
-			_oStream << '\"' << _j.mText << '\"';
+			push(_j.mText.data(), _j.mText.size(), _dst);
 			return true;
 		case Json::DataType::array:
-			return push(_j.mArray, _oStream, _tab);
+			if(_j.isPacked())
+				return pushPacked(_j, _dst, _tab);
+			return push(_j.array(), _dst, _tab);
 		case Json::DataType::object:
-			return push(_j.mObject, _oStream, _tab);
+			return push(_j.object(), _dst, _tab);
 		default:
 			return false; // Error data type
 		}
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Serializer::push(bool _b, ostream& _oStream) {
-		_oStream << (_b? "true" : "false");
+	bool Serializer::push(bool _b, OutputSink& _dst) {
+		CJSON_PROFILE_SCOPE(literal);
+		if(_b)
+			_dst.write("true", 4);
+		else
+			_dst.write("false", 5);
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Serializer::push(const Json::Array& _array, ostream& _oStream, size_t _tab) {
-		_oStream << "[\n"; // Open braces
+	bool Serializer::push(const Json::Array& _array, OutputSink& _dst, size_t _tab) {
+		CJSON_PROFILE_DEPTH(_tab + 1);
+		_dst.write("[\n", 2); // Open braces
 		// Push elements
 		for(size_t i = 0; i < _array.size(); ++i) {
-			if(!push(*_array[i], _oStream, _tab+1))
+			if(!push(*_array[i], _dst, _tab+1))
 				return false; // Error processing element
 			if(i != _array.size()-1) // All elements but the last one
-				_oStream << ',';
-			_oStream << '\n';
+				_dst.put(',');
+			_dst.put('\n');
 		}
 		// Close braces
-		tabify(_oStream, _tab);
-		_oStream << ']';
+		tabify(_dst, _tab);
+		_dst.put(']');
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Same format as push(const Json::Array&)
+	bool Serializer::pushPacked(const Json& _j, OutputSink& _dst, size_t _tab) {
+		const Json::Container& elements = *_j.mContainer;
+		size_t size = _j.arraySize();
+		CJSON_PROFILE_DEPTH(_tab + 1);
+		_dst.write("[\n", 2);
+		for(size_t i = 0; i < size; ++i) {
+			tabify(_dst, _tab + 1);
+			if(elements.packing == Json::DataType::boolean)
+				push(elements.booleans[i].b, _dst);
+			else {
+				CJSON_PROFILE_SCOPE(number);
+				if(elements.packing == Json::DataType::real)
+					pushReal(elements.numbers[i].f, _dst);
+				else
+					pushInt(elements.numbers[i].i, _dst);
+			}
+			if(i != size - 1)
+				_dst.put(',');
+			_dst.put('\n');
+		}
+		tabify(_dst, _tab);
+		_dst.put(']');
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	bool Serializer::push(const Json::Dictionary& _obj, ostream& _oStream, size_t _tab) {
-		_oStream << "{\n"; // Open braces
+	bool Serializer::push(const Json::Dictionary& _obj, OutputSink& _dst, size_t _tab) {
+		CJSON_PROFILE_DEPTH(_tab + 1);
+		_dst.write("{\n", 2); // Open braces
 		// Push elements
 		size_t i = 0;
 		for(const auto& element : _obj) {
-			tabify(_oStream, _tab+1);
-			_oStream << "\"" << element.first << "\": "; // Key
-			if(!push(*element.second, _oStream, _tab+1, true)) // Value
+			tabify(_dst, _tab+1);
+			push(element.first, _dst); // Key
+			_dst.write(": ", 2);
+			if(!push(*element.second, _dst, _tab+1, true)) // Value
 				return false; // Error processing element
 			if(i < _obj.size()-1) // All elements but the last one
-				_oStream << ',';
-			_oStream << '\n';
+				_dst.put(',');
+			_dst.put('\n');
 			++i;
 		}
 		// Close braces
-		tabify(_oStream, _tab);
-		_oStream << '}';
+		tabify(_dst, _tab);
+		_dst.put('}');
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Serializer::push(const std::string& _s, OutputSink& _dst) {
+		push(_s.data(), _s.size(), _dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Serializer::push(const char* _s, size_t _size, OutputSink& _dst) {
+		CJSON_PROFILE_SCOPE(string);
+		static const char cHex[] = "0123456789abcdef";
+		_dst.put('\"');
+		// Write runs of characters that need no escaping in one go
+		const char* run = _s;
+		const char* end = run + _size;
+		for(const char* p = run; p != end; ++p) {
+			unsigned char c = (unsigned char)*p;
+			if(c >= 0x20 && c != '"' && c != '\\')
+				continue;
+			_dst.write(run, p - run);
+			run = p + 1;
+			switch(c) {
+			case '"': _dst.write("\\\"", 2); break;
+			case '\\': _dst.write("\\\\", 2); break;
+			case '\b': _dst.write("\\b", 2); break;
+			case '\f': _dst.write("\\f", 2); break;
+			case '\n': _dst.write("\\n", 2); break;
+			case '\r': _dst.write("\\r", 2); break;
+			case '\t': _dst.write("\\t", 2); break;
+			default: { // Other control characters
+				char escape[] = { '\\', 'u', '0', '0', cHex[c >> 4], cHex[c & 0xF] };
+				_dst.write(escape, sizeof(escape));
+			}
+			}
+		}
+		_dst.write(run, end - run);
+		_dst.put('\"');
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Indentation grows with depth, so deep documents spend most of their output on it. Tabs are written in runs.
+	void Serializer::tabify(OutputSink& _dst, size_t _tab) {
+		CJSON_PROFILE_SCOPE(whitespace);
+		static const char cTabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+		const size_t cRun = sizeof(cTabs) - 1;
+		for(; _tab > cRun; _tab -= cRun)
+			_dst.write(cTabs, cRun);
+		_dst.write(cTabs, _tab);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Serializer::pushInt(long long _x, OutputSink& _dst) {
+		char digits[24];
+		char* first = digits + sizeof(digits);
+		unsigned long long magnitude = _x < 0 ? 0ull - (unsigned long long)_x : (unsigned long long)_x;
+		do {
+			*--first = char('0' + magnitude % 10);
+			magnitude /= 10;
+		} while(magnitude);
+		if(_x < 0)
+			*--first = '-';
+		_dst.write(first, size_t(digits + sizeof(digits) - first));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Serializer::pushFinite(double _x, OutputSink& _dst) {
+		// Same conversion std::ostream does with its default flags
+		char text[64];
+		vector<char> longText;
+		char* begin = text;
+		int size = snprintf(text, sizeof(text), "%.*g", _dst.precision(), _x);
+		if(size < 0)
+			return;
+		if(size_t(size) >= sizeof(text)) { // Only with a huge precision
+			longText.resize(size_t(size) + 1);
+			begin = longText.data();
+			snprintf(begin, longText.size(), "%.*g", _dst.precision(), _x);
+		}
+		// The C locale may use another decimal point, but json always uses '.'
+		char point = *localeconv()->decimal_point;
+		if(point != '.')
+			replace(begin, begin + size, point, '.');
+		_dst.write(begin, size_t(size));
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::write(bool _b, OutputSink& _dst, size_t) {
+		return push(_b, _dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::write(int _i, OutputSink& _dst, size_t) {
+		CJSON_PROFILE_SCOPE(number);
+		pushInt(_i, _dst);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::write(unsigned _u, OutputSink& _dst, size_t) {
+		CJSON_PROFILE_SCOPE(number);
+		pushInt(_u, _dst);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::write(float _f, OutputSink& _dst, size_t) {
+		CJSON_PROFILE_SCOPE(number);
+		pushReal(_f, _dst);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::write(double _d, OutputSink& _dst, size_t) {
+		CJSON_PROFILE_SCOPE(number);
+		pushReal(_d, _dst);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Serializer::write(const std::string& _s, OutputSink& _dst, size_t) {
+		push(_s, _dst);
 		return true;
 	}
 
 	//------------------------------------------------------------------------------------------------------------------
-	void Serializer::tabify(ostream& _oStream, size_t _tab) {
-		for(size_t i = 0; i < _tab; ++i)
-			_oStream << '\t';
+	bool Serializer::write(const Json& _j, OutputSink& _dst, size_t _tab) {
+		return push(_j, _dst, _tab, true);
 	}
 
 }	// namespace cjson
\ No newline at end of file
@@ -26,9 +26,15 @@
 #ifndef _CJSON_SERIALIZER_H_
 #define _CJSON_SERIALIZER_H_
 
+#include <cmath>
 #include <string>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 #include "json.h"
+#include "outputSink.h"
+#include "profiling.h"
+#include "reflection.h"
 
 namespace cjson {
 
@@ -38,16 +44,61 @@ namespace cjson {
 		/// It translates the binary Json _j into standard text format.
 		///\return true on success, 0 on serialization error.
 		bool serialize(const Json& _j, std::ostream& _dst);
+		/// Serialize into a sink, such as a FileSink to go straight to a file or socket without iostreams.
+		/// The sink is not flushed, so several documents can be written in a row and go out together.
+		///\return \c false on serialization error, or if the sink failed.
+		bool serialize(const Json& _j, OutputSink& _dst);
+		/// Serialize a struct registered with CJSON_REFLECT straight into a std::ostream, with no intermediate Json.
+		/// The output is formatted just like that of the equivalent Json.
+		template<class T_>
+		typename std::enable_if<IsReflected<T_>::value, bool>::type serialize(const T_& _x, std::ostream& _dst);
+		template<class T_>
+		typename std::enable_if<IsReflected<T_>::value, bool>::type serialize(const T_& _x, OutputSink& _dst);
+		template<class T_>
+		bool serialize(const std::vector<T_>& _x, std::ostream& _dst);
+		template<class T_>
+		bool serialize(const std::vector<T_>& _x, OutputSink& _dst);
+
+		/// Where the time of the last call went. All zero unless the library is built with CJSON_PROFILING.
+		const ProfileCounters& profile() const;
 
 	private:
-		bool push(const Json&, std::ostream& _dst, size_t _tab = 0, bool _skipFirstRowTab = false);
-		bool push(bool, std::ostream& _dst);
-		bool push(const Json::Array&, std::ostream& _dst, size_t _tab = 0);
-		bool push(const Json::Dictionary&, std::ostream& _dst, size_t _tab = 0);
+		bool push(const Json&, OutputSink& _dst, size_t _tab = 0, bool _skipFirstRowTab = false);
+		bool push(bool, OutputSink& _dst);
+		void push(const std::string&, OutputSink& _dst); ///< Quoted and escaped string
+		void push(const char* _s, size_t _size, OutputSink& _dst);
+		bool push(const Json::Array&, OutputSink& _dst, size_t _tab = 0);
+		bool push(const Json::Dictionary&, OutputSink& _dst, size_t _tab = 0);
+		bool pushPacked(const Json&, OutputSink& _dst, size_t _tab); ///< Straight from the numbers, without nodes
+		void pushInt(long long _x, OutputSink& _dst);
+		/// Infinities and NaN can't be represented in json, and are written as null. Negative zero keeps its sign.
+		template<class Real_>
+		void pushReal(Real_ _x, OutputSink& _dst);
+		void pushFinite(double _x, OutputSink& _dst); ///< In the format of std::ostream, at the sink's precision
+
+		void tabify(OutputSink& _dst, size_t _tab);
 
-		void tabify(std::ostream& _dst, size_t _tab);
+		// Direct writing of C++ values
+		struct FieldWriter;
+		bool write(bool, OutputSink& _dst, size_t _tab);
+		bool write(int, OutputSink& _dst, size_t _tab);
+		bool write(unsigned, OutputSink& _dst, size_t _tab);
+		bool write(float, OutputSink& _dst, size_t _tab);
+		bool write(double, OutputSink& _dst, size_t _tab);
+		bool write(const std::string&, OutputSink& _dst, size_t _tab);
+		bool write(const Json&, OutputSink& _dst, size_t _tab);
+		template<class T_>
+		bool write(const std::vector<T_>&, OutputSink& _dst, size_t _tab);
+		template<class T_>
+		typename std::enable_if<IsReflected<T_>::value, bool>::type write(const T_&, OutputSink& _dst, size_t _tab);
+
+#ifdef CJSON_PROFILING
+		ProfileCounters	mProfile;
+#endif
 	};
 
 }	// namespace cjson
 
+#include "serializer.inl"
+
 #endif // _CJSON_SERIALIZER_H_
\ No newline at end of file
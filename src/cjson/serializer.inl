@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_SERIALIZER_INL_
+#define _CJSON_SERIALIZER_INL_
+
+#include "serializer.h" // This will actually be ignored due to guards, but works for intellisense.
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	/// Writes each visited field as a member of a json object
+	struct Serializer::FieldWriter {
+		Serializer&		serializer;
+		OutputSink&		dst;
+		size_t			tab;
+		const char* const* names;
+		size_t			count;
+
+		template<class T_>
+		bool operator()(size_t _index, const T_& _field) const {
+			serializer.tabify(dst, tab + 1);
+			dst.put('\"');
+			dst.write(names[_index]); // Field names are identifiers, they never need escaping
+			dst.write("\": ", 3);
+			if(!serializer.write(_field, dst, tab + 1))
+				return false;
+			if(_index + 1 < count) // All elements but the last one
+				dst.put(',');
+			dst.put('\n');
+			return true;
+		}
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class T_>
+	typename std::enable_if<IsReflected<T_>::value, bool>::type Serializer::serialize(const T_& _x,
+		std::ostream& _dst)
+	{
+		StreamSink sink(_dst);
+		return serialize(_x, sink) && sink.flush();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class T_>
+	typename std::enable_if<IsReflected<T_>::value, bool>::type Serializer::serialize(const T_& _x, OutputSink& _dst) {
+		CJSON_PROFILE_CALL(mProfile, "serialize", [&_dst]{ return _dst.position(); });
+		return write(_x, _dst, 0) && _dst.good();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class T_>
+	bool Serializer::serialize(const std::vector<T_>& _x, std::ostream& _dst) {
+		StreamSink sink(_dst);
+		return serialize(_x, sink) && sink.flush();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class T_>
+	bool Serializer::serialize(const std::vector<T_>& _x, OutputSink& _dst) {
+		CJSON_PROFILE_CALL(mProfile, "serialize", [&_dst]{ return _dst.position(); });
+		return write(_x, _dst, 0) && _dst.good();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class Real_>
+	void Serializer::pushReal(Real_ _x, OutputSink& _dst) {
+		if(!std::isfinite(_x))
+			_dst.write("null", 4);
+		else if(_x == 0 && std::signbit(_x))
+			_dst.write("-0.0", 4); // Plain -0 would read back as the integer 0
+		else
+			pushFinite(_x, _dst);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class T_>
+	bool Serializer::write(const std::vector<T_>& _x, OutputSink& _dst, size_t _tab) {
+		CJSON_PROFILE_DEPTH(_tab + 1);
+		_dst.write("[\n", 2); // Open braces
+		for(size_t i = 0; i < _x.size(); ++i) {
+			tabify(_dst, _tab + 1);
+			if(!write(_x[i], _dst, _tab + 1))
+				return false;
+			if(i != _x.size() - 1) // All elements but the last one
+				_dst.put(',');
+			_dst.put('\n');
+		}
+		tabify(_dst, _tab);
+		_dst.put(']');
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	template<class T_>
+	typename std::enable_if<IsReflected<T_>::value, bool>::type Serializer::write(const T_& _x, OutputSink& _dst,
+		size_t _tab)
+	{
+		CJSON_PROFILE_DEPTH(_tab + 1);
+		_dst.write("{\n", 2); // Open braces
+		FieldWriter writer = { *this, _dst, _tab, Reflection<T_>::names(), Reflection<T_>::cFieldCount };
+		if(!Reflection<T_>::visitFields(_x, writer))
+			return false;
+		tabify(_dst, _tab);
+		_dst.put('}');
+		return true;
+	}
+
+}	// namespace cjson
+
+#endif // _CJSON_SERIALIZER_INL_
\ No newline at end of file
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Internal helpers for vectorized scanning. Not part of the public interface.
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_SIMD_H_
+#define _CJSON_SIMD_H_
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CJSON_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace cjson {
+	namespace simd {
+
+		/// Number of bytes processed per vector step
+		const size_t cBlockSize = 16;
+
+		//--------------------------------------------------------------------------------------------------------------
+		/// Index of the lowest bit set in _mask. _mask must not be zero.
+		inline unsigned firstBit(uint32_t _mask) {
+			#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, _mask);
+			return unsigned(index);
+			#else
+			return unsigned(__builtin_ctz(_mask));
+			#endif
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		/// \return a mask with one bit per byte in the block [_p, _p+16), set for the non ASCII bytes (high bit on).
+		inline uint32_t highBitMask(const char* _p) {
+			#ifdef CJSON_SSE2
+			return uint32_t(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_p))));
+			#else
+			// Portable fallback, processes the block as two 64 bit words.
+			uint32_t mask = 0;
+			for(unsigned i = 0; i < cBlockSize; i += 8) {
+				uint64_t word;
+				memcpy(&word, _p + i, 8);
+				if(word & 0x8080808080808080ull) {
+					for(unsigned j = 0; j < 8; ++j)
+						if(_p[i+j] & 0x80)
+							mask |= 1u << (i+j);
+				}
+			}
+			return mask;
+			#endif
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		/// \return a mask with one bit per byte in the block [_p, _p+16), set for bytes equal to either _a or _b.
+		inline uint32_t matchMask(const char* _p, char _a, char _b) {
+			#ifdef CJSON_SSE2
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_p));
+			__m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(_a)), _mm_cmpeq_epi8(v, _mm_set1_epi8(_b)));
+			return uint32_t(_mm_movemask_epi8(eq));
+			#else
+			uint32_t mask = 0;
+			for(unsigned i = 0; i < cBlockSize; ++i)
+				if(_p[i] == _a || _p[i] == _b)
+					mask |= 1u << i;
+			return mask;
+			#endif
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		/// \return a mask with one bit per byte in the block [_p, _p+16), set for control characters (below 0x20).
+		inline uint32_t controlMask(const char* _p) {
+			#ifdef CJSON_SSE2
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_p));
+			__m128i below = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1f)), v); // v <= 0x1f, unsigned
+			return uint32_t(_mm_movemask_epi8(below));
+			#else
+			uint32_t mask = 0;
+			for(unsigned i = 0; i < cBlockSize; ++i)
+				if((unsigned char)_p[i] < 0x20)
+					mask |= 1u << i;
+			return mask;
+			#endif
+		}
+
+	}	// namespace simd
+}	// namespace cjson
+
+#endif // _CJSON_SIMD_H_
\ No newline at end of file
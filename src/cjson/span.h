@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_SPAN_H_
+#define _CJSON_SPAN_H_
+
+#include <cassert>
+#include <cstddef>
+
+namespace cjson {
+
+	/// \class Span
+	/// \brief Contiguous run of values owned by someone else, like the numbers of a packed array.
+	template<class T_>
+	class Span {
+	public:
+		Span() : mData(nullptr), mSize(0) {}
+		Span(T_* _data, size_t _size) : mData(_data), mSize(_size) {}
+
+		T_*		data() const { return mData; }
+		size_t	size() const { return mSize; }
+		bool	empty() const { return mSize == 0; }
+
+		T_*		begin() const { return mData; }
+		T_*		end() const { return mData + mSize; }
+		T_&		operator[](size_t _i) const { assert(_i < mSize); return mData[_i]; }
+
+	private:
+		T_*		mData;
+		size_t	mSize;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_SPAN_H_
\ No newline at end of file
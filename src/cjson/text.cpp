@@ -0,0 +1,217 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "text.h"
+#include "allocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace cjson {
+
+	namespace {
+		//--------------------------------------------------------------------------------------------------------------
+		// FNV-1a. Short strings are hashed on every call, so it has to be cheap to start.
+		size_t hashBytes(const char* _s, size_t _size) {
+			uint64_t h = 14695981039346656037ull;
+			for(size_t i = 0; i < _size; ++i)
+				h = (h ^ (unsigned char)_s[i]) * 1099511628211ull;
+			return size_t(h);
+		}
+	}
+
+	const size_t Text::cInlineCapacity;
+
+	//------------------------------------------------------------------------------------------------------------------
+	/// Header of long strings, followed by their characters and a terminator
+	struct Text::Block {
+		size_t						size;
+		mutable std::atomic<size_t>	hash; ///< 0 until computed
+
+		char* characters() { return reinterpret_cast<char*>(this + 1); }
+
+		static Block* create(const char* _s, size_t _size) {
+			Block* block = new(allocateMemory(sizeof(Block) + _size + 1)) Block;
+			block->size = _size;
+			block->hash.store(0, std::memory_order_relaxed);
+			memcpy(block->characters(), _s, _size);
+			block->characters()[_size] = '\0';
+			return block;
+		}
+	};
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text::Text() {
+		memset(mBytes, 0, cInlineCapacity);
+		mBytes[cInlineCapacity] = char(cInlineCapacity);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text::Text(const char* _s, size_t _size)
+		: Text()
+	{
+		assign(_s, _size);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text::Text(const Text& _x)
+		: Text()
+	{
+		assign(_x.data(), _x.size());
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text::Text(Text&& _x) {
+		memcpy(mBytes, _x.mBytes, sizeof(mBytes));
+		new(&_x) Text(); // The block, if any, is ours now
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text& Text::operator=(const Text& _x) {
+		if(this != &_x)
+			assign(_x.data(), _x.size());
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text& Text::operator=(Text&& _x) {
+		if(this != &_x) {
+			release();
+			memcpy(mBytes, _x.mBytes, sizeof(mBytes));
+			new(&_x) Text();
+		}
+		return *this;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text::~Text() {
+		release();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Text::assign(const char* _s, size_t _size) {
+		// _s may point into our own storage, so it is copied before releasing it
+		if(_size <= cInlineCapacity) {
+			char bytes[cInlineCapacity + 1] = {};
+			memcpy(bytes, _s, _size);
+			bytes[cInlineCapacity] = char(cInlineCapacity - _size);
+			release();
+			memcpy(mBytes, bytes, sizeof(mBytes));
+		}
+		else {
+			Block* created = Block::create(_s, _size);
+			release();
+			memcpy(mBytes, &created, sizeof(created));
+			mBytes[cInlineCapacity] = char(cLongTag);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Text::clear() {
+		release();
+		new(this) Text();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* Text::data() const {
+		return isInline() ? mBytes : block()->characters();
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Text::size() const {
+		return isInline() ? cInlineCapacity - tag() : block()->size;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Text::hash() const {
+		if(isInline())
+			return hashBytes(mBytes, size());
+		Block* b = block();
+		size_t cached = b->hash.load(std::memory_order_relaxed);
+		if(!cached) {
+			cached = hashBytes(b->characters(), b->size);
+			cached += !cached; // 0 means not computed yet
+			b->hash.store(cached, std::memory_order_relaxed);
+		}
+		return cached;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Text::equals(const char* _s, size_t _size) const {
+		return size() == _size && memcmp(data(), _s, _size) == 0;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Text::operator==(const Text& _x) const {
+		if(isInline() || _x.isInline()) // Short strings fit in the first two words, compare them whole
+			return memcmp(mBytes, _x.mBytes, sizeof(mBytes)) == 0;
+		Block* mine = block();
+		Block* theirs = _x.block();
+		if(mine->size != theirs->size)
+			return false;
+		size_t myHash = mine->hash.load(std::memory_order_relaxed);
+		size_t theirHash = theirs->hash.load(std::memory_order_relaxed);
+		if(myHash && theirHash && myHash != theirHash)
+			return false;
+		return memcmp(mine->characters(), theirs->characters(), mine->size) == 0;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	int Text::compare(const Text& _x) const {
+		size_t mySize = size();
+		size_t theirSize = _x.size();
+		int order = memcmp(data(), _x.data(), std::min(mySize, theirSize));
+		if(order)
+			return order;
+		return mySize < theirSize ? -1 : (mySize > theirSize ? 1 : 0);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Text::allocatedBytes() const {
+		return isInline() ? 0 : sizeof(Block) + block()->size + 1;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Text::Block* Text::block() const {
+		Block* b;
+		memcpy(&b, mBytes, sizeof(b));
+		return b;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Text::release() {
+		if(!isInline()) {
+			Block* b = block();
+			size_t bytes = sizeof(Block) + b->size + 1;
+			b->~Block();
+			freeMemory(b, bytes);
+			memset(mBytes, 0, cInlineCapacity); // Empty, until the caller writes something else
+			mBytes[cInlineCapacity] = char(cInlineCapacity);
+		}
+	}
+
+}	// namespace cjson
\ No newline at end of file
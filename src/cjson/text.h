@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_TEXT_H_
+#define _CJSON_TEXT_H_
+
+#include <cstddef>
+#include <string>
+
+namespace cjson {
+
+	/// \class Text
+	/// \brief Storage for the strings of Json values, sized for the short strings that make up most of JSON documents.
+	/// Strings of up to cInlineCapacity bytes are kept inside the Text itself, whose last byte holds the number of
+	/// unused bytes, so it is also the terminator of a string that fills it. Longer strings take a single allocation
+	/// that also holds their length and their hash, which is computed once.
+	/// A Text takes 16 bytes, half the size of a std::string.
+	class Text {
+	public:
+		static const size_t cInlineCapacity = 15;
+
+		Text(); ///< Empty
+		Text(const char* _s, size_t _size);
+		Text(const Text&);
+		Text(Text&&);
+		Text& operator=(const Text&);
+		Text& operator=(Text&&);
+		~Text();
+
+		void		assign(const char* _s, size_t _size);
+		void		clear(); ///< Empty the text and free its storage
+
+		const char*	data() const;
+		const char*	c_str() const { return data(); } ///< Always null terminated
+		size_t		size() const;
+		bool		empty() const { return size() == 0; }
+		bool		isInline() const { return tag() != cLongTag; }
+		std::string	str() const { return std::string(data(), size()); }
+		size_t		allocatedBytes() const; ///< Memory taken outside the Text. 0 for short strings.
+
+		/// Hash of the characters. Computed once for long strings, and cheap for short ones.
+		size_t		hash() const;
+		bool		equals(const char* _s, size_t _size) const;
+		bool		operator==(const Text& _x) const;
+		bool		operator!=(const Text& _x) const { return !(*this == _x); }
+		/// Negative, zero or positive, like std::string::compare
+		int			compare(const Text& _x) const;
+
+	private:
+		struct Block;
+		static const unsigned char cLongTag = 0xFF;
+
+		unsigned char	tag() const { return (unsigned char)mBytes[cInlineCapacity]; }
+		Block*			block() const;
+		void			release();
+
+		char mBytes[cInlineCapacity + 1]; ///< The characters of a short string, or a pointer to a Block
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_TEXT_H_
\ No newline at end of file
@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "utf8.h"
+#include "simd.h"
+
+namespace cjson {
+
+	//------------------------------------------------------------------------------------------------------------------
+	Utf8Validator::Utf8Validator()
+		: mPending(0)
+		, mLow(0x80)
+		, mHigh(0xBF)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void Utf8Validator::reset() {
+		mPending = 0;
+		mLow = 0x80;
+		mHigh = 0xBF;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* Utf8Validator::feed(const char* _begin, const char* _end) {
+		const char* p = _begin;
+		while(p != _end) {
+			if(mPending == 0) {
+				// Between sequences. Skip ASCII a whole block at a time.
+				while(size_t(_end - p) >= simd::cBlockSize) {
+					uint32_t mask = simd::highBitMask(p);
+					if(mask) {
+						p += simd::firstBit(mask);
+						break;
+					}
+					p += simd::cBlockSize;
+				}
+				if(p == _end)
+					break;
+				unsigned char c = (unsigned char)*p;
+				if(c < 0x80) { // ASCII tail, shorter than a block
+					++p;
+					continue;
+				}
+				// Lead byte. Ranges from table 3-7 of the Unicode standard
+				mLow = 0x80;
+				mHigh = 0xBF;
+				if(c < 0xC2)
+					return p; // Continuation byte without lead, or overlong 2 byte sequence
+				else if(c < 0xE0)
+					mPending = 1;
+				else if(c < 0xF0) {
+					mPending = 2;
+					if(c == 0xE0) mLow = 0xA0; // Overlong
+					else if(c == 0xED) mHigh = 0x9F; // Surrogates
+				}
+				else if(c < 0xF5) {
+					mPending = 3;
+					if(c == 0xF0) mLow = 0x90; // Overlong
+					else if(c == 0xF4) mHigh = 0x8F; // Above U+10FFFF
+				}
+				else
+					return p;
+				++p;
+			}
+			else {
+				// Inside a sequence
+				unsigned char c = (unsigned char)*p;
+				if(c < mLow || c > mHigh)
+					return p;
+				mLow = 0x80;
+				mHigh = 0xBF;
+				--mPending;
+				++p;
+			}
+		}
+		return nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Utf8Validator::complete() const {
+		return mPending == 0;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool isValidUtf8(const char* _s, size_t _size, size_t* _errorOffset) {
+		Utf8Validator validator;
+		const char* error = validator.feed(_s, _s + _size);
+		if(!error && !validator.complete())
+			error = _s + _size; // Truncated sequence at the end
+		if(error && _errorOffset)
+			*_errorOffset = size_t(error - _s);
+		return error == nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	void appendUtf8(std::string& _dst, unsigned _cp) {
+		if(_cp < 0x80)
+			_dst += char(_cp);
+		else if(_cp < 0x800) {
+			_dst += char(0xC0 | (_cp >> 6));
+			_dst += char(0x80 | (_cp & 0x3F));
+		}
+		else if(_cp < 0x10000) {
+			_dst += char(0xE0 | (_cp >> 12));
+			_dst += char(0x80 | ((_cp >> 6) & 0x3F));
+			_dst += char(0x80 | (_cp & 0x3F));
+		}
+		else {
+			_dst += char(0xF0 | (_cp >> 18));
+			_dst += char(0x80 | ((_cp >> 12) & 0x3F));
+			_dst += char(0x80 | ((_cp >> 6) & 0x3F));
+			_dst += char(0x80 | (_cp & 0x3F));
+		}
+	}
+
+}	// namespace cjson
\ No newline at end of file
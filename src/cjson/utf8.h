@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_UTF8_H_
+#define _CJSON_UTF8_H_
+
+#include <cstddef>
+#include <string>
+
+namespace cjson {
+
+	/// \class Utf8Validator
+	/// \brief Incremental UTF-8 validator.
+	/// Input can be fed in arbitrary chunks, so multi-byte sequences may be split across calls to feed().
+	/// Only the search for non ASCII bytes is vectorized: runs of ASCII characters are skipped 16 bytes at a time,
+	/// and every byte of a multi-byte sequence goes through a scalar state machine. Text made mostly of multi-byte
+	/// characters is validated at scalar speed.
+	class Utf8Validator {
+	public:
+		Utf8Validator();
+
+		/// Forget any partial sequence and start validating from scratch.
+		void reset();
+
+		/// Validate the next chunk of input.
+		///\return a pointer to the first invalid byte in [_begin, _end), or \c nullptr if the chunk is valid so far.
+		const char* feed(const char* _begin, const char* _end);
+
+		/// \return \c true if the input fed so far doesn't end in the middle of a multi-byte sequence.
+		bool complete() const;
+
+	private:
+		unsigned		mPending; ///< Continuation bytes still expected by the current sequence
+		unsigned char	mLow; ///< Lowest value accepted for the next continuation byte
+		unsigned char	mHigh; ///< Highest value accepted for the next continuation byte
+	};
+
+	/// Validate a complete buffer of UTF-8 text.
+	///\param _errorOffset if not null, receives the offset of the first invalid byte on failure.
+	///\return \c true if the buffer contains only well formed UTF-8.
+	bool isValidUtf8(const char* _s, size_t _size, size_t* _errorOffset = nullptr);
+
+	/// Append the UTF-8 encoding of a code point to a string.
+	void appendUtf8(std::string& _dst, unsigned _codePoint);
+
+}	// namespace cjson
+
+#endif // _CJSON_UTF8_H_
\ No newline at end of file
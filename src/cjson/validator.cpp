@@ -0,0 +1,664 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#include "validator.h"
+#include <cassert>
+#include <cmath>
+#include <sstream>
+
+namespace cjson {
+
+	namespace {
+		// Type masks
+		const unsigned cNull = 1;
+		const unsigned cBoolean = 2;
+		const unsigned cInteger = 4;
+		const unsigned cNumber = 8;
+		const unsigned cString = 16;
+		const unsigned cArray = 32;
+		const unsigned cObject = 64;
+
+		//--------------------------------------------------------------------------------------------------------------
+		unsigned typeBit(const std::string& _name) {
+			if(_name == "null") return cNull;
+			if(_name == "boolean") return cBoolean;
+			if(_name == "integer") return cInteger;
+			if(_name == "number") return cNumber;
+			if(_name == "string") return cString;
+			if(_name == "array") return cArray;
+			if(_name == "object") return cObject;
+			return 0;
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		size_t codePoints(const Text& _s) {
+			size_t count = 0;
+			for(const char* c = _s.data(); c != _s.data() + _s.size(); ++c)
+				count += ((unsigned char)*c & 0xC0) != 0x80;
+			return count;
+		}
+
+		//--------------------------------------------------------------------------------------------------------------
+		// JSON pointer escaping of a key
+		void appendToPath(std::string& _path, const std::string& _key) {
+			_path += '/';
+			for(char c : _key) {
+				if(c == '~')
+					_path += "~0";
+				else if(c == '/')
+					_path += "~1";
+				else
+					_path += c;
+			}
+		}
+	}
+
+	const size_t Validator::cNone;
+
+	//------------------------------------------------------------------------------------------------------------------
+	std::string ValidationError::message() const {
+		return path + ": " + keyword;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	Validator::Validator() {
+		Json anything(true);
+		compile(anything);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Validator::compile(const Json& _schema) {
+		mChecks.clear();
+		mNodes.clear();
+		mPatterns.clear();
+		mEnums.clear();
+		mRequired.clear();
+		mProperties.clear();
+		mCompileError.clear();
+		if(compileNode(_schema, "") != cNone)
+			return true;
+		// Leave a validator that rejects everything
+		mChecks.clear();
+		mNodes.clear();
+		Json nothing(false);
+		compileNode(nothing, "");
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const std::string& Validator::compileError() const {
+		return mCompileError;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Validator::validate(const Json& _document) const {
+		std::string path;
+		return check(0, _document, path, nullptr);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Validator::validate(const Json& _document, ValidationError& _error) const {
+		std::string path;
+		_error = ValidationError();
+		return check(0, _document, path, &_error);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Validator::compileFailed(const std::string& _path, const char* _problem) {
+		mCompileError = (_path.empty() ? std::string("schema root") : _path) + ": " + _problem;
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// The checks of each subschema are emitted together, before those of its children, so they stay contiguous.
+	size_t Validator::compileNode(const Json& _schema, const std::string& _path) {
+		size_t index = mNodes.size();
+		Node node = { mChecks.size(), mChecks.size(), cNone, cNone, true, cNone, cNone, false };
+		if(_schema.isBool()) { // true accepts anything, false nothing
+			if(!bool(_schema))
+				mChecks.push_back(Check{ Op::never, 0.0, 0 });
+			node.endCheck = mChecks.size();
+			mNodes.push_back(node);
+			return index;
+		}
+		if(!_schema.isObject())
+			return compileFailed(_path, "a schema must be an object or a boolean"), cNone;
+
+		auto number = [&](const char* _keyword, double& _value) {
+			const Json& x = _schema[_keyword];
+			if(x.mType == Json::DataType::integer)
+				_value = x.mNumber.i;
+			else if(x.mType == Json::DataType::real)
+				_value = x.mNumber.f;
+			else
+				return compileFailed(_path + "/" + _keyword, "expected a number");
+			return true;
+		};
+		auto count = [&](const char* _keyword, double& _value) {
+			return number(_keyword, _value) && ((_value >= 0 && _value == std::floor(_value))
+				|| compileFailed(_path + "/" + _keyword, "expected a non negative integer"));
+		};
+
+		// Checks on the value itself
+		if(_schema.contains("type")) {
+			const Json& type = _schema["type"];
+			unsigned mask = 0;
+			if(type.isString())
+				mask = typeBit(type);
+			else if(type.isArray()) {
+				for(const Json& name : type) {
+					unsigned bit = name.isString() ? typeBit(name) : 0;
+					if(!bit) {
+						mask = 0;
+						break;
+					}
+					mask |= bit;
+				}
+			}
+			if(!mask)
+				return compileFailed(_path + "/type", "unknown type"), cNone;
+			mChecks.push_back(Check{ Op::type, double(mask), 0 });
+		}
+		const std::pair<const char*, Op> cNumericChecks[] = {
+			{ "minimum", Op::minimum },
+			{ "maximum", Op::maximum },
+			{ "exclusiveMinimum", Op::exclusiveMinimum },
+			{ "exclusiveMaximum", Op::exclusiveMaximum },
+		};
+		for(const auto& keyword : cNumericChecks) {
+			if(!_schema.contains(keyword.first))
+				continue;
+			double limit;
+			if(!number(keyword.first, limit))
+				return cNone;
+			mChecks.push_back(Check{ keyword.second, limit, 0 });
+		}
+		const std::pair<const char*, Op> cCountChecks[] = {
+			{ "minLength", Op::minLength },
+			{ "maxLength", Op::maxLength },
+			{ "minItems", Op::minItems },
+			{ "maxItems", Op::maxItems },
+			{ "minProperties", Op::minProperties },
+			{ "maxProperties", Op::maxProperties },
+		};
+		for(const auto& keyword : cCountChecks) {
+			if(!_schema.contains(keyword.first))
+				continue;
+			double limit;
+			if(!count(keyword.first, limit))
+				return cNone;
+			mChecks.push_back(Check{ keyword.second, limit, 0 });
+		}
+		if(_schema.contains("pattern")) {
+			const Json& pattern = _schema["pattern"];
+			if(!pattern.isString())
+				return compileFailed(_path + "/pattern", "expected a string"), cNone;
+			try {
+				mPatterns.push_back(std::regex(std::string(pattern), std::regex::ECMAScript | std::regex::optimize));
+			}
+			catch(const std::regex_error&) {
+				return compileFailed(_path + "/pattern", "invalid regular expression"), cNone;
+			}
+			mChecks.push_back(Check{ Op::pattern, 0.0, mPatterns.size() - 1 });
+		}
+		if(_schema.contains("enum") || _schema.contains("const")) {
+			std::vector<Json> values;
+			if(_schema.contains("enum")) {
+				const Json& list = _schema["enum"];
+				if(!list.isArray())
+					return compileFailed(_path + "/enum", "expected an array"), cNone;
+				for(const Json& value : list)
+					values.push_back(value);
+			}
+			if(_schema.contains("const"))
+				values.push_back(_schema["const"]);
+			mEnums.push_back(std::move(values));
+			mChecks.push_back(Check{ Op::enumeration, 0.0, mEnums.size() - 1 });
+			node.hasEnum = true;
+		}
+		if(_schema.contains("required")) {
+			const Json& list = _schema["required"];
+			std::vector<std::string> keys;
+			if(list.isArray()) {
+				for(const Json& key : list) {
+					if(!key.isString())
+						break;
+					keys.push_back(key);
+				}
+			}
+			if(!list.isArray() || keys.size() != list.size())
+				return compileFailed(_path + "/required", "expected an array of strings"), cNone;
+			mRequired.push_back(std::move(keys));
+			node.required = mRequired.size() - 1;
+			mChecks.push_back(Check{ Op::required, 0.0, node.required });
+		}
+		node.endCheck = mChecks.size();
+		mNodes.push_back(node);
+
+		// Subschemas of the elements
+		if(_schema.contains("properties")) {
+			const Json& properties = _schema["properties"];
+			if(!properties.isObject())
+				return compileFailed(_path + "/properties", "expected an object"), cNone;
+			std::map<std::string, size_t> compiled;
+			for(auto i = properties.begin(); i != properties.end(); ++i) {
+				std::string childPath = _path + "/properties";
+				appendToPath(childPath, i.key());
+				size_t child = compileNode(*i, childPath);
+				if(child == cNone)
+					return cNone;
+				compiled[i.key()] = child;
+			}
+			mProperties.push_back(std::move(compiled));
+			mNodes[index].properties = mProperties.size() - 1;
+		}
+		if(_schema.contains("additionalProperties")) {
+			const Json& additional = _schema["additionalProperties"];
+			if(additional.isBool())
+				mNodes[index].additionalAllowed = bool(additional);
+			else {
+				size_t child = compileNode(additional, _path + "/additionalProperties");
+				if(child == cNone)
+					return cNone;
+				mNodes[index].additional = child;
+			}
+		}
+		if(_schema.contains("items")) {
+			if(_schema["items"].isArray())
+				return compileFailed(_path + "/items", "lists of item schemas are not supported"), cNone;
+			size_t child = compileNode(_schema["items"], _path + "/items");
+			if(child == cNone)
+				return cNone;
+			mNodes[index].items = child;
+		}
+		return index;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool Validator::check(size_t _node, const Json& _value, std::string& _path, ValidationError* _error) const {
+		const char* failed = checkValue(_node, _value);
+		const Node& node = mNodes[_node];
+		if(!failed && (_value.isArray() || _value.isObject())) {
+			std::vector<bool> seen;
+			if(node.required != cNone && _value.isObject()) {
+				for(const std::string& key : mRequired[node.required])
+					seen.push_back(_value.contains(key));
+			}
+			failed = checkContainer(_node, _value.isArray(), _value.size(), seen, &_value);
+		}
+		if(failed) {
+			if(_error) {
+				_error->path = _path;
+				_error->keyword = failed;
+			}
+			return false;
+		}
+
+		// Elements. Only the parts of the document the schema says something about are visited.
+		size_t pathSize = _path.size();
+		if(_value.isArray() && node.items != cNone) {
+			for(size_t i = 0; i < _value.size(); ++i) {
+				_path += '/';
+				_path += std::to_string(i);
+				if(!check(node.items, _value(i), _path, _error))
+					return false;
+				_path.resize(pathSize);
+			}
+		}
+		else if(_value.isObject()
+			&& (node.properties != cNone || node.additional != cNone || !node.additionalAllowed)) {
+			for(auto i = _value.begin(); i != _value.end(); ++i) {
+				bool allowed;
+				size_t child = propertySchema(_node, i.key(), allowed);
+				appendToPath(_path, i.key());
+				if(!allowed) {
+					if(_error) {
+						_error->path = _path;
+						_error->keyword = "additionalProperties";
+					}
+					return false;
+				}
+				if(child != cNone && !check(child, *i, _path, _error))
+					return false;
+				_path.resize(pathSize);
+			}
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* Validator::checkValue(size_t _node, const Json& _value) const {
+		const Node& node = mNodes[_node];
+		bool isNumber = _value.isNumber();
+		double number = 0.0;
+		if(_value.mType == Json::DataType::integer)
+			number = _value.mNumber.i;
+		else if(_value.mType == Json::DataType::real)
+			number = _value.mNumber.f;
+		bool isContainer = _value.isArray() || _value.isObject();
+		for(size_t i = node.firstCheck; i != node.endCheck; ++i) {
+			const Check& check = mChecks[i];
+			switch(check.op) {
+			case Op::never:
+				return "false";
+			case Op::type:
+			{
+				unsigned bit = _value.isNull() ? cNull : _value.isBool() ? cBoolean : _value.isString() ? cString
+					: _value.isArray() ? cArray : _value.isObject() ? cObject
+					: (_value.mType == Json::DataType::integer) ? cInteger : cNumber;
+				const char* failed = checkType(_node, bit, isNumber && number == std::floor(number));
+				if(failed)
+					return failed;
+				break;
+			}
+			case Op::minimum:
+				if(isNumber && !(number >= check.limit)) return "minimum";
+				break;
+			case Op::maximum:
+				if(isNumber && !(number <= check.limit)) return "maximum";
+				break;
+			case Op::exclusiveMinimum:
+				if(isNumber && !(number > check.limit)) return "exclusiveMinimum";
+				break;
+			case Op::exclusiveMaximum:
+				if(isNumber && !(number < check.limit)) return "exclusiveMaximum";
+				break;
+			case Op::minLength:
+				if(_value.isString() && double(codePoints(_value.mText)) < check.limit) return "minLength";
+				break;
+			case Op::maxLength:
+				if(_value.isString() && double(codePoints(_value.mText)) > check.limit) return "maxLength";
+				break;
+			case Op::pattern:
+				if(_value.isString() && !std::regex_search(_value.mText.data(),
+					_value.mText.data() + _value.mText.size(), mPatterns[check.table]))
+					return "pattern";
+				break;
+			case Op::enumeration:
+			{
+				if(isContainer)
+					break; // Checked along with the elements
+				const std::vector<Json>& values = mEnums[check.table];
+				bool found = false;
+				for(size_t v = 0; v < values.size() && !found; ++v)
+					found = values[v] == _value;
+				if(!found)
+					return "enum";
+				break;
+			}
+			default: // Checks on elements
+				break;
+			}
+		}
+		return nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* Validator::checkType(size_t _node, unsigned _typeBit, bool _integral) const {
+		const Node& node = mNodes[_node];
+		for(size_t i = node.firstCheck; i != node.endCheck; ++i) {
+			const Check& check = mChecks[i];
+			if(check.op == Op::never)
+				return "false";
+			if(check.op != Op::type)
+				continue;
+			unsigned mask = unsigned(check.limit);
+			bool matches = (mask & _typeBit)
+				|| (_typeBit == cInteger && (mask & cNumber)) // Integers are numbers
+				|| (_typeBit == cNumber && _integral && (mask & cInteger)); // And so are reals without fraction
+			if(!matches)
+				return "type";
+		}
+		return nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const char* Validator::checkContainer(size_t _node, bool _isArray, size_t _count,
+		const std::vector<bool>& _seenRequired, const Json* _whole) const
+	{
+		const Node& node = mNodes[_node];
+		for(size_t i = node.firstCheck; i != node.endCheck; ++i) {
+			const Check& check = mChecks[i];
+			double count = double(_count);
+			switch(check.op) {
+			case Op::minItems:
+				if(_isArray && count < check.limit) return "minItems";
+				break;
+			case Op::maxItems:
+				if(_isArray && count > check.limit) return "maxItems";
+				break;
+			case Op::minProperties:
+				if(!_isArray && count < check.limit) return "minProperties";
+				break;
+			case Op::maxProperties:
+				if(!_isArray && count > check.limit) return "maxProperties";
+				break;
+			case Op::required:
+				if(!_isArray) {
+					for(bool seen : _seenRequired) {
+						if(!seen)
+							return "required";
+					}
+				}
+				break;
+			case Op::enumeration:
+			{
+				assert(_whole);
+				const std::vector<Json>& values = mEnums[check.table];
+				bool found = false;
+				for(size_t v = 0; v < values.size() && !found; ++v)
+					found = values[v] == *_whole;
+				if(!found)
+					return "enum";
+				break;
+			}
+			default: // Checks on the value itself
+				break;
+			}
+		}
+		return nullptr;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t Validator::propertySchema(size_t _node, const std::string& _key, bool& _allowed) const {
+		const Node& node = mNodes[_node];
+		_allowed = true;
+		if(node.properties != cNone) {
+			const std::map<std::string, size_t>& properties = mProperties[node.properties];
+			auto i = properties.find(_key);
+			if(i != properties.end())
+				return i->second;
+		}
+		_allowed = node.additionalAllowed;
+		return node.additional;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	ValidatingHandler::ValidatingHandler(const Validator& _validator, SaxHandler* _next)
+		: mValidator(_validator)
+		, mNext(_next)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	const ValidationError& ValidatingHandler::error() const {
+		return mError;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::null() {
+		return scalar(Json()) && forward([](SaxHandler& _h) { return _h.null(); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::boolean(bool _b) {
+		return scalar(Json(_b)) && forward([_b](SaxHandler& _h) { return _h.boolean(_b); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::integer(int _i) {
+		return scalar(Json(_i)) && forward([_i](SaxHandler& _h) { return _h.integer(_i); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::real(float _f) {
+		return scalar(Json(_f)) && forward([_f](SaxHandler& _h) { return _h.real(_f); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::string(const std::string& _s) {
+		return scalar(Json(_s)) && forward([&_s](SaxHandler& _h) { return _h.string(_s); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::beginArray() {
+		return begin(true) && forward([](SaxHandler& _h) { return _h.beginArray(); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::endArray() {
+		return forward([](SaxHandler& _h) { return _h.endArray(); }) && end(true);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::beginObject() {
+		return begin(false) && forward([](SaxHandler& _h) { return _h.beginObject(); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::key(const std::string& _key) {
+		Frame& frame = mFrames.back();
+		frame.key = _key;
+		frame.valueNode = Validator::cNone;
+		if(frame.node != Validator::cNone) {
+			bool allowed;
+			frame.valueNode = mValidator.propertySchema(frame.node, _key, allowed);
+			if(!allowed)
+				return reject("additionalProperties", mFrames.size());
+			size_t required = mValidator.mNodes[frame.node].required;
+			if(required != Validator::cNone) {
+				const std::vector<std::string>& keys = mValidator.mRequired[required];
+				for(size_t i = 0; i < keys.size(); ++i) {
+					if(keys[i] == _key)
+						frame.seenRequired[i] = true;
+				}
+			}
+		}
+		return forward([&_key](SaxHandler& _h) { return _h.key(_key); });
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::endObject() {
+		return forward([](SaxHandler& _h) { return _h.endObject(); }) && end(false);
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	size_t ValidatingHandler::nextNode() const {
+		if(mFrames.empty())
+			return 0; // Root
+		const Frame& frame = mFrames.back();
+		if(!frame.isArray)
+			return frame.valueNode;
+		return frame.node == Validator::cNone ? Validator::cNone : mValidator.mNodes[frame.node].items;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::scalar(const Json& _value) {
+		size_t node = nextNode();
+		if(node != Validator::cNone) {
+			const char* failed = mValidator.checkValue(node, _value);
+			if(failed)
+				return reject(failed, mFrames.size());
+		}
+		if(!mFrames.empty())
+			++mFrames.back().count;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::begin(bool _isArray) {
+		size_t node = nextNode();
+		Frame frame = { node, _isArray, 0, std::string(), Validator::cNone, std::vector<bool>() };
+		if(node != Validator::cNone) {
+			const char* failed = mValidator.checkType(node, _isArray ? cArray : cObject, false);
+			if(failed)
+				return reject(failed, mFrames.size());
+			const Validator::Node& schema = mValidator.mNodes[node];
+			if(schema.required != Validator::cNone)
+				frame.seenRequired.resize(mValidator.mRequired[schema.required].size(), false);
+			if(schema.hasEnum) // Keep a copy of the container, it will be compared as a whole
+				mCaptures.emplace_back(new Capture(mFrames.size()));
+		}
+		mFrames.push_back(std::move(frame));
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::end(bool _isArray) {
+		Frame& frame = mFrames.back();
+		if(frame.node != Validator::cNone) {
+			const Json* whole = nullptr;
+			if(!mCaptures.empty() && mCaptures.back()->depth == mFrames.size() - 1)
+				whole = &mCaptures.back()->value;
+			const char* failed = mValidator.checkContainer(frame.node, _isArray, frame.count, frame.seenRequired,
+				whole);
+			if(failed)
+				return reject(failed, mFrames.size() - 1);
+			if(whole)
+				mCaptures.pop_back();
+		}
+		mFrames.pop_back();
+		if(!mFrames.empty())
+			++mFrames.back().count;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	bool ValidatingHandler::reject(const char* _keyword, size_t _frames) {
+		mError.path.clear();
+		for(size_t i = 0; i < _frames; ++i) {
+			if(mFrames[i].isArray) {
+				mError.path += '/';
+				mError.path += std::to_string(mFrames[i].count);
+			}
+			else
+				appendToPath(mError.path, mFrames[i].key);
+		}
+		mError.keyword = _keyword;
+		mFrames.clear();
+		mCaptures.clear();
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------------------------
+	// Events go to the captures in progress, and then to the next handler
+	template<class Event_>
+	bool ValidatingHandler::forward(Event_ _event) {
+		for(auto& capture : mCaptures)
+			_event(capture->builder);
+		return !mNext || _event(*mNext);
+	}
+
+}	// namespace cjson
\ No newline at end of file
@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+#ifndef _CJSON_VALIDATOR_H_
+#define _CJSON_VALIDATOR_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+#include "json.h"
+#include "saxHandler.h"
+
+namespace cjson {
+
+	/// \class ValidationError
+	/// \brief Where and why a document doesn't match a schema
+	struct ValidationError {
+		std::string path; ///< JSON pointer to the offending value, e.g. "/items/3/price". Empty for the root.
+		std::string keyword; ///< Schema keyword that failed, e.g. "minimum"
+
+		/// e.g. "/items/3/price: minimum"
+		std::string message() const;
+	};
+
+	/// \class Validator
+	/// \brief Checks documents against a JSON Schema.
+	/// The schema is compiled once into a flat list of checks per subschema, so validating doesn't walk the schema
+	/// itself. Documents can be validated as Json trees or, through ValidatingHandler, while they are being parsed.
+	/// Supported keywords are type, enum, const, minimum, maximum, exclusiveMinimum, exclusiveMaximum, minLength,
+	/// maxLength, pattern, required, properties, additionalProperties, minProperties, maxProperties, items (a single
+	/// schema), minItems and maxItems. Other keywords, like $schema or title, are ignored.
+	class Validator {
+	public:
+		Validator(); ///< Accepts any document
+		/// \return \c false if the schema is malformed or uses an unsupported form. See compileError().
+		bool compile(const Json& _schema);
+		const std::string& compileError() const;
+
+		bool validate(const Json& _document) const;
+		bool validate(const Json& _document, ValidationError& _error) const;
+
+	private:
+		friend class ValidatingHandler;
+
+		enum class Op {
+			never, ///< The schema is false
+			type,
+			minimum,
+			maximum,
+			exclusiveMinimum,
+			exclusiveMaximum,
+			minLength,
+			maxLength,
+			pattern,
+			enumeration,
+			required,
+			minItems,
+			maxItems,
+			minProperties,
+			maxProperties,
+		};
+
+		struct Check {
+			Op		op;
+			double	limit; ///< Bounds, or the mask of accepted types
+			size_t	table; ///< Index in the table of patterns, enums or required keys
+		};
+
+		/// A compiled subschema
+		struct Node {
+			size_t	firstCheck;
+			size_t	endCheck;
+			size_t	properties; ///< Index in mProperties, or cNone
+			size_t	additional; ///< Schema of other properties, or cNone
+			bool	additionalAllowed;
+			size_t	items; ///< Schema of array elements, or cNone
+			size_t	required; ///< Index in mRequired, or cNone
+			bool	hasEnum;
+		};
+
+		static const size_t cNone = size_t(-1);
+
+		size_t		compileNode(const Json& _schema, const std::string& _path);
+		bool		compileFailed(const std::string& _path, const char* _problem);
+
+		bool		check(size_t _node, const Json& _value, std::string& _path, ValidationError* _error) const;
+		/// Checks that apply to the value itself. For arrays and objects, only the type is checked.
+		const char*	checkValue(size_t _node, const Json& _value) const;
+		const char*	checkType(size_t _node, unsigned _typeBit, bool _integral) const;
+		/// Checks on the elements of an array or object, once all of them are known. _whole is only needed for enum.
+		const char*	checkContainer(size_t _node, bool _isArray, size_t _count, const std::vector<bool>& _seenRequired,
+						const Json* _whole) const;
+		size_t		propertySchema(size_t _node, const std::string& _key, bool& _allowed) const;
+
+		std::vector<Check>							mChecks;
+		std::vector<Node>							mNodes; ///< The root is the first one
+		std::vector<std::regex>						mPatterns;
+		std::vector<std::vector<Json>>				mEnums;
+		std::vector<std::vector<std::string>>		mRequired;
+		std::vector<std::map<std::string, size_t>>	mProperties;
+		std::string									mCompileError;
+	};
+
+	/// \class ValidatingHandler
+	/// \brief Validates parsing events against a schema, and passes them on to another handler.
+	/// The parse stops with ParseErrorCode::rejected at the first element that breaks the schema, so invalid documents
+	/// are rejected before the next handler, e.g. a JsonBuilder, sees the rest of them.
+	class ValidatingHandler : public SaxHandler {
+	public:
+		ValidatingHandler(const Validator& _validator, SaxHandler* _next = nullptr);
+
+		/// What was wrong with the document, after a rejected parse
+		const ValidationError& error() const;
+
+		bool null() override;
+		bool boolean(bool _b) override;
+		bool integer(int _i) override;
+		bool real(float _f) override;
+		bool string(const std::string& _s) override;
+		bool beginArray() override;
+		bool endArray() override;
+		bool beginObject() override;
+		bool key(const std::string& _key) override;
+		bool endObject() override;
+
+	private:
+		struct Frame {
+			size_t				node; ///< Schema of the container, or Validator::cNone
+			bool				isArray;
+			size_t				count; ///< Elements seen so far
+			std::string			key; ///< Key of the current member
+			size_t				valueNode; ///< Schema of the current member
+			std::vector<bool>	seenRequired;
+		};
+
+		/// Values of the containers that have to be compared against an enum
+		struct Capture {
+			Json		value;
+			JsonBuilder	builder;
+			size_t		depth; ///< Number of open containers when the capture started
+
+			Capture(size_t _depth) : builder(value), depth(_depth) {}
+		};
+
+		size_t	nextNode() const;
+		bool	scalar(const Json& _value);
+		bool	begin(bool _isArray);
+		bool	end(bool _isArray);
+		bool	reject(const char* _keyword, size_t _frames);
+		template<class Event_>
+		bool	forward(Event_ _event);
+
+		const Validator&						mValidator;
+		SaxHandler*								mNext;
+		std::vector<Frame>						mFrames;
+		std::vector<std::unique_ptr<Capture>>	mCaptures;
+		ValidationError							mError;
+	};
+
+}	// namespace cjson
+
+#endif // _CJSON_VALIDATOR_H_
\ No newline at end of file
@@ -24,10 +24,18 @@
 // Simple Json C++ library
 //----------------------------------------------------------------------------------------------------------------------
 #include <cassert>
+#include <cjson/frozen.h>
 #include <cjson/json.h>
+#include <cjson/parseContext.h>
+#include <cjson/parser.h>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #if defined(_WIN32) && defined(_DEBUG) // Trace memory leaks
 #define _CRTDBG_MAP_ALLOC
@@ -39,32 +47,62 @@ using namespace cjson;
 using namespace std;
 
 //----------------------------------------------------------------------------------------------------------------------
-// Manage global news and deletes
-/*size_t gNewCount = 0;
-size_t gDeleteCount = 0;
-void* operator new(size_t _count){
+// Count global news and deletes, to check allocation budgets
+std::atomic<size_t> gNewCount(0);
+std::atomic<size_t> gDeleteCount(0);
+
+void* operator new(size_t _count) {
 	++gNewCount;
-	return malloc(_count);
+	if(void* p = malloc(_count ? _count : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t _count) {
+	return operator new(_count);
+}
+
+void operator delete(void* _ptr) noexcept {
+	if(_ptr)
+		++gDeleteCount;
+	free(_ptr);
 }
 
-void* operator new[](size_t _count){
-	gNewCount;
-	return malloc(_count);
+void operator delete[](void* _ptr) noexcept {
+	operator delete(_ptr);
 }
 
-void operator delete(void* _ptr) {
-	--gDeleteCount;
-	return free(_ptr);
+// Allocations made during the lifetime of a counter
+struct AllocationCounter {
+	AllocationCounter() : mNews(gNewCount), mDeletes(gDeleteCount) {}
+	size_t news() const { return gNewCount - mNews; }
+	size_t live() const { return news() - (gDeleteCount - mDeletes); } ///< Not freed yet
+	size_t mNews, mDeletes;
+};
+
+// Allocator hook that keeps track of the memory held by Json values, and forwards to the default allocator
+struct HookCounter {
+	std::atomic<size_t> allocations;
+	std::atomic<size_t> liveBytes;
+};
+HookCounter gHook;
+
+void* countingAllocate(size_t _size, void* _user) {
+	HookCounter& counter = *static_cast<HookCounter*>(_user);
+	++counter.allocations;
+	counter.liveBytes += _size;
+	return ::operator new(_size);
 }
 
-void operator delete[](void* _ptr) {
-	--gDeleteCount;
-	return free(_ptr);
+void countingDeallocate(void* _p, size_t _size, void* _user) {
+	static_cast<HookCounter*>(_user)->liveBytes -= _size;
+	::operator delete(_p);
 }
 
-bool isMemoryBalanced() {
-	return gNewCount == gDeleteCount;
-}*/
+// Output that discards everything, so streams don't allocate while serializing
+struct NullBuffer : std::streambuf {
+	int overflow(int _c) override { return _c; }
+};
 //----------------------------------------------------------------------------------------------------------------------
 void testMemoryLeaks() {
 	Json j;
@@ -76,6 +114,379 @@ void testMemoryLeaks() {
 			})");
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Destroying or copying very deep trees must not overflow the stack
+void testDeepTrees() {
+	const int cDepth = 1000000;
+	Json deep;
+	Json* node = &deep;
+	for(int i = 0; i < cDepth; ++i)
+		node = &(*node)["next"];
+	*node = 42;
+
+	Json copy(deep);
+	node = &copy;
+	for(int i = 0; i < cDepth; ++i)
+		node = &(*node)["next"];
+	assert(*node == 42);
+	deep.setNull(); // Destroys the original
+	copy = Json(); // Destroys the copy
+
+	std::string nested = std::string(cDepth, '[') + std::string(cDepth, ']');
+	Parser parser(nested.c_str());
+	parser.setMaxDepth(cDepth);
+	assert(parser.parse(deep));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Nodes created by a deep copy share a single allocation. They must still behave as independent nodes.
+void testCopiedNodes() {
+	Json original;
+	assert(original.parse(R"({"a":[1,2,{"b":"text"}], "c":{"d":true}, "e":3.5})"));
+	Json* copy = new Json(original);
+	assert(*copy == original);
+
+	// Mutating and dropping parts of the copy leaves the original intact
+	(*copy)["a"](2) = "replaced";
+	(*copy)["c"] = 7;
+	assert(original["a"](2)["b"] == "text");
+	assert(original["c"]["d"].isBool());
+
+	// Parts of the copy outlive the rest of it
+	Json a = (*copy)["a"];
+	Json e = std::move((*copy)["e"]);
+	delete copy;
+	assert(a.size() == 3);
+	assert(a(2) == "replaced");
+	assert(e == 3.5f);
+
+	// Assigning from a descendant
+	Json tree = original;
+	tree = tree["a"];
+	assert(tree.isArray() && tree.size() == 3);
+	tree = std::move(tree(2));
+	assert(tree["b"] == "text");
+	Json self = original;
+	self = self;
+	assert(self == original);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testSharedContent() {
+	Json original;
+	assert(original.parse(R"({"a":{"b":[1,2,3],"c":"text"}, "d":{"e":false}})"));
+	const Json& constOriginal = original;
+
+	// Copies share all of their content
+	Json copy = original;
+	const Json& constCopy = copy;
+	assert(&constCopy["a"]["b"](1) == &constOriginal["a"]["b"](1));
+
+	// Modifying a deep element only clones the containers on the path to it
+	copy["a"]["b"](1) = 20;
+	assert(original["a"]["b"](1) == 2);
+	assert(constCopy["a"]["b"](1) == 20);
+	assert(&constCopy["d"]["e"] == &constOriginal["d"]["e"]);
+	assert(&constCopy["a"]["c"] != &constOriginal["a"]["c"]);
+	assert(constCopy["a"]["c"] == "text");
+
+	// Copies handed to other threads can be modified and destroyed concurrently
+	std::vector<std::thread> threads;
+	for(int t = 0; t < 4; ++t) {
+		threads.emplace_back([t, &constOriginal]() {
+			for(int i = 0; i < 1000; ++i) {
+				Json local = constOriginal;
+				local["a"]["b"].push_back(t);
+				local["d"]["f"] = i;
+				assert(local["a"]["b"].size() == 4);
+				assert(local["a"]["c"] == "text");
+			}
+		});
+	}
+	for(auto& thread : threads)
+		thread.join();
+	assert(original["a"]["b"].size() == 3);
+	assert(!original["d"].contains("f"));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testReferencesAcrossCopies() {
+	// A reference taken before a copy must not reach into the copy
+	Json e;
+	assert(e.parse(R"({"k":1, "n":{"x":[1,2]}})"));
+	Json& r = e["k"];
+	Json f = e;
+	r = 5;
+	assert(e["k"] == 5 && f["k"] == 1);
+
+	// Deeper, and through iterators
+	Json& x = e["n"]["x"];
+	Json::iterator element = x.begin();
+	Json g = e;
+	*element = 10;
+	x.push_back(3);
+	const Json& constG = g;
+	assert(constG["n"]["x"].size() == 2 && constG["n"]["x"](0) == 1);
+	assert(e["n"]["x"].size() == 3 && e["n"]["x"](0) == 10);
+
+	// The copy itself has handed out nothing, so copies of it share again
+	Json h = g;
+	const Json& constH = h;
+	assert(&constH["n"]["x"](0) == &constG["n"]["x"](0));
+
+	// Trees built through references are cloned without recursion, however deep they are
+	Json deep;
+	Json* level = &deep;
+	for(int i = 0; i < 100000; ++i)
+		level = &(*level)["a"];
+	*level = 1;
+	Json deepCopy = deep;
+	*level = 2;
+	const Json* copied = &deepCopy;
+	while(copied->isObject())
+		copied = &(*copied)["a"];
+	assert(*copied == 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testParseContext() {
+	std::string big = "[";
+	for(int i = 0; i < 1000; ++i)
+		big += (i ? ",{\"id\":" : "{\"id\":") + std::to_string(i) + ",\"tags\":[\"a\",\"b\"]}";
+	big += "]";
+
+	ParseContext context;
+	Json doc;
+	assert(context.parse(big.c_str(), doc));
+	assert(doc.size() == 1000 && doc(999)["tags"](1) == "b");
+	assert(context.reservedNodes() == 0);
+	// Nodes of a destroyed document are kept for the next one
+	doc.setNull();
+	size_t reserved = context.reservedNodes();
+	assert(reserved > 0);
+	assert(context.parse(big.c_str(), doc));
+	assert(context.reservedNodes() < reserved);
+	Json same;
+	assert(same.parse(big.c_str()));
+	assert(doc == same);
+
+	// Pooled nodes behave like any other
+	Json copy = doc;
+	copy(3)["id"] = "changed";
+	copy(4) = Json();
+	assert(doc(3)["id"] == 3);
+	doc(5)["tags"].push_back("c");
+	assert(same(5)["tags"].size() == 2);
+
+	// Documents that fill blocks exactly
+	for(int i = 0; i < 1000; ++i) {
+		Json small;
+		assert(context.parse("[1,2,3,4]", small));
+		assert(small(3) == 4);
+	}
+
+	// Errors, and input read from streams, one document after another
+	assert(!context.parse("[1, tru]", doc));
+	assert(context.error().code == ParseErrorCode::invalidLiteral);
+	assert(doc.isNull());
+	std::stringstream stream("{\"a\":1} [2] 3");
+	assert(context.parse(stream, doc) && doc["a"] == 1);
+	assert(context.parse(stream, doc) && doc(0) == 2);
+	assert(context.parse(stream, doc) && doc == 3);
+	assert(context.error().code == ParseErrorCode::none);
+	context.reset();
+	assert(context.parse("[true]]]", 6, doc) && doc(0) == true);
+
+	// Documents outlive the context, and can be destroyed from other threads
+	std::vector<Json> docs(4);
+	{
+		ParseContext shortLived;
+		for(Json& d : docs)
+			assert(shortLived.parse(big.c_str(), d));
+		shortLived.releaseMemory();
+		assert(shortLived.reservedNodes() == 0);
+	}
+	std::vector<std::thread> threads;
+	for(Json& d : docs)
+		threads.emplace_back([&d]() { d.setNull(); });
+	for(auto& thread : threads)
+		thread.join();
+	assert(copy(999)["tags"](0) == "a");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string records(int _count) {
+	std::string text = "[";
+	for(int i = 0; i < _count; ++i)
+		text += (i ? ",{\"id\":" : "{\"id\":") + std::to_string(i) + ",\"name\":\"record\",\"tags\":[\"a\",\"b\"]}";
+	return text + "]";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testAllocationBudgets() {
+	const int cRecords = 1000;
+	std::string text = records(cRecords);
+	ParseContext context;
+	Json doc;
+	assert(context.parse(text.c_str(), doc));
+	doc.setNull(); // Warm up the pool
+	// Pooled nodes: a container, its storage and one map node per member, for each record
+	{
+		AllocationCounter parse;
+		assert(context.parse(text.c_str(), doc));
+		assert(parse.news() <= 7 * cRecords + 64);
+	}
+	// Each node allocated on its own
+	{
+		AllocationCounter parse;
+		Json plain;
+		assert(plain.parse(text.c_str()));
+		assert(plain == doc);
+		assert(parse.news() <= 13 * cRecords + 64);
+		plain.setNull();
+		assert(parse.live() == 0);
+	}
+	// Copies share everything, and modifying them only clones the path to the change
+	{
+		AllocationCounter copy;
+		Json shallow = doc;
+		assert(copy.news() == 0);
+		shallow(500)["tags"](1) = "c";
+		assert(copy.news() <= 16);
+	}
+	// Serializing doesn't allocate, other than what the stream does
+	{
+		NullBuffer discard;
+		std::ostream out(&discard);
+		AllocationCounter serialize;
+		assert(doc.serialize(out));
+		assert(serialize.news() == 0);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testAllocatorHook() {
+	std::string text = records(100) + R"([{"a long string, stored out of line": "and a long value too"}, 1.5, [1, 2]])";
+	Allocator counting = { countingAllocate, countingDeallocate, &gHook };
+	setAllocator(counting);
+	assert(getAllocator().user == &gHook);
+	{
+		Json doc;
+		assert(doc.parse(text.c_str()));
+		assert(gHook.allocations > 0);
+		MemoryStats stats = doc.memoryStats();
+#ifdef __GLIBCXX__ // Where the size of the nodes of a map is known
+		assert(gHook.liveBytes == stats.totalBytes() - stats.keyBytes); // Keys are std::strings
+#endif
+		Json copy = doc;
+		copy(1) = "changed";
+		Json* node = new Json(copy);
+		assert(gHook.liveBytes > stats.totalBytes() - stats.keyBytes);
+		delete node;
+	}
+	assert(gHook.liveBytes == 0);
+
+	// Values allocated by a counting allocator can be freed by the default one it forwards to, and the other way around
+	Json before;
+	assert(before.parse(text.c_str()));
+	setAllocator(Allocator());
+	assert(getAllocator().user == nullptr);
+	Json after;
+	assert(after.parse(text.c_str()));
+	setAllocator(counting);
+	after.setNull();
+	setAllocator(Allocator());
+	before.setNull();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testMemoryStats() {
+	Json doc;
+	assert(doc.parse(R"({"n":null, "b":[true, false], "i":1, "r":[1.5, 2.5], "s":"short",
+		"l":"a string that doesn't fit inline", "a key that doesn't fit inline":{}})"));
+	MemoryStats stats = doc.memoryStats();
+	assert(stats.nulls == 1 && stats.booleans == 0 && stats.integers == 1 && stats.reals == 0 && stats.strings == 2);
+	assert(stats.arrays == 2 && stats.objects == 2 && stats.packedNumbers == 2 && stats.packedBooleans == 2);
+	assert(stats.sharedContainers == 0 && stats.nodes() == 8);
+	assert(stats.nodeBytes == 7 * sizeof(Json));
+	assert(stats.stringBytes > 32 && stats.keyBytes > 29 && stats.containerBytes > 0);
+	assert(stats.totalBytes() == stats.nodeBytes + stats.stringBytes + stats.containerBytes + stats.keyBytes);
+
+	// Nodes of packed arrays only exist once something asks for them
+	assert(doc["r"](0) == 1.5f);
+	MemoryStats unpacked = doc.memoryStats();
+	assert(unpacked.packedNumbers == 0 && unpacked.reals == 2 && unpacked.nodeBytes == 9 * sizeof(Json));
+
+	// Shared content is counted once
+	doc["copy"] = doc["b"];
+	MemoryStats shared = doc.memoryStats();
+	assert(shared.sharedContainers == 1 && shared.arrays == 3 && shared.packedBooleans == 2);
+	assert(shared.containerBytes > unpacked.containerBytes); // One more member
+
+	// Simple values and deep trees
+	assert(Json().memoryStats().nulls == 1 && Json().memoryStats().totalBytes() == 0);
+	const int cDepth = 100000;
+	std::string nested = std::string(cDepth, '[') + std::string(cDepth, ']');
+	Parser parser(nested.c_str());
+	parser.setMaxDepth(cDepth);
+	assert(parser.parse(doc));
+	stats = doc.memoryStats();
+	assert(stats.arrays == cDepth && stats.nodeBytes == (cDepth - 1) * sizeof(Json));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testAllocationCounters() {
+	const int cRecords = 100;
+	std::string text = records(cRecords);
+	AllocationCounters start = allocationCounters();
+	Json doc;
+	assert(doc.parse(text.c_str()));
+	AllocationCounters parse = allocationCounters() - start;
+	assert(parse.allocations >= 2 * cRecords && parse.allocations <= 13 * cRecords + 64);
+	MemoryStats stats = doc.memoryStats();
+#ifdef __GLIBCXX__ // Where the size of the nodes of a map is known
+	assert(parse.allocatedBytes - parse.freedBytes == stats.totalBytes() - stats.keyBytes); // Keys are std::strings
+#endif
+
+	// Copies share everything, and modifying them only clones the path to the change
+	AllocationCounters before = allocationCounters();
+	Json copy = doc;
+	assert((allocationCounters() - before).allocations == 0);
+	copy(50)["name"] = "changed";
+	AllocationCounters modify = allocationCounters() - before;
+	assert(modify.allocations > 0 && modify.allocations <= 8);
+
+	// Serializing allocates nothing for the document
+	NullBuffer discard;
+	std::ostream out(&discard);
+	before = allocationCounters();
+	assert(doc.serialize(out));
+	AllocationCounters serialize = allocationCounters() - before;
+	assert(serialize.allocations == 0 && serialize.deallocations == 0);
+
+	// Everything is given back
+	before = allocationCounters();
+	copy.setNull();
+	doc.setNull();
+	AllocationCounters release = allocationCounters() - before;
+	assert(release.deallocations == parse.allocations + modify.allocations - parse.deallocations);
+
+	// Published documents built through references are cloned once, and loading them allocates nothing
+	Json built;
+	for(int i = 0; i < 1000; ++i)
+		built[std::to_string(i)] = i;
+	SharedJson shared;
+	shared.store(std::move(built));
+	before = allocationCounters();
+	for(int i = 0; i < 100; ++i) {
+		FrozenJson snapshot = shared.load();
+		FrozenJson again = snapshot;
+		assert(int(again["999"]) == 999);
+	}
+	assert((allocationCounters() - before).allocations == 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
 int main(int, const char**)
 {
 	// Force creation and destruction by making a local scope
@@ -83,6 +494,15 @@ int main(int, const char**)
 	_CrtDumpMemoryLeaks();
 	#endif // _DEBUG && _WIN32
 	testMemoryLeaks();
+	testDeepTrees();
+	testCopiedNodes();
+	testSharedContent();
+	testReferencesAcrossCopies();
+	testParseContext();
+	testAllocationBudgets();
+	testAllocatorHook();
+	testMemoryStats();
+	testAllocationCounters();
 	#if defined( _DEBUG ) && defined(_WIN32)
 	_CrtDumpMemoryLeaks();
 	#endif // _DEBUG && _WIN32
@@ -0,0 +1,152 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Reading arrays of records into columns
+#include <cassert>
+#include <cjson/columns.h>
+#include <cjson/parser.h>
+#include <string>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+void testColumns();
+void testBatches();
+void testErrors();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testColumns();
+	testBatches();
+	testErrors();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+vector<Column> makeColumns() {
+	return {
+		Column("ts", Column::Type::int64),
+		Column("v", Column::Type::real),
+		Column("ok", Column::Type::boolean),
+		Column("name", Column::Type::text),
+		Column("pos.x", Column::Type::real),
+		Column("pos", Column::Type::text),
+	};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testColumns() {
+	vector<Column> columns = makeColumns();
+	Parser parser(R"([
+		{"ts": 1000000000000, "v": 1.5, "ok": true, "name": "first", "pos": {"x": 3, "y": 4}},
+		{"v": 2, "skip": {"deep": [1, {"a": "b\"}"}, [], {}], "more": null}, "name": "", "ts": -5, "ok": false},
+		null,
+		{"ts": null, "v": null, "pos": null, "extra": [true, false, -1.5, "x"]},
+		{"name": "café", "pos": "label", "name": "last"}
+	])");
+	assert(parser.readColumns(columns));
+	for(const Column& column : columns)
+		assert(column.size() == 5);
+
+	const Column& ts = columns[0];
+	assert(ts.integers()[0] == 1000000000000ll && ts.integers()[1] == -5);
+	assert(!ts.isNull(0) && !ts.isNull(1) && ts.isNull(2) && ts.isNull(3) && ts.isNull(4));
+	assert(ts.validity().size() == 1 && ts.validity()[0] == 0x3);
+
+	const Column& v = columns[1];
+	assert(v.reals()[0] == 1.5 && v.reals()[1] == 2.0 && v.reals()[3] == 0.0);
+	assert(v.isNull(3));
+
+	const Column& ok = columns[2];
+	assert(ok.booleans()[0] == 1 && ok.booleans()[1] == 0 && ok.isNull(4));
+
+	const Column& name = columns[3];
+	assert(name.text(0) == "first" && name.text(1) == "" && !name.isNull(1) && name.isNull(2));
+	assert(name.text(4) == "last"); // Repeated keys keep the last value
+	assert(name.offsets().size() == 6 && name.characters() == "firstlast");
+
+	const Column& x = columns[4];
+	assert(x.reals()[0] == 3.0 && x.isNull(1) && x.isNull(3) && x.isNull(4));
+	const Column& pos = columns[5];
+	assert(pos.isNull(0) && pos.text(4) == "label");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rows of several documents are appended
+void testBatches() {
+	vector<Column> columns = { Column("id", Column::Type::int64) };
+	for(int batch = 0; batch < 3; ++batch) {
+		string text = "[";
+		for(int i = 0; i < 10; ++i)
+			text += "{\"id\":" + to_string(batch * 10 + i) + ",\"payload\":[" + string(i, '1') + "0]},";
+		text += "]";
+		Parser parser(text.c_str());
+		assert(parser.readColumns(columns));
+	}
+	assert(columns[0].size() == 30);
+	for(size_t i = 0; i < 30; ++i)
+		assert(columns[0].integers()[i] == int64_t(i));
+	assert(columns[0].validity().size() == 4 && columns[0].validity()[3] == 0x3f);
+	columns[0].clear();
+	assert(columns[0].size() == 0 && columns[0].validity().empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testErrors() {
+	const pair<const char*, ParseErrorCode> cBad[] = {
+		{ R"({"ts":1})", ParseErrorCode::typeMismatch },
+		{ R"([{"ts":1.5}])", ParseErrorCode::typeMismatch },
+		{ R"([{"ts":"1"}])", ParseErrorCode::typeMismatch },
+		{ R"([{"name":1}])", ParseErrorCode::typeMismatch },
+		{ R"([{"ok":1}])", ParseErrorCode::typeMismatch },
+		{ R"([{"pos":{"x":true}}])", ParseErrorCode::typeMismatch },
+		{ R"([1])", ParseErrorCode::typeMismatch },
+		{ R"([{"ts":1}, {"other":[1}])", ParseErrorCode::unexpectedCharacter },
+		{ R"([{"ts":1}, {"other":tru}])", ParseErrorCode::invalidLiteral },
+		{ R"([{"ts":1}, {"other":"unterminated)", ParseErrorCode::unexpectedEnd },
+		{ R"([{"ts":1}, {"ts":2})", ParseErrorCode::unexpectedEnd },
+	};
+	for(const auto& bad : cBad) {
+		vector<Column> columns = makeColumns();
+		Parser good(R"([{"ts":1, "name":"a", "pos":{"x":1}}])");
+		assert(good.readColumns(columns));
+		Parser parser(bad.first);
+		assert(!parser.readColumns(columns));
+		assert(parser.error().code == bad.second);
+		// The rows of the failed document are gone
+		for(const Column& column : columns)
+			assert(column.size() == 1);
+		assert(columns[0].validity()[0] == 1 && columns[3].characters() == "a" && columns[3].offsets().size() == 2);
+	}
+
+	// Skipped values still respect the depth limit
+	vector<Column> columns = makeColumns();
+	string deep = "[{\"skip\":" + string(100, '[') + string(100, ']') + "}]";
+	Parser parser(deep.c_str());
+	parser.setMaxDepth(50);
+	assert(!parser.readColumns(columns));
+	assert(parser.error().code == ParseErrorCode::depthLimitExceeded);
+}
\ No newline at end of file
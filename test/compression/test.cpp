@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Streaming compression and decompression
+#include <cassert>
+#include <cjson/compression.h>
+#include <cjson/json.h>
+#include <cjson/parser.h>
+#include <cjson/serializer.h>
+#include <sstream>
+#include <string>
+
+using namespace cjson;
+using namespace std;
+
+void testRoundTrip(Compression _format);
+void testDocumentSequence(Compression _format);
+void testCorruptInput(Compression _format);
+void testFlush(Compression _format);
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	for(Compression format : { Compression::none, Compression::gzip, Compression::zstd }) {
+		if(!compressionSupported(format)) {
+			// Streams in formats the library wasn't built with fail right away
+			stringstream compressed;
+			CompressingStream out(compressed, format);
+			assert(!out && out.error());
+			DecompressingStream in(compressed, format);
+			assert(!in && in.error());
+			continue;
+		}
+		testRoundTrip(format);
+		testDocumentSequence(format);
+		testCorruptInput(format);
+		testFlush(format);
+	}
+	// Data that isn't compressed is passed through when the format is detected
+	stringstream plain("[1, 2, 3]");
+	DecompressingStream in(plain);
+	Json j;
+	assert(j.parse(in) && j.size() == 3);
+	assert(in.format() == Compression::none);
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Several blocks of compressed and uncompressed data
+Json makeDocument() {
+	Json document;
+	for(int i = 0; i < 20000; ++i) {
+		Json record;
+		record["id"] = i;
+		record["name"] = "record " + to_string(i);
+		record["price"] = float(i) + 0.5f;
+		record["tags"].push_back("compressed");
+		record["tags"].push_back(i % 3 == 0);
+		document.push_back(record);
+	}
+	return document;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+string compress(const string& _plain, Compression _format) {
+	stringstream compressed;
+	CompressingStream out(compressed, _format);
+	out.write(_plain.data(), streamsize(_plain.size()));
+	assert(out.close());
+	return compressed.str();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testRoundTrip(Compression _format) {
+	Json document = makeDocument();
+	string plain = document.serialize();
+	assert(plain.size() > 1000000);
+
+	// Serialize straight into a compressed stream
+	stringstream compressed;
+	{
+		CompressingStream out(compressed, _format);
+		Serializer serializer;
+		assert(serializer.serialize(document, out));
+		assert(out.close() && !out.error());
+		assert(!(out << "late")); // Nothing can be written once closed
+	}
+	string data = compressed.str();
+	if(_format == Compression::none)
+		assert(data == plain);
+	else
+		assert(data.size() < plain.size() / 4);
+
+	// And parse straight from it, with the format given or detected
+	for(Compression format : { _format, Compression::automatic }) {
+		stringstream source(data);
+		DecompressingStream in(source, format);
+		Json parsed;
+		assert(parsed.parse(in));
+		assert(parsed == document);
+		assert(in.format() == _format && !in.error());
+	}
+
+	// Decompressing by hand gives back the serialized text
+	stringstream source(data);
+	DecompressingStream in(source);
+	stringstream decompressed;
+	decompressed << in.rdbuf();
+	assert(decompressed.str() == plain);
+
+	// Small writes, and members or frames one after another
+	string parts = compress("[1, ", _format) + compress("2, 3]", _format);
+	stringstream concatenated(parts);
+	DecompressingStream joined(concatenated);
+	Json j;
+	assert(j.parse(joined) && j.size() == 3 && int(j(2)) == 3);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Parsers read ahead of the end of each document, and give back what they didn't use by seeking the stream back
+void testDocumentSequence(Compression _format) {
+	string plain;
+	for(int i = 0; i < 2000; ++i)
+		plain += "{\"n\": " + to_string(i) + ", \"padding\": \"some text to fill the blocks up\"}\n";
+	stringstream source(compress(plain, _format));
+	DecompressingStream in(source);
+	for(int i = 0; i < 2000; ++i) {
+		Json j;
+		assert(j.parse(in));
+		assert(int(j["n"]) == i);
+	}
+
+	// Errors are located in the uncompressed text
+	string broken = plain + "{\"n\": tru}";
+	stringstream brokenSource(compress(broken, _format));
+	DecompressingStream brokenIn(brokenSource);
+	Parser parser(brokenIn);
+	Json j;
+	for(int i = 0; i < 2000; ++i)
+		assert(parser.parse(j));
+	assert(!parser.parse(j));
+	assert(parser.error().code == ParseErrorCode::invalidLiteral);
+	assert(parser.error().offset == broken.size() - 4);
+	assert(parser.error().context.substr(parser.error().contextOffset, 3) == "tru");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testCorruptInput(Compression _format) {
+	if(_format == Compression::none)
+		return;
+	string data = compress(makeDocument().serialize(), _format);
+
+	// Truncated
+	stringstream truncated(data.substr(0, data.size() / 2));
+	DecompressingStream in(truncated, _format);
+	Json j;
+	assert(!j.parse(in));
+	assert(in.error());
+
+	// Damaged in the middle. Checksums may only catch it at the end.
+	string damaged = data;
+	for(size_t i = damaged.size() / 2; i < damaged.size() / 2 + 64; ++i)
+		damaged[i] = char(damaged[i] ^ 0x5a);
+	stringstream damagedSource(damaged);
+	DecompressingStream damagedIn(damagedSource, _format);
+	stringstream decompressed;
+	decompressed << damagedIn.rdbuf();
+	assert(damagedIn.error());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Flushing makes what was written so far readable, before the stream is closed
+void testFlush(Compression _format) {
+	stringstream compressed;
+	CompressingStream out(compressed, _format);
+	out << "[1, 2, 3]";
+	out.flush();
+	stringstream partial(compressed.str());
+	DecompressingStream in(partial, _format);
+	string text;
+	getline(in, text);
+	assert(text == "[1, 2, 3]");
+	assert(out.tellp() == streampos(9));
+	out << "[4]";
+	assert(out.close());
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Hashing and equality of Json values
+#include <cassert>
+#include <cjson/json.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace cjson;
+using namespace std;
+
+void testHash();
+void testInvalidation();
+void testContainers();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testHash();
+	testInvalidation();
+	testContainers();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testHash() {
+	const char* cDocuments[] = {
+		"null", "true", "false", "0", "1", "1.0", "-0.0", "\"\"", "\"1\"", "[]", "{}", "[1]", "[[1]]", "[1,2]", "[2,1]",
+		R"({"a":1})", R"({"a":2})", R"({"b":1})", R"({"a":1,"b":[true,null]})", R"({"a":{"b":{}}})",
+	};
+	for(const char* a : cDocuments) {
+		for(const char* b : cDocuments) {
+			Json x, y;
+			assert(x.parse(a) && y.parse(b));
+			bool equal = x == y;
+			assert(equal == (a == b));
+			if(equal)
+				assert(x.hash() == y.hash());
+			// Equality gives the same answer with cached hashes
+			x.hash();
+			y.hash();
+			assert((x == y) == equal);
+		}
+	}
+	// Key order in the input doesn't matter
+	Json x, y;
+	assert(x.parse(R"({"a":1,"b":2})") && y.parse(R"({"b":2,"a":1})"));
+	assert(x.hash() == y.hash());
+	assert(x.parse(R"({"ab":1})") && y.parse(R"({"a":1})"));
+	assert(x.hash() != y.hash());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Cached hashes follow modifications
+void testInvalidation() {
+	Json document;
+	assert(document.parse(R"({"a":{"b":[1,2,3]}, "c":"text"})"));
+	Json copy = document;
+	size_t original = document.hash();
+	assert(copy.hash() == original);
+
+	copy["a"]["b"](1) = 20;
+	assert(copy.hash() != original);
+	assert(document.hash() == original);
+	assert(!(copy == document));
+	copy["a"]["b"](1) = 2;
+	assert(copy.hash() == original);
+	assert(copy == document);
+
+	copy["a"]["b"].push_back(4);
+	assert(copy.hash() != original);
+	for(auto& element : copy["a"]["b"])
+		element = 0;
+	Json zeros;
+	assert(zeros.parse(R"({"a":{"b":[0,0,0,0]}, "c":"text"})"));
+	assert(copy == zeros);
+	assert(copy.hash() == zeros.hash());
+
+	Json patch;
+	assert(patch.parse(R"([{"op":"replace", "path":"/a/b", "value":[1,2,3]}])"));
+	assert(copy.applyPatch(patch));
+	assert(copy.hash() == original && copy == document);
+	assert(patch.parse(R"({"c":null})"));
+	copy.mergePatch(patch);
+	assert(copy.hash() != original);
+
+	// References taken before hashing can still change the document
+	Json held, expected;
+	assert(held.parse(R"({"k":{"x":1}, "y":[1,2]})") && expected.parse(R"({"k":{"x":5}, "y":[7,2]})"));
+	Json& x = held["k"]["x"];
+	Json::iterator y = held["y"].begin();
+	assert(held.hash() != expected.hash() && !(held == expected));
+	x = 5;
+	*y = 7;
+	assert(held.hash() == expected.hash());
+	assert(held == expected && expected == held);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testContainers() {
+	const char* cRecords[] = {
+		R"({"id":1, "tags":["a","b"]})", R"({"tags":["a","b"], "id":1})", R"({"id":2, "tags":["a","b"]})",
+	};
+	unordered_set<Json> unique;
+	for(const char* text : cRecords) {
+		Json record;
+		assert(record.parse(text));
+		unique.insert(record);
+	}
+	unique.insert(Json("text"));
+	unique.insert(Json(1));
+	unique.insert(Json(1.f));
+	assert(unique.size() == 5);
+	Json key;
+	assert(key.parse(R"({"id":2, "tags":["a","b"]})"));
+	assert(unique.count(key) == 1);
+	assert(key.parse(R"({"id":3, "tags":["a","b"]})"));
+	assert(unique.count(key) == 0);
+
+	unordered_map<Json, int> counts;
+	for(const char* text : { "[1,2]", "[1,2]", "{}", "[2,1]", "[1,2]" }) {
+		assert(key.parse(text));
+		++counts[key];
+	}
+	assert(counts.size() == 3);
+	assert(key.parse("[1,2]") && counts[key] == 3);
+	assert(key.parse("{}") && counts[key] == 1);
+}
\ No newline at end of file
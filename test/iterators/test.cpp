@@ -24,6 +24,7 @@
 // Simple Json C++ library
 //----------------------------------------------------------------------------------------------------------------------
 // Hello world sample
+#include <algorithm>
 #include <cassert>
 #include <cjson/json.h>
 #include <iostream>
@@ -40,6 +41,10 @@ void foreachTest(std::string _raw, std::vector<int> _vals);
 
 void specificDictTest();
 
+void randomAccessTest();
+
+void itemsTest();
+
 int main(int, const char**)
 {
 	// Test if iterators accomplish cpp forward iterator specs.
@@ -52,6 +57,10 @@ int main(int, const char**)
 
 	// Test specific dictionary iterator
 	specificDictTest();
+
+	// Typed views
+	randomAccessTest();
+	itemsTest();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -113,3 +122,82 @@ void specificDictTest(){
 	++iterDict;
 	assert(iterDict == jDictionary.end());
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+void randomAccessTest(){
+	static_assert(std::is_same<std::iterator_traits<Json::array_view::iterator>::iterator_category,
+		std::random_access_iterator_tag>::value, "Array iterators must be random access");
+	static_assert(std::is_same<std::iterator_traits<Json::iterator>::iterator_category,
+		std::forward_iterator_tag>::value, "Generic iterators must be forward iterators");
+
+	Json json;
+	json.parse("[5, 3, 9, 1, 7]");
+	Json original = json;
+
+	// Standard algorithms that need random access
+	auto byValue = [](const Json& _a, const Json& _b) { return int(_a) < int(_b); };
+	auto elements = json.asArray();
+	assert(elements.size() == 5);
+	std::sort(elements.begin(), elements.end(), byValue);
+	const Json& sorted = json;
+	std::vector<int> values;
+	for(const Json& element : sorted.asArray())
+		values.push_back(element);
+	assert((values == std::vector<int>{ 1, 3, 5, 7, 9 }));
+	assert(original(0) == 5); // Sorting detached the copy
+
+	auto view = sorted.asArray();
+	auto found = std::lower_bound(view.begin(), view.end(), Json(7), byValue);
+	assert(found - view.begin() == 3 && *found == 7);
+	assert(view.begin()[4] == 9 && *(view.end() - 1) == 9 && *(2 + view.begin()) == 5);
+	auto it = view.end();
+	--it;
+	it -= 2;
+	assert(*it-- == 5 && *it == 3 && it > view.begin() && view.begin() <= it);
+	assert(std::distance(view.begin(), view.end()) == 5);
+
+	// Generic iterators work with the standard library too
+	std::vector<Json> copies;
+	copies.assign(original.begin(), original.end());
+	assert(copies.size() == 5 && copies[4] == 7);
+
+	// Other types give empty views
+	Json number = 3;
+	assert(number.asArray().empty() && number.asArray().begin() == number.asArray().end());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void itemsTest(){
+	// Members are proxies returned by value, which forward iterators don't allow
+	static_assert(std::is_same<std::iterator_traits<Json::object_view::iterator>::iterator_category,
+		std::input_iterator_tag>::value, "Object iterators can only be input iterators");
+
+	Json json;
+	json.parse(R"({"b":2, "a":1, "c":3})");
+	std::string keys;
+	int sum = 0;
+	for(auto member : json.items()) {
+		keys += member.key;
+		sum += int(member.value);
+		member.value = int(member.value) * 10;
+	}
+	assert(keys == "abc" && sum == 6);
+	assert(json["b"] == 20);
+
+	// A view taken before a copy only reaches the original
+	auto view = json.items();
+	Json copy = json;
+	view.begin().value() = 0;
+	assert(json["a"] == 0 && copy["a"] == 10);
+	json["a"] = 10;
+
+	const Json& constJson = json;
+	auto members = constJson.items();
+	assert(members.size() == 3);
+	auto last = members.end();
+	--last;
+	assert(last->key == "c" && last.value() == 30);
+	auto isTwenty = [](Member<const Json> _m) { return _m.value == 20; };
+	assert(std::find_if(members.begin(), members.end(), isTwenty)->key == "b");
+	assert(Json("text").items().empty());
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Json literals validated at compile time
+#include <cassert>
+#include <cjson/json.h>
+#include <cjson/literal.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+#define VALID(_text) isValidJson(_text, sizeof(_text) - 1)
+#define ERROR_AT(_text) jsonErrorOffset(_text, sizeof(_text) - 1)
+
+// Validation happens at compile time
+static_assert(VALID("0") && VALID("-0") && VALID("12") && VALID("-1.5e+3") && VALID("2E-7") && VALID("0.25"), "");
+static_assert(VALID("true") && VALID("false") && VALID("null") && VALID(" \t\r\n null \n"), "");
+static_assert(VALID(R"("plain \"escaped\" \\ \/ \b\f\n\r\t é😀")"), "");
+static_assert(VALID("[]") && VALID("{}") && VALID("[[], {}, [[1]]]") && VALID(R"({"a": {"b": [1, {"c": null}]}})"), "");
+static_assert(VALID(R"({ "a" : 1 , "b" : [ true , false ] })"), "");
+static_assert(!VALID("") && !VALID(" ") && !VALID("nul") && !VALID("nulll") && !VALID("True"), "");
+static_assert(!VALID("01") && !VALID("+1") && !VALID("1.") && !VALID(".5") && !VALID("1e") && !VALID("-"), "");
+static_assert(!VALID("[1,]") && !VALID("[1 2]") && !VALID("[,1]") && !VALID("{a: 1}") && !VALID(R"({"a" 1})"), "");
+static_assert(!VALID("[1}") && !VALID("{\"a\": 1]") && !VALID("[") && !VALID("]"), "");
+static_assert(!VALID("1 2") && !VALID("[] []"), "");
+static_assert(!VALID(R"("\x")") && !VALID(R"("\u12")") && !VALID(R"("\u12g4")"), "");
+static_assert(!VALID("\"tab\tinside\"") && !VALID("\""), "");
+static_assert(!VALID("// comment\n1") && !VALID("NaN") && !VALID("[1.5f]") && !VALID("1f"), "");
+static_assert(ERROR_AT("[1, 2]") == size_t(-1), "");
+static_assert(ERROR_AT("[1, 2,]") == 6 && ERROR_AT("{\"a\": tru}") == 9 && ERROR_AT("[1, 2") == 5, "");
+
+// Nesting is limited to 64 levels
+#define NEST8(_x) "[[[[[[[[" _x "]]]]]]]]"
+static_assert(VALID(NEST8(NEST8(NEST8(NEST8(NEST8(NEST8(NEST8(NEST8("1"))))))))), "");
+static_assert(!VALID("[" NEST8(NEST8(NEST8(NEST8(NEST8(NEST8(NEST8(NEST8("1")))))))) "]"), "");
+
+// Static documents are initialized at compile time
+static const StaticJson cConfig(CJSON_LITERAL(R"({
+	"name": "service",
+	"port": 8080,
+	"ratio": 0.5,
+	"hosts": ["alpha", "beta", "gamma"],
+	"limits": {"connections": 100, "timeout": 2.5e1, "retry": true},
+	"fallback": null
+})"));
+
+#define RECORD "{\"id\": 1, \"name\": \"a record with some text in it\", \"values\": [1, 2.5, -3e2, true, null]}"
+#define RECORDS8 RECORD ", " RECORD ", " RECORD ", " RECORD ", " RECORD ", " RECORD ", " RECORD ", " RECORD
+#define RECORDS32 RECORDS8 ", " RECORDS8 ", " RECORDS8 ", " RECORDS8
+#define RECORDS64 RECORDS32 ", " RECORDS32
+static const StaticJson cLarge(CJSON_LITERAL("[" RECORDS64 "]"));
+
+void testStaticDocuments();
+void testConcurrentFirstRead();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testStaticDocuments();
+	testConcurrentFirstRead();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testStaticDocuments() {
+	// Same content as parsing the text at run time
+	Json parsed;
+	assert(parsed.parse(cConfig.literal().text));
+	assert(*cConfig == parsed);
+	assert(string(cConfig["name"]) == "service");
+	assert(int(cConfig["port"]) == 8080);
+	assert(cConfig["hosts"].size() == 3 && string(cConfig["hosts"](2)) == "gamma");
+	assert(float(cConfig["limits"]["timeout"]) == 25.f);
+	assert(cConfig["fallback"].isNull());
+
+	// Every read returns the same document
+	assert(&cConfig.get() == &cConfig.get());
+	assert(&*cConfig == &*cConfig.get());
+
+	// Copies are independent of the static document
+	Json copy = *cConfig;
+	copy["port"] = 9090;
+	copy["hosts"].push_back("delta");
+	assert(int(cConfig["port"]) == 8080 && cConfig["hosts"].size() == 3);
+
+	assert(cLarge->size() == 64);
+	assert(string(cLarge(63)["name"]) == "a record with some text in it");
+	assert(float(cLarge(10)["values"](2)) == -300.f);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testConcurrentFirstRead() {
+	static const StaticJson cShared(CJSON_LITERAL(R"({"values": [1, 2, 3, 4], "label": "shared"})"));
+	const unsigned cThreads = 8;
+	vector<const Json*> seen(cThreads);
+	vector<thread> readers;
+	for(unsigned t = 0; t < cThreads; ++t) {
+		readers.emplace_back([&seen, t]() {
+			const Json& document = *cShared;
+			assert(document["values"].size() == 4 && string(document["label"]) == "shared");
+			seen[t] = &document;
+		});
+	}
+	for(thread& reader : readers)
+		reader.join();
+	for(const Json* document : seen)
+		assert(document == seen[0]);
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Packed storage of numeric and boolean arrays
+#include <cassert>
+#include <cjson/json.h>
+#include <cjson/parser.h>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+void testPacking();
+void testTransparentAccess();
+void testComparison();
+void testConcurrentAccess();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	testPacking();
+	testTransparentAccess();
+	testComparison();
+	testConcurrentAccess();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testPacking() {
+	Json doc;
+	assert(doc.parse(R"({"ints":[1, -2, 3], "reals":[0.5, 1.5], "mixed":[1, 2.5], "late":[1, 2, "x"], "empty":[],
+		"nested":[[1, 2], [3.5]]})"));
+	assert(doc["ints"].isPacked());
+	Span<const int> ints = doc["ints"].packedIntegers();
+	assert(ints.size() == 3 && ints[1] == -2);
+	assert(std::accumulate(ints.begin(), ints.end(), 0) == 2);
+	assert(doc["ints"].packedReals().empty());
+	Span<const float> reals = doc["reals"].packedReals();
+	assert(reals.size() == 2 && reals[1] == 1.5f);
+
+	// Anything but numbers of a single type is stored as usual
+	assert(!doc["mixed"].isPacked() && doc["mixed"](0) == 1 && doc["mixed"](1) == 2.5f);
+	assert(!doc["late"].isPacked() && doc["late"].size() == 3 && doc["late"](1) == 2 && doc["late"](2) == "x");
+	assert(!doc["empty"].isPacked() && doc["empty"].size() == 0);
+	assert(!doc["nested"].isPacked() && doc["nested"](0).isPacked() && doc["nested"](1).packedReals()[0] == 3.5f);
+	assert(!Json(3).isPacked() && Json(3).packedIntegers().empty());
+
+	// Booleans take a byte each
+	assert(doc.parse(R"([[true, false, true], [false, 1], [1, true], [true, null]])"));
+	const Json& flags = doc(0);
+	assert(flags.isPacked() && flags.packedIntegers().empty());
+	Span<const bool> booleans = flags.packedBooleans();
+	assert(booleans.size() == 3 && booleans[0] && !booleans[1] && booleans[2]);
+	assert(flags(1) == false && flags(2) == true && flags.serialize() == "[\n\ttrue,\n\tfalse,\n\ttrue\n]");
+	for(int i = 1; i < 4; ++i)
+		assert(!doc(i).isPacked() && doc(i).size() == 2);
+	assert(doc(1)(0) == false && doc(1)(1) == 1 && doc(2)(0) == 1 && doc(2)(1) == true && doc(3)(1).isNull());
+	assert(Json(1).packedBooleans().empty());
+
+	// Packing can be disabled
+	Parser parser("[1, 2, 3]");
+	parser.setArrayPacking(false);
+	Json plain;
+	assert(parser.parse(plain) && !plain.isPacked() && plain(2) == 3);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testTransparentAccess() {
+	Json doc;
+	assert(doc.parse("[10, 20, 30, 40]"));
+	const Json& constDoc = doc;
+	assert(constDoc.size() == 4);
+	assert(constDoc(2) == 30);
+	int sum = 0;
+	for(const Json& element : constDoc)
+		sum += int(element);
+	assert(sum == 100);
+	assert(constDoc.isPacked()); // Reading keeps the numbers
+	assert(constDoc.serialize() == "[\n\t10,\n\t20,\n\t30,\n\t40\n]");
+
+	// Copies share the numbers, and modifying one of them unpacks only that one
+	Json copy = doc;
+	copy(1) = "twenty";
+	assert(!copy.isPacked() && copy(1) == "twenty" && copy(3) == 40);
+	assert(doc.isPacked() && constDoc(1) == 20);
+	doc.push_back(50);
+	assert(!doc.isPacked() && doc.size() == 5 && doc(4) == 50 && doc(0) == 10);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Packed and regular arrays with the same elements are interchangeable
+void testComparison() {
+	Json packed, other, plain;
+	assert(packed.parse("[1.5, 2.5, -3.25]"));
+	assert(other.parse("[1.5, 2.5, -3.25]"));
+	Parser parser("[1.5, 2.5, -3.25]");
+	parser.setArrayPacking(false);
+	assert(parser.parse(plain));
+	assert(packed.isPacked() && other.isPacked() && !plain.isPacked());
+	assert(packed == other && packed == plain && plain == packed);
+	assert(packed.hash() == plain.hash() && packed.hash() == other.hash());
+	assert(packed.serialize() == plain.serialize());
+
+	Json ints;
+	assert(ints.parse("[1, 2, 3]"));
+	Json reals;
+	assert(reals.parse("[1.0, 2.0, 3.0]"));
+	assert(!(ints == reals)); // Types must match, like for single numbers
+	Json shorter;
+	assert(shorter.parse("[1, 2]"));
+	assert(!(ints == shorter));
+
+	Parser plainParser("[true, false, false]");
+	plainParser.setArrayPacking(false);
+	Json flags, plainFlags, otherFlags;
+	assert(flags.parse("[true, false, false]") && plainParser.parse(plainFlags));
+	assert(otherFlags.parse("[true, false, true]"));
+	assert(flags.isPacked() && !plainFlags.isPacked());
+	assert(flags == plainFlags && plainFlags == flags && flags.hash() == plainFlags.hash());
+	assert(!(flags == otherFlags) && flags.hash() != otherFlags.hash());
+	Json copy = flags;
+	copy(2) = true;
+	assert(copy == otherFlags && flags.isPacked() && flags.packedBooleans()[2] == false);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Element nodes are created by the first reader that needs them, even if several of them get there at once
+void testConcurrentAccess() {
+	std::string text = "[";
+	for(int i = 0; i < 10000; ++i)
+		text += (i ? "," : "") + std::to_string(i);
+	text += "]";
+	for(int round = 0; round < 20; ++round) {
+		Json doc;
+		assert(doc.parse(text.c_str()));
+		const Json& shared = doc;
+		std::vector<std::thread> threads;
+		for(int t = 0; t < 4; ++t) {
+			threads.emplace_back([&shared, t]() {
+				assert(shared(9999 - t) == 9999 - t);
+				assert(shared.size() == 10000);
+			});
+		}
+		for(auto& thread : threads)
+			thread.join();
+	}
+}
\ No newline at end of file
@@ -24,8 +24,14 @@
 // Simple Json C++ library
 //----------------------------------------------------------------------------------------------------------------------
 // Hello world sample
+#include <algorithm>
 #include <cassert>
+#include <cjson/columns.h>
 #include <cjson/json.h>
+#include <cjson/parseContext.h>
+#include <cjson/parser.h>
+#include <cjson/utf8.h>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -33,6 +39,14 @@
 using namespace cjson;
 using namespace std;
 
+void testEscapes();
+void testUtf8Validation();
+void testStreams();
+void testErrors();
+void testNesting();
+void testSchema();
+void testOptions();
+
 int main(int, const char**)
 {
 	// ----- Empty Json -----
@@ -59,6 +73,12 @@ int main(int, const char**)
 	assert(j.parse("-3.4"));
 	assert(float(j) == -3.4f);
 
+	// Exponents make a number real
+	assert(j.parse("1e5") && float(j) == 1e5f);
+	assert(j.parse("-2.5E-3") && float(j) == -2.5e-3f);
+	assert(j.parse("[1e+2, 3]") && float(j(0)) == 100.f && int(j(1)) == 3);
+	assert(!j.parse("1e") && !j.parse("[1e+]"));
+
 	assert(j.parse("\"3\""));
 	assert(j.isString());
 	assert(string(j) == "3");
@@ -118,4 +138,359 @@ int main(int, const char**)
 	assert(cumulative.size() == 2);
 	assert(cumulative["x"].size() == 2);
 	assert(cumulative["y"].size() == 2);
+
+	testEscapes();
+	testUtf8Validation();
+	testStreams();
+	testErrors();
+	testNesting();
+	testSchema();
+	testOptions();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testEscapes() {
+	Json j;
+	assert(j.parse(R"("a\"b\\c\/\n\t")"));
+	assert(string(j) == "a\"b\\c/\n\t");
+	assert(j.parse(R"("\u00e9\u20AC\ud83d\ude00")"));
+	assert(string(j) == "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+	assert(!j.parse(R"("\x")")); // Unknown escape
+	assert(!j.parse(R"("\ud83d")")); // Unpaired high surrogate
+	assert(j.parse(R"({"k\"ey":1})"));
+	assert(j.contains("k\"ey"));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testUtf8Validation() {
+	Json j;
+	// Validation is off by default
+	assert(j.parse("\"\xff\""));
+
+	const char* valid[] = {
+		"\"caf\xc3\xa9\"",
+		"\"\xe2\x82\xac \xf0\x9f\x98\x80\"",
+		"[\"\xed\x9f\xbf\", \"\xef\xbf\xbf\", \"\xf4\x8f\xbf\xbf\"]",
+		"{\"\xc3\xb1\":\"plain ascii text that is long enough for a few vector blocks\"}"
+	};
+	for(const char* code : valid) {
+		Parser p(code);
+		p.setUtf8Validation(true);
+		assert(p.parse(j));
+	}
+
+	// Invalid sequences, and the offset of the first invalid byte
+	struct { const char* code; size_t offset; } invalid[] = {
+		{ "\"\xff\"", 1 },
+		{ "[\"abc\xc3(\"]", 6 }, // Bad continuation
+		{ "\"\xc0\xaf\"", 1 }, // Overlong
+		{ "\"\xe0\x80\xaf\"", 2 }, // Overlong
+		{ "\"\xed\xa0\x80\"", 2 }, // Surrogate
+		{ "\"\xf4\x90\x80\x80\"", 2 }, // Above U+10FFFF
+		{ "\"\xe2\x82\"", 3 }, // Truncated by the closing quotes
+		{ "\"0123456789abcdef0123456789\x80\"", 27 }, // After a few ASCII blocks
+		{ "\"\\udc00\"", 1 } // Unpaired low surrogate escape
+	};
+	for(const auto& test : invalid) {
+		Parser p(test.code);
+		p.setUtf8Validation(true);
+		assert(!p.parse(j));
+		assert(p.error().code == ParseErrorCode::invalidUtf8);
+		assert(p.error().offset == test.offset);
+	}
+
+	// Sequences split across the parser's input blocks
+	std::string big = "\"";
+	for(int i = 0; i < 40000; ++i)
+		big += (i % 7) ? "a" : "\xc3\xa9";
+	big += "\"";
+	{
+		stringstream ss(big);
+		Parser p(ss);
+		p.setUtf8Validation(true);
+		assert(p.parse(j));
+		assert(j.size() == big.size() - 2);
+	}
+	big[big.size() - 2] = '\xc3'; // Truncate the last character
+	{
+		stringstream ss(big);
+		Parser p(ss);
+		p.setUtf8Validation(true);
+		assert(!p.parse(j));
+		assert(p.error().offset == big.size() - 1);
+	}
+
+	size_t offset = 0;
+	assert(isValidUtf8("\xc3\xa9", 2));
+	assert(!isValidUtf8("ok\xc3", 3, &offset) && offset == 3);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Hands out its content a few characters at a time and can't seek, like a pipe
+class PipeBuffer : public std::streambuf {
+public:
+	PipeBuffer(const std::string& _content, size_t _chunk) : mContent(_content), mChunk(_chunk), mRead(0) {}
+
+private:
+	int_type underflow() override {
+		if(mRead == mContent.size())
+			return traits_type::eof();
+		size_t n = min(mChunk, mContent.size() - mRead);
+		memcpy(mBuffer, mContent.data() + mRead, n);
+		mRead += n;
+		setg(mBuffer, mBuffer, mBuffer + n);
+		return traits_type::to_int_type(mBuffer[0]);
+	}
+
+	std::string	mContent;
+	size_t		mChunk;
+	size_t		mRead;
+	char		mBuffer[64];
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void testStreams() {
+	// Documents in a row, each read by a new parser. Input read ahead by one is given back for the next one.
+	for(size_t chunk : { 1, 4, 64 }) {
+		PipeBuffer pipe("[1,2] {\"x\":3}", chunk);
+		istream in(&pipe);
+		Json first, second;
+		{
+			Parser p(in);
+			assert(p.parse(first));
+		}
+		assert(!in.fail());
+		{
+			Parser p(in);
+			assert(p.parse(second));
+		}
+		assert(first.size() == 2 && int(first(1)) == 2);
+		assert(int(second["x"]) == 3);
+		assert(!in.fail());
+	}
+
+	// And by the same parser
+	PipeBuffer pipe("true 12 \"end\"", 3);
+	istream in(&pipe);
+	Parser p(in);
+	Json j;
+	assert(p.parse(j) && bool(j));
+	assert(p.parse(j) && int(j) == 12);
+	assert(p.parse(j) && string(j) == "end");
+	assert(!p.parse(j));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testErrors() {
+	Json j;
+	ParseError error;
+	assert(j.parse("[1, 2]", error));
+	assert(!error);
+
+	assert(!j.parse("{\n\t\"a\": 1,\n\t\"b\": tru\n}", error));
+	assert(j.isNull());
+	assert(error.code == ParseErrorCode::invalidLiteral);
+	assert(error.offset == 17);
+	assert(error.line == 3);
+	assert(error.column == 7);
+	assert(error.context.substr(error.contextOffset, 3) == "tru");
+	assert(error.message() == "line 3, column 7: invalid literal");
+
+	// Errors in object values are no longer ignored
+	assert(!j.parse(R"({"a": })", error));
+	assert(error.code == ParseErrorCode::unexpectedCharacter);
+	assert(error.offset == 6);
+	assert(!j.parse(R"({"a" 1})", error));
+	assert(error.code == ParseErrorCode::missingColon);
+	assert(!j.parse(R"([1, 2)", error));
+	assert(error.code == ParseErrorCode::unexpectedEnd);
+	assert(error.offset == 5);
+	assert(!j.parse("-", error));
+	assert(error.code == ParseErrorCode::invalidNumber);
+	assert(!j.parse(R"("\q")", error));
+	assert(error.code == ParseErrorCode::invalidEscape);
+	assert(error.offset == 1);
+
+	// Errors far into a stream are located by rereading the input
+	std::string big = "[\n";
+	for(int i = 0; i < 5000; ++i)
+		big += "\t\"some padding to fill several blocks\",\n";
+	big += "\t?\n]";
+	stringstream ss(big);
+	assert(!j.parse(ss, error));
+	assert(error.code == ParseErrorCode::unexpectedCharacter);
+	assert(error.offset == big.size() - 3);
+	assert(error.line == 5002);
+	assert(error.column == 2);
+	assert(error.context[error.contextOffset] == '?');
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testNesting() {
+	Json j;
+	assert(j.parse(R"({"a":[1,{"b":[[],{}]},[2,3]],"c":{"d":{}}})"));
+	assert(j["a"].size() == 3);
+	assert(j["a"](1)["b"](0).isArray());
+	assert(j["a"](1)["b"](1).isObject());
+	assert(j["a"](2)(1) == 3);
+	assert(j["c"]["d"].size() == 0);
+
+	// Deep, but within the default limit
+	std::string deep = std::string(Parser::cDefaultMaxDepth, '[') + std::string(Parser::cDefaultMaxDepth, ']');
+	assert(j.parse(deep.c_str()));
+
+	// Hostile input fails cleanly instead of overflowing the stack
+	std::string hostile = std::string(1000000, '[');
+	ParseError error;
+	assert(!j.parse(hostile.c_str(), error));
+	assert(error.code == ParseErrorCode::depthLimitExceeded);
+	assert(error.offset == Parser::cDefaultMaxDepth);
+
+	// Custom limits
+	Parser shallow("[[1]] [[[1]]]");
+	shallow.setMaxDepth(2);
+	assert(shallow.parse(j));
+	assert(j(0)(0) == 1);
+	assert(!shallow.parse(j));
+	assert(shallow.error().code == ParseErrorCode::depthLimitExceeded);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testSchema() {
+	Json sample;
+	assert(sample.parse(R"([{"id": 1, "name": "a", "price": 1.5, "tags": ["x"], "size": {"h": 1, "w": 2}}])"));
+	Schema fromSample(sample);
+	assert(fromSample.type() == Schema::Type::array);
+	Schema record = Schema::object({
+		{ "name", Schema::ofType(Schema::Type::text) },
+		{ "id", Schema::ofType(Schema::Type::integer) },
+		{ "price", Schema::ofType(Schema::Type::real) },
+	});
+	Schema explicitOrder = Schema::array(record);
+
+	// Documents that follow the schema, and ones that don't, parse just like without it
+	const char* documents[] = {
+		R"([{"id": 1, "name": "a", "price": 1.5, "tags": ["x"], "size": {"h": 1, "w": 2}}])",
+		R"([{"name": "b", "id": -25, "price": 2.0}, {"name": "c", "id": 3, "price": 0.5}])",
+		R"([{"price": 2.0, "extra": null, "id": 1234567890, "name": "d"}, {}])",
+		R"([{"id": 1.5, "name": 7, "price": "text"}, {"id": "not a number"}, 3, "x"])",
+		R"([{"id" : 12 , "name":"e", "id": 13}, {"n\u0061me": "escaped", id: 4}])",
+		R"({"id": 1})",
+	};
+	for(const char* document : documents) {
+		Json generic;
+		assert(generic.parse(document));
+		for(const Schema* schema : { &fromSample, &explicitOrder }) {
+			Json specialized;
+			Parser p(document);
+			assert(p.parse(specialized, *schema));
+			assert(specialized == generic);
+		}
+	}
+
+	// Errors are the same too
+	Json j;
+	Parser broken(R"([{"name" "a"}])");
+	assert(!broken.parse(j, explicitOrder));
+	assert(broken.error().code == ParseErrorCode::missingColon);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<class Options_>
+bool parseWith(const char* _document, Json& _dst, ParseErrorCode _error = ParseErrorCode::none) {
+	BasicParser<Options_> p(_document);
+	bool parsed = p.parse(_dst);
+	assert(p.error().code == _error);
+	return parsed;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testOptions() {
+	Json j;
+
+	// Standard input is the same for everyone
+	const char* standard = R"({"a": [1, -0, 2.5, -1e3, 0.5E+2], "b": {"c": null, "d": [true, false, "s"]}, "e": []})";
+	Json reference;
+	assert(reference.parse(standard));
+	assert(parseWith<StrictParsing>(standard, j) && j == reference);
+	assert(parseWith<LenientParsing>(standard, j) && j == reference);
+
+	// Extensions accepted by default are rejected by strict parsers
+	const char* extensions[] = {
+		"[1, 2,]", R"({"a": 1,})", "[1 2]", R"({"a": 1 "b": 2})", "{a: 1}", "+1", "01", "[-01]", "1.", "-.5", "[1.5f]",
+		"1.5f", "truex", "1 2", "\"a\tb\"", "[\"\x01\"]"
+	};
+	for(const char* document : extensions) {
+		assert(j.parse(document));
+		StrictParser p(document);
+		assert(!p.parse(j) && p.error());
+	}
+	assert(!parseWith<StrictParsing>("[1 2]", j, ParseErrorCode::missingComma));
+	assert(!parseWith<StrictParsing>("[1, 2,]", j, ParseErrorCode::unexpectedCharacter));
+	assert(!parseWith<StrictParsing>("[1,,2]", j, ParseErrorCode::unexpectedCharacter));
+	assert(!parseWith<StrictParsing>("{a: 1}", j, ParseErrorCode::unexpectedCharacter));
+	assert(!parseWith<StrictParsing>("01", j, ParseErrorCode::invalidNumber));
+	assert(!parseWith<StrictParsing>("+1", j, ParseErrorCode::invalidNumber));
+	assert(!parseWith<StrictParsing>("[1.]", j, ParseErrorCode::invalidNumber));
+
+	// Nothing is left unread after the top-level value, and strings hold no raw control characters
+	StrictParser suffixed("1.5f");
+	assert(!suffixed.parse(j) && suffixed.error().code == ParseErrorCode::invalidNumber);
+	assert(suffixed.error().offset == 3);
+	assert(!parseWith<StrictParsing>("1f", j, ParseErrorCode::invalidNumber));
+	assert(!parseWith<StrictParsing>("truex", j, ParseErrorCode::unexpectedCharacter));
+	assert(!parseWith<StrictParsing>("[1] 2", j, ParseErrorCode::unexpectedCharacter));
+	assert(parseWith<StrictParsing>(" 1.5 \r\n", j) && float(j) == 1.5f);
+	assert(!parseWith<StrictParsing>("\"a\tb\"", j, ParseErrorCode::invalidString));
+	assert(!parseWith<StrictParsing>("{\"a\x01\": 1}", j, ParseErrorCode::invalidString));
+	assert(parseWith<StrictParsing>("\"a\\tb\"", j) && std::string(j) == "a\tb");
+	assert(parseWith<DefaultParsing>("\"a\x01z\"", j) && std::string(j) == "a\x01z");
+
+	// Comments and non finite numbers need lenient parsers
+	const char* commented = "// Header\n{ /* a */ \"a\": [1, /**/ 2 // two\n], \"b\" /* before */ : 3 }// end";
+	assert(!parseWith<DefaultParsing>(commented, j, ParseErrorCode::unexpectedCharacter));
+	assert(parseWith<LenientParsing>(commented, j));
+	assert(j.size() == 2 && j["a"].size() == 2 && int(j["b"]) == 3);
+	assert(!parseWith<LenientParsing>("[1 / 2]", j, ParseErrorCode::unexpectedCharacter));
+	assert(!parseWith<LenientParsing>("[1 /* 2]", j, ParseErrorCode::unexpectedEnd));
+	assert(parseWith<LenientParsing>("[NaN, Infinity, -Infinity, 1.5]", j));
+	assert(j.size() == 4);
+	assert(float(j(0)) != float(j(0)));
+	assert(float(j(1)) > 0 && float(j(1)) * 0.5f == float(j(1)));
+	assert(float(j(2)) < 0 && float(j(2)) * 0.5f == float(j(2)));
+	assert(!parseWith<DefaultParsing>("NaN", j, ParseErrorCode::unexpectedCharacter));
+	assert(!parseWith<LenientParsing>("Infinit", j, ParseErrorCode::invalidLiteral));
+
+	// A slash right at the end of a block of a stream
+	std::string padded(16 * 1024 - 1, ' ');
+	for(const char* tail : { "/* comment */ 2", "/x" }) {
+		std::stringstream ss("[1," + padded + tail + "]");
+		LenientParser p(ss);
+		bool comment = tail[1] == '*';
+		assert(p.parse(j) == comment);
+		assert(comment ? int(j(1)) == 2 : p.error().offset == 3 + padded.size());
+	}
+
+	// Reading into C++ values and skipping follow the same policy
+	std::vector<int> values;
+	Parser loose("[1, 2,]");
+	assert(loose.read(values) && values.size() == 2);
+	StrictParser standardValues("[1, 2,]");
+	assert(!standardValues.read(values));
+	assert(standardValues.error().code == ParseErrorCode::unexpectedCharacter);
+	StrictParser trailingValues("[1, 2] 3");
+	assert(!trailingValues.read(values));
+	assert(trailingValues.error().code == ParseErrorCode::unexpectedCharacter);
+	LenientParser commentedValues("[1, // one\n 2]");
+	assert(commentedValues.read(values) && values.size() == 2);
+	std::vector<Column> columns = { Column("a", Column::Type::int64) };
+	StrictParser skipping(R"([{"a": 1, "b": [1, 2]}, {"b": [1 2], "a": 2}])");
+	assert(!skipping.readColumns(columns));
+	assert(skipping.error().code == ParseErrorCode::missingComma);
+	assert(columns[0].size() == 0);
+
+	// And so do contexts
+	BasicParseContext<StrictParsing> context;
+	assert(!context.parse("[1, 2,]", j) && context.error().code == ParseErrorCode::unexpectedCharacter);
+	assert(context.parse("[1, 2]", j) && j.size() == 2);
 }
\ No newline at end of file
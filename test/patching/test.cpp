@@ -0,0 +1,259 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// JSON Patch and merge patch
+#include <cassert>
+#include <cjson/json.h>
+#include <string>
+
+using namespace cjson;
+using namespace std;
+
+void testOperations();
+void testFailures();
+void testSharing();
+void testMergePatch();
+void testDiff();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testOperations();
+	testFailures();
+	testSharing();
+	testMergePatch();
+	testDiff();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Patches with their expected results. A null result means the patch must fail.
+struct Case {
+	const char* document;
+	const char* patch;
+	const char* result;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// Examples from RFC 6902, appendix A
+const Case cCases[] = {
+	{ R"({"foo":"bar"})", R"([{"op":"add", "path":"/baz", "value":"qux"}])", R"({"baz":"qux", "foo":"bar"})" },
+	{ R"({"foo":["bar","baz"]})", R"([{"op":"add", "path":"/foo/1", "value":"qux"}])",
+		R"({"foo":["bar","qux","baz"]})" },
+	{ R"({"baz":"qux", "foo":"bar"})", R"([{"op":"remove", "path":"/baz"}])", R"({"foo":"bar"})" },
+	{ R"({"foo":["bar","qux","baz"]})", R"([{"op":"remove", "path":"/foo/1"}])", R"({"foo":["bar","baz"]})" },
+	{ R"({"baz":"qux", "foo":"bar"})", R"([{"op":"replace", "path":"/baz", "value":"boo"}])",
+		R"({"baz":"boo", "foo":"bar"})" },
+	{ R"({"foo":{"bar":"baz", "waldo":"fred"}, "qux":{"corge":"grault"}})",
+		R"([{"op":"move", "from":"/foo/waldo", "path":"/qux/thud"}])",
+		R"({"foo":{"bar":"baz"}, "qux":{"corge":"grault", "thud":"fred"}})" },
+	{ R"({"foo":["all","grass","cows","eat"]})", R"([{"op":"move", "from":"/foo/1", "path":"/foo/3"}])",
+		R"({"foo":["all","cows","eat","grass"]})" },
+	{ R"({"baz":"qux", "foo":["a",2,"c"]})",
+		R"([{"op":"test", "path":"/baz", "value":"qux"}, {"op":"test", "path":"/foo/1", "value":2}])",
+		R"({"baz":"qux", "foo":["a",2,"c"]})" },
+	{ R"({"baz":"qux"})", R"([{"op":"test", "path":"/baz", "value":"bar"}])", nullptr },
+	{ R"({"foo":"bar"})", R"([{"op":"add", "path":"/child", "value":{"grandchild":{}}}])",
+		R"({"foo":"bar", "child":{"grandchild":{}}})" },
+	{ R"({"foo":"bar"})", R"([{"op":"add", "path":"/baz/bat", "value":"qux"}])", nullptr },
+	{ R"({"/":9, "~1":10})", R"([{"op":"test", "path":"/~01", "value":10}])", R"({"/":9, "~1":10})" },
+	{ R"({"foo":["bar"]})", R"([{"op":"add", "path":"/foo/-", "value":["abc","def"]}])",
+		R"({"foo":["bar",["abc","def"]]})" },
+	// And a few more
+	{ R"({"a":1})", R"([{"op":"add", "path":"", "value":[1]}])", R"([1])" },
+	{ R"({"a":{"b":[1,2]}})", R"([{"op":"copy", "from":"/a/b", "path":"/c"}, {"op":"add", "path":"/c/-", "value":3}])",
+		R"({"a":{"b":[1,2]}, "c":[1,2,3]})" },
+	{ R"({"a":{"b":1}})", R"([{"op":"move", "from":"/a", "path":"/a/c"}])", nullptr },
+	{ R"({"a":{"b":1}})", R"([{"op":"move", "from":"/a", "path":"/a"}])", R"({"a":{"b":1}})" },
+	{ R"([1,2])", R"([{"op":"remove", "path":"/01"}])", nullptr },
+	{ R"([1,2])", R"([{"op":"add", "path":"/3", "value":0}])", nullptr },
+	{ R"([1,2])", R"([{"op":"remove", "path":"/-"}])", nullptr },
+	{ R"({"a":1})", R"([{"op":"replace", "path":"/b", "value":0}])", nullptr },
+	{ R"({"a":1})", R"([{"op":"frobnicate", "path":"/a"}])", nullptr },
+	{ R"({"a":1})", R"([{"op":"add", "path":"/b"}])", nullptr },
+	{ R"({"a":1})", R"([{"op":"add", "path":"b", "value":0}])", nullptr },
+	{ R"({"a":1})", R"([{"op":"add", "path":"/~2", "value":0}])", nullptr },
+	{ R"({"a":1})", R"({"op":"add", "path":"/b", "value":0})", nullptr },
+	// Numbers are compared by value, whether they are written as integers or reals
+	{ R"({"a":1, "b":[1,2.5], "c":{"d":0}})",
+		R"([{"op":"test", "path":"/a", "value":1.0}, {"op":"test", "path":"/b", "value":[1.0,2.5]},
+			{"op":"test", "path":"/c", "value":{"d":-0.0}},
+			{"op":"test", "path":"", "value":{"a":1.0, "b":[1,2.5], "c":{"d":0}}}])",
+		R"({"a":1, "b":[1,2.5], "c":{"d":0}})" },
+	{ R"({"a":1})", R"([{"op":"test", "path":"/a", "value":1.5}])", nullptr },
+	{ R"({"a":1})", R"([{"op":"test", "path":"/a", "value":"1"}])", nullptr },
+	{ R"({"a":[1,2]})", R"([{"op":"test", "path":"/a", "value":[1.0]}])", nullptr },
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void testOperations() {
+	for(const Case& c : cCases) {
+		Json document, patch, expected;
+		assert(document.parse(c.document) && patch.parse(c.patch));
+		bool applied = document.applyPatch(patch);
+		assert(applied == (c.result != nullptr));
+		assert(expected.parse(applied ? c.result : c.document));
+		assert(document == expected);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Operations that already succeeded are reverted when a later one fails
+void testFailures() {
+	const char* cOriginal = R"({"list":[1,2,3], "map":{"a":"x", "b":{"c":true}}, "n":5})";
+	const char* cPatches[] = {
+		R"([{"op":"remove", "path":"/list/0"}, {"op":"add", "path":"/list/-", "value":9},
+			{"op":"remove", "path":"/map/b"}, {"op":"test", "path":"/n", "value":6}])",
+		R"([{"op":"move", "from":"/map/b/c", "path":"/list/1"}, {"op":"replace", "path":"/map", "value":null},
+			{"op":"move", "from":"/list", "path":"/n"}, {"op":"remove", "path":"/missing"}])",
+		R"([{"op":"copy", "from":"/map", "path":"/list/0"}, {"op":"add", "path":"/list/0/b/d", "value":1},
+			{"op":"add", "path":"", "value":3}, {"op":"test", "path":"", "value":4}])",
+		R"([{"op":"move", "from":"/map", "path":"/m2"}, {"op":"move", "from":"/m2/b", "path":"/b2"},
+			{"op":"add", "path":"/b2/e", "value":[]}, {"op":"remove", "path":"/m2/b"}])",
+	};
+	Json original;
+	assert(original.parse(cOriginal));
+	for(const char* text : cPatches) {
+		Json document, patch;
+		assert(document.parse(cOriginal) && patch.parse(text));
+		assert(!document.applyPatch(patch));
+		assert(document == original);
+		Json copy = original; // Same on a tree sharing its content
+		assert(!copy.applyPatch(patch));
+		assert(copy == original);
+	}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testSharing() {
+	Json original, patch;
+	assert(original.parse(R"({"a":{"b":[1,2,3]}, "c":{"d":"text"}})"));
+	const Json& constOriginal = original;
+	Json copy = original;
+	const Json& constCopy = copy;
+	assert(patch.parse(R"([{"op":"replace", "path":"/a/b/1", "value":20}])"));
+	assert(copy.applyPatch(patch));
+	assert(constOriginal["a"]["b"](1) == 2);
+	assert(constCopy["a"]["b"](1) == 20);
+	assert(&constCopy["c"]["d"] == &constOriginal["c"]["d"]); // Untouched content is still shared
+	Json copyOfPatched = copy; // Patching hands out no references, so the patched path can still be shared
+	const Json& constCopyOfPatched = copyOfPatched;
+	assert(&constCopyOfPatched["a"]["b"](1) == &constCopy["a"]["b"](1));
+
+	// Moves keep the same content instead of copying it
+	Json document;
+	assert(document.parse(R"({"from":{"big":[1,2,3]}, "to":{}})"));
+	const Json& constDocument = document;
+	const Json* element = &constDocument["from"]["big"](2);
+	assert(patch.parse(R"([{"op":"move", "from":"/from/big", "path":"/to/big"}])"));
+	assert(document.applyPatch(patch));
+	assert(&constDocument["to"]["big"](2) == element);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Examples from RFC 7386, appendix A
+void testMergePatch() {
+	const Case cMerges[] = {
+		{ R"({"a":"b"})", R"({"a":"c"})", R"({"a":"c"})" },
+		{ R"({"a":"b"})", R"({"b":"c"})", R"({"a":"b", "b":"c"})" },
+		{ R"({"a":"b"})", R"({"a":null})", R"({})" },
+		{ R"({"a":"b", "b":"c"})", R"({"a":null})", R"({"b":"c"})" },
+		{ R"({"a":["b"]})", R"({"a":"c"})", R"({"a":"c"})" },
+		{ R"({"a":"c"})", R"({"a":["b"]})", R"({"a":["b"]})" },
+		{ R"({"a":{"b":"c"}})", R"({"a":{"b":"d", "c":null}})", R"({"a":{"b":"d"}})" },
+		{ R"({"a":[{"b":"c"}]})", R"({"a":[1]})", R"({"a":[1]})" },
+		{ R"(["a","b"])", R"(["c","d"])", R"(["c","d"])" },
+		{ R"({"a":"b"})", R"(["c"])", R"(["c"])" },
+		{ R"({"a":"foo"})", R"(null)", R"(null)" },
+		{ R"({"a":"foo"})", R"("bar")", R"("bar")" },
+		{ R"({"e":null})", R"({"a":1})", R"({"e":null, "a":1})" },
+		{ R"([1,2])", R"({"a":"b", "c":null})", R"({"a":"b"})" },
+		{ R"({})", R"({"a":{"bb":{"ccc":null}}})", R"({"a":{"bb":{}}})" },
+	};
+	for(const Case& c : cMerges) {
+		Json document, patch, expected;
+		assert(document.parse(c.document) && patch.parse(c.patch) && expected.parse(c.result));
+		document.mergePatch(patch);
+		assert(document == expected);
+	}
+
+	// Members the patch doesn't mention are left shared
+	Json original, patch;
+	assert(original.parse(R"({"a":{"b":1}, "c":[1,2]})") && patch.parse(R"({"a":{"b":2}})"));
+	Json copy = original;
+	copy.mergePatch(patch);
+	assert(int(original["a"]["b"]) == 1 && int(copy["a"]["b"]) == 2);
+	const Json& constOriginal = original;
+	const Json& constCopy = copy;
+	assert(&constCopy["c"](0) == &constOriginal["c"](0));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testDiff() {
+	const pair<const char*, const char*> cPairs[] = {
+		{ R"({"a":1})", R"({"a":1})" },
+		{ R"({"a":1})", R"([1])" },
+		{ R"(3)", R"(3.5)" },
+		{ R"({"a":1, "b":{"c":[1,2,3]}, "d":"x"})", R"({"b":{"c":[1,5,3]}, "d":"x", "e":null})" },
+		{ R"({"a/b":{"~":1}})", R"({"a/b":{"~":2}})" },
+		{ R"([1,2,3,4,5])", R"([1,2,4,5])" },
+		{ R"([1,2,3])", R"([0,1,2,3])" },
+		{ R"([1,2,3])", R"([1,2,3,4,5])" },
+		{ R"([1,2,3,4,5])", R"([1,9,8,5])" },
+		{ R"([{"a":1},{"b":2}])", R"([{"a":1},{"b":3},{"c":4}])" },
+		{ R"([[1,[2]],[3]])", R"([[1,[2,0]]])" },
+		{ R"([])", R"({})" },
+	};
+	for(const auto& p : cPairs) {
+		Json from, to;
+		assert(from.parse(p.first) && to.parse(p.second));
+		Json patch = from.diff(to);
+		assert(patch.isArray());
+		assert(from.applyPatch(patch));
+		assert(from == to);
+	}
+	Json from, to;
+	assert(from.parse(R"({"a":[1,2]})") && to.parse(R"({"a":[1,2]})"));
+	assert(from.diff(to).size() == 0);
+	assert(from.parse(R"([1,2,3,4,5])") && to.parse(R"([1,2,4,5])"));
+	assert(from.diff(to).size() == 1);
+
+	// Snapshots that share most of their content only visit what changed
+	Json snapshot;
+	assert(snapshot.parse(R"({"users":[{"name":"a", "age":30},{"name":"b", "age":40}], "settings":{"theme":"dark"}})"));
+	for(int i = 0; i < 1000; ++i)
+		snapshot["log"].push_back(i);
+	Json next = snapshot;
+	next["users"](1)["age"] = 41;
+	next["settings"]["font"] = "mono";
+	size_t changes = 0;
+	snapshot.diff(next, [&changes](const Json& _operation) {
+		++changes;
+		assert(_operation["op"] == "replace" || _operation["op"] == "add");
+	});
+	assert(changes == 2);
+	Json patch = snapshot.diff(next);
+	assert(patch(0)["path"] == "/settings/font" || patch(1)["path"] == "/settings/font");
+	assert(snapshot.applyPatch(patch) && snapshot == next);
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Profiling counters and trace events
+#include <cassert>
+#include <cjson/json.h>
+#include <cjson/parser.h>
+#include <cjson/profiling.h>
+#include <cjson/serializer.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+// Records the events it receives
+struct RecordingHook : TraceHook {
+	void begin(const char* _event) override {
+		events.push_back(string("begin ") + _event);
+	}
+	void end(const char* _event, const ProfileCounters& _counters) override {
+		events.push_back(string("end ") + _event);
+		bytes.push_back(_counters.bytes);
+	}
+	vector<string> events;
+	vector<size_t> bytes;
+};
+
+const char* cDocument = R"({"name": "profile", "values": [1, 2.5, 3], "nested": {"deeper": [true, null, "text"]}})";
+
+void testCounters();
+void testTraceEvents();
+void testThreadProfile();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	testCounters();
+	testTraceEvents();
+	testThreadProfile();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testCounters() {
+	Json doc;
+	Parser parser(cDocument);
+	assert(parser.parse(doc));
+	const ProfileCounters& parsed = parser.profile();
+	stringstream out;
+	Serializer serializer;
+	assert(serializer.serialize(doc, out));
+	const ProfileCounters& serialized = serializer.profile();
+	if(!cProfilingEnabled) { // Compiled out
+		assert(parsed.calls == 0 && parsed.bytes == 0 && parsed.totalTicks() == 0);
+		assert(serialized.calls == 0 && serialized.totalTicks() == 0);
+		return;
+	}
+	assert(parsed.calls == 1 && parsed.bytes == string(cDocument).size() && parsed.maxDepth == 3);
+	assert(parsed.phaseTicks(ProfilePhase::string) > 0 && parsed.phaseTicks(ProfilePhase::number) > 0);
+	assert(parsed.phaseTicks(ProfilePhase::whitespace) > 0 && parsed.phaseTicks(ProfilePhase::literal) > 0);
+	assert(parsed.totalTicks() >= parsed.phaseTicks(ProfilePhase::string));
+	assert(serialized.calls == 1 && serialized.bytes == out.str().size() && serialized.maxDepth == 3);
+	assert(serialized.phaseTicks(ProfilePhase::string) > 0 && serialized.phaseTicks(ProfilePhase::whitespace) > 0);
+
+	// Counters are those of the last call
+	Parser small("[[1]]");
+	assert(small.parse(doc) && small.profile().bytes == 5 && small.profile().maxDepth == 2);
+	assert(!small.parse(doc)); // Nothing left
+	assert(small.profile().calls == 1 && small.profile().bytes == 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testTraceEvents() {
+	RecordingHook hook;
+	setTraceHook(&hook);
+	Json doc;
+	assert(doc.parse(cDocument));
+	string text = doc.serialize();
+	Parser parser("[1, 2] [3]");
+	vector<int> numbers;
+	assert(parser.read(numbers) && parser.read(numbers));
+	setTraceHook(nullptr);
+	assert(doc.parse(cDocument)); // Not traced anymore
+	if(!cProfilingEnabled) {
+		assert(hook.events.empty());
+		return;
+	}
+	vector<string> expected = { "begin parse", "end parse", "begin serialize", "end serialize",
+		"begin read", "end read", "begin read", "end read" };
+	assert(hook.events == expected);
+	assert(hook.bytes[0] == string(cDocument).size() && hook.bytes[1] == text.size());
+	assert(hook.bytes[2] == 6 && hook.bytes[3] == 4); // Whitespace before the second document is part of it
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testThreadProfile() {
+	threadProfile().reset();
+	std::thread other([]() {
+		Json doc;
+		for(int i = 0; i < 10; ++i)
+			assert(doc.parse(cDocument));
+		assert(threadProfile().calls == (cProfilingEnabled ? 10 : 0));
+	});
+	other.join();
+	Json doc;
+	for(int i = 0; i < 3; ++i)
+		assert(doc.parse(cDocument));
+	const ProfileCounters& total = threadProfile();
+	if(!cProfilingEnabled) {
+		assert(total.calls == 0 && total.totalTicks() == 0);
+		return;
+	}
+	assert(total.calls == 3 && total.bytes == 3 * string(cDocument).size() && total.maxDepth == 3);
+	ProfileCounters sum;
+	sum += total;
+	sum += total;
+	assert(sum.calls == 6 && sum.totalTicks() == 2 * total.totalTicks() && sum.maxDepth == 3);
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// JSONPath queries over trees and parsing events
+#include <algorithm>
+#include <cassert>
+#include <cjson/json.h>
+#include <cjson/parser.h>
+#include <cjson/query.h>
+#include <string>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+void testQueries();
+void testStreaming();
+void testCompileErrors();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testQueries();
+	testStreaming();
+	testCompileErrors();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* cStore = R"({
+	"store": {
+		"book": [
+			{ "category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95 },
+			{ "category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99 },
+			{ "category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3",
+				"price": 8.99 },
+			{ "category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord of the Rings",
+				"isbn": "0-395-19395-8", "price": 22.99 }
+		],
+		"bicycle": { "color": "red", "price": 19.95 }
+	},
+	"orders": [ { "id": 1, "qty": 0, "tags": ["a"] }, { "id": 2, "qty": 3 }, { "id": 3, "qty": 1, "tags": [] } ],
+	"odd key": { "a/b": [0, 1, 2, 3, 4, 5] }
+})";
+
+// Queries with the values they match, in the order of the tree
+const pair<const char*, const char*> cQueries[] = {
+	{ "$", nullptr },
+	{ "$.store.book[*].author", R"(["Nigel Rees", "Evelyn Waugh", "Herman Melville", "J. R. R. Tolkien"])" },
+	{ "$..author", R"(["Nigel Rees", "Evelyn Waugh", "Herman Melville", "J. R. R. Tolkien"])" },
+	{ "$.store.*", nullptr },
+	{ "$.store..price", R"([19.95, 8.95, 12.99, 8.99, 22.99])" }, // Keys are sorted
+	{ "$..book[2].title", R"(["Moby Dick"])" },
+	{ "$..book[-1].title", R"(["The Lord of the Rings"])" },
+	{ "$..book[0,1].title", R"(["Sayings of the Century", "Sword of Honour"])" },
+	{ "$..book[1,0].title", R"(["Sayings of the Century", "Sword of Honour"])" },
+	{ "$..book[:2].price", R"([8.95, 12.99])" },
+	{ "$..book[1:].price", R"([12.99, 8.99, 22.99])" },
+	{ "$..book[-2:].price", R"([8.99, 22.99])" },
+	{ "$..book[::2].price", R"([8.95, 8.99])" },
+	{ "$..book[::-1].price", R"([8.95, 12.99, 8.99, 22.99])" },
+	{ "$..book[?(@.isbn)].title", R"(["Moby Dick", "The Lord of the Rings"])" },
+	{ "$..book[?(@.price < 10)].title", R"(["Sayings of the Century", "Moby Dick"])" },
+	{ "$..book[?(@.price < 10 && @.category == 'fiction')].title", R"(["Moby Dick"])" },
+	{ "$..book[?(@.price > 20 || !@.isbn)].price", R"([8.95, 12.99, 22.99])" },
+	{ "$..book[?(@.author >= 'I')].author", R"(["Nigel Rees", "J. R. R. Tolkien"])" },
+	{ "$.orders[?(@.qty > 0)].id", R"([2, 3])" },
+	{ "$.orders[?(@.qty > 0 && @.tags)].id", R"([3])" },
+	{ "$.orders[?(@['tags'][0] == \"a\")].id", R"([1])" },
+	{ "$.orders[?(@.id == 2.0)].qty", R"([3])" },
+	{ "$.orders[?(@.missing == @.other)].id", R"([1, 2, 3])" },
+	{ "$.orders[?(@.missing != null)].id", R"([1, 2, 3])" },
+	{ "$['odd key']['a/b'][1:5:2]", R"([1, 3])" },
+	{ "$['odd key']['a/b'][5:1:-2]", R"([3, 5])" },
+	{ "$['odd key']['a/b'][-10:-4]", R"([0, 1])" },
+	{ "$['odd key']['a/b'][0:6:0]", R"([])" },
+	{ "$..[?(@.qty == 3)]", R"([{ "id": 2, "qty": 3 }])" },
+	{ "$..nothing", R"([])" },
+	{ "$.store.book.title", R"([])" },
+	{ "$.orders[*].tags[*]", R"(["a"])" },
+	{ "$.orders..*", R"([{ "id": 1, "qty": 0, "tags": ["a"] }, 1, 0, ["a"], "a", { "id": 2, "qty": 3 }, 2, 3,
+		{ "id": 3, "qty": 1, "tags": [] }, 3, 1, []])" },
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void testQueries() {
+	Json store;
+	assert(store.parse(cStore));
+	for(const auto& q : cQueries) {
+		Query query;
+		assert(query.compile(q.first));
+		vector<const Json*> matches = query.select(store);
+		if(!q.second) // Checked below
+			continue;
+		Json expected;
+		assert(expected.parse(q.second));
+		assert(matches.size() == expected.size());
+		for(size_t i = 0; i < matches.size(); ++i)
+			assert(*matches[i] == expected(i));
+	}
+
+	// Matches point into the document
+	Query root;
+	assert(root.select(store).size() == 1 && root.select(store)[0] == &store);
+	Query children;
+	assert(children.compile("$.store.*"));
+	vector<const Json*> matches = children.select(store);
+	assert(matches.size() == 2 && matches[0]->isObject() && matches[1]->isArray()); // Keys are sorted
+	size_t count = 0;
+	children.select(store, [&count](const Json& _match) { count += _match.size(); });
+	assert(count == 6);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Same results as on the tree, but in the order matches end
+void testStreaming() {
+	Json store;
+	assert(store.parse(cStore));
+	for(const auto& q : cQueries) {
+		Query query;
+		assert(query.compile(q.first));
+		vector<string> onTree;
+		query.select(store, [&onTree](const Json& _match) { onTree.push_back(_match.serialize()); });
+		vector<string> streamed;
+		QueryHandler handler(query, [&streamed](const Json& _match) { streamed.push_back(_match.serialize()); });
+		Parser parser(cStore);
+		assert(parser.parse(handler));
+		sort(onTree.begin(), onTree.end());
+		sort(streamed.begin(), streamed.end());
+		assert(onTree == streamed);
+	}
+
+	// Only the matches are built
+	std::string big = "{\"rows\":[";
+	for(int i = 0; i < 10000; ++i)
+		big += "{\"id\":" + to_string(i) + ",\"qty\":" + to_string(i % 3) + ",\"pad\":[1,2,3,{\"x\":\"y\"}]},";
+	big += "null]}";
+	Query query;
+	assert(query.compile("$.rows[?(@.qty == 2)].id"));
+	int sum = 0, matches = 0;
+	QueryHandler handler(query, [&](const Json& _match) { sum += int(_match); ++matches; });
+	Parser parser(big.c_str());
+	assert(parser.parse(handler));
+	assert(matches == 3333 && sum == 3333 * 3332 / 2 * 3 + 2 * 3333);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testCompileErrors() {
+	const char* cBad[] = {
+		"", "store", "$.", "$..", "$.[0]", "$[", "$[0", "$['a'", "$[a]", "$[?(@.a == )]", "$[?(@.a ==", "$[?(1)]",
+		"$[?(@.a && )]", "$[?((@.a)]", "$ x", "$[-]",
+	};
+	Json store;
+	assert(store.parse(cStore));
+	for(const char* text : cBad) {
+		Query query;
+		assert(!query.compile(text));
+		assert(!query.compileError().empty());
+		assert(query.select(store).empty());
+	}
+	Query query;
+	assert(!query.compile("$.store[?(@.price <)]"));
+	assert(query.compileError() == "offset 19: expected a value");
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Direct mapping between json and C++ structs
+#include <cassert>
+#include <cjson/json.h>
+#include <cjson/parser.h>
+#include <cjson/serializer.h>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct Size {
+	int w = 0;
+	int h = 0;
+};
+
+struct Record {
+	int id = 0;
+	std::string name;
+	float price = 0.f;
+	bool active = false;
+	unsigned count = 0;
+	double ratio = 0.0;
+	std::vector<std::string> tags;
+	Size size;
+	std::vector<Size> history;
+	std::vector<bool> flags;
+	cjson::Json extra;
+	std::string missing = "default";
+};
+
+CJSON_REFLECT(Size, w, h)
+CJSON_REFLECT(Record, id, name, price, active, count, ratio, tags, size, history, flags, extra, missing)
+
+using namespace cjson;
+using namespace std;
+
+void testRead();
+void testWrite();
+void testErrors();
+void testKeyTable();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	static_assert(IsReflected<Record>::value && !IsReflected<int>::value, "Only registered structs are reflected");
+	testRead();
+	testWrite();
+	testErrors();
+	testKeyTable();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testRead() {
+	Record r;
+	Parser p(R"({
+		"name": "first \"record\"",
+		"id": 12,
+		"unknown": {"nested": [1, 2, {"a": null}]},
+		"price": 2.5,
+		"active": true,
+		"count": 7,
+		"ratio": 0.125,
+		"tags": ["a", "b"],
+		"size": {"h": 3, "w": 4},
+		"history": [{"w": 1, "h": 2}, {"w": 5}],
+		"flags": [true, false, true],
+		"extra": {"free": ["form"]}
+	})");
+	assert(p.read(r));
+	assert(r.id == 12);
+	assert(r.name == "first \"record\"");
+	assert(r.price == 2.5f);
+	assert(r.active);
+	assert(r.count == 7);
+	assert(r.ratio == 0.125);
+	assert(r.tags.size() == 2 && r.tags[1] == "b");
+	assert(r.size.w == 4 && r.size.h == 3);
+	assert(r.history.size() == 2 && r.history[0].h == 2 && r.history[1].w == 5 && r.history[1].h == 0);
+	assert(r.flags.size() == 3 && r.flags[0] && !r.flags[1]);
+	assert(r.extra["free"](0) == "form");
+	assert(r.missing == "default"); // Fields missing from the input are left untouched
+
+	// Arrays of structs
+	vector<Size> sizes;
+	Parser arrayParser(R"([{"w": 1, "h": 1}, {"w": 2, "h": 2}])");
+	assert(arrayParser.read(sizes));
+	assert(sizes.size() == 2 && sizes[1].w == 2);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testWrite() {
+	Record r;
+	r.id = 3;
+	r.name = "line\nbreak";
+	r.price = 1.5f;
+	r.tags = { "x" };
+	r.size.w = 2;
+	r.history.resize(2);
+	r.flags = { false };
+	r.extra["k"] = true;
+
+	// Fields are written in declaration order, with the same layout as a Json
+	stringstream direct;
+	Serializer s;
+	assert(s.serialize(r, direct));
+	Json j;
+	assert(j.parse(direct.str().c_str()));
+	assert(j["name"] == "line\nbreak");
+	assert(j["size"]["w"] == 2);
+	assert(j["history"].size() == 2);
+	assert(j["extra"]["k"].isBool());
+
+	// And it reads back into an equal struct
+	Record back;
+	Parser p(direct.str().c_str());
+	assert(p.read(back));
+	assert(back.id == r.id && back.name == r.name && back.price == r.price && back.tags == r.tags);
+	assert(back.history.size() == 2 && back.flags == r.flags && back.extra == r.extra);
+
+	stringstream vectorOut;
+	vector<Size> sizes(1);
+	assert(s.serialize(sizes, vectorOut));
+	assert(vectorOut.str() == "[\n\t{\n\t\t\"w\": 0,\n\t\t\"h\": 0\n\t}\n]");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testErrors() {
+	Record r;
+	Parser wrongType(R"({"id": "12"})");
+	assert(!wrongType.read(r));
+	assert(wrongType.error().code == ParseErrorCode::typeMismatch);
+	assert(wrongType.error().offset == 7);
+
+	Parser realForInt(R"({"count": 1.5})");
+	assert(!realForInt.read(r));
+	assert(realForInt.error().code == ParseErrorCode::typeMismatch);
+
+	Parser negative(R"({"count": -1})");
+	assert(!negative.read(r));
+	assert(negative.error().code == ParseErrorCode::invalidNumber);
+
+	Parser truncated(R"({"tags": ["a")");
+	assert(!truncated.read(r));
+	assert(truncated.error().code == ParseErrorCode::unexpectedEnd);
+
+	Parser deep("[[[[1]]]]");
+	deep.setMaxDepth(3);
+	vector<vector<vector<vector<int>>>> nested;
+	assert(!deep.read(nested));
+	assert(deep.error().code == ParseErrorCode::depthLimitExceeded);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testKeyTable() {
+	const char* const names[] = { "id", "name", "names", "x", "y", "width", "height", "a_longer_field_name" };
+	const size_t count = sizeof(names) / sizeof(names[0]);
+	KeyTable table(names, count);
+	for(size_t i = 0; i < count; ++i)
+		assert(table.find(names[i], strlen(names[i])) == int(i));
+	assert(table.find("nam", 3) == -1);
+	assert(table.find("z", 1) == -1);
+	assert(table.find("", 0) == -1);
+
+	// Repeated names are rejected in every build, not just by an assert
+	const char* const repeated[] = { "id", "name", "x", "name" };
+	bool rejected = false;
+	try {
+		KeyTable duplicates(repeated, 4);
+	}
+	catch(const std::invalid_argument&) {
+		rejected = true;
+	}
+	assert(rejected);
+}
\ No newline at end of file
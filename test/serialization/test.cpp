@@ -26,7 +26,10 @@
 // Hello world sample
 #include <cassert>
 #include <cjson/json.h>
+#include <cjson/outputSink.h>
+#include <cstdio>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 
@@ -67,4 +70,73 @@ int main(int, const char**)
 	assert(serial == R"({
 	"on": true
 })");
+
+	// ----- Reals -----
+	// Very large and very small reals are written with an exponent, and read back
+	Json real;
+	j = 3.4e38f;
+	assert(real.parse(j.serialize().c_str()) && real.serialize() == j.serialize());
+	j = 1e-7f;
+	assert(real.parse(j.serialize().c_str()) && real.serialize() == j.serialize());
+	// Values json can't represent
+	j = std::numeric_limits<float>::infinity();
+	assert(j.serialize() == "null");
+	j = std::numeric_limits<float>::quiet_NaN();
+	assert(j.serialize() == "null");
+	j = -0.f;
+	assert(j.serialize() == "-0.0");
+	assert(real.parse(j.serialize().c_str()) && real.serialize() == "-0.0");
+
+	// ----- Escaping -----
+	j = "quote\" backslash\\ newline\n bell\a";
+	assert(j.serialize() == R"("quote\" backslash\\ newline\n bell\u0007")");
+	Json roundTrip;
+	assert(roundTrip.parse(j.serialize().c_str()));
+	assert(roundTrip == j);
+
+	// ----- Numbers -----
+	j = std::numeric_limits<int>::min();
+	assert(j.serialize() == "-2147483648");
+	j = 3.14159265f;
+	stringstream precise;
+	precise.precision(9);
+	assert(j.serialize() == "3.14159" && j.serialize(precise));
+	stringstream expected;
+	expected.precision(9);
+	expected << double(3.14159265f);
+	assert(precise.str() == expected.str()); // The precision of the stream is kept
+
+	// ----- Output sinks -----
+	// Enough output to fill several blocks, with strings longer than a block
+	Json big;
+	for(int i = 0; i < 2000; ++i) {
+		Json record;
+		record["id"] = i;
+		record["name"] = string(size_t(i % 7) * 2000, 'x') + "\n";
+		record["tags"].push_back("sink");
+		big.push_back(record);
+	}
+	stringstream viaStream;
+	assert(big.serialize(viaStream));
+	string bigText = viaStream.str();
+	assert(big.serialize() == bigText);
+	for(size_t blockSize : { size_t(16), size_t(4096), FileSink::cDefaultBlockSize }) {
+		FILE* file = tmpfile();
+		assert(file);
+		{
+			FileSink sink(fileno(file), blockSize);
+			assert(big.serialize(sink) && sink.position() == bigText.size());
+			sink.put('\n'); // Several documents can follow each other
+			assert(j.serialize(sink) && sink.flush() && sink.error() == 0);
+		}
+		string written(bigText.size() + 1 + j.serialize().size(), '\0');
+		rewind(file);
+		assert(fread(&written[0], 1, written.size(), file) == written.size() && fgetc(file) == EOF);
+		assert(written == bigText + "\n" + j.serialize());
+		fclose(file);
+	}
+	// Failures are reported, and later output is dropped
+	FileSink broken(-1, 16);
+	assert(!big.serialize(broken) && broken.error() != 0);
+	assert(!broken.flush() && broken.position() == bigText.size());
 }
\ No newline at end of file
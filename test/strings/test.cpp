@@ -0,0 +1,115 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Storage of string values
+#include <cassert>
+#include <cjson/json.h>
+#include <cstring>
+#include <string>
+#include <utility>
+
+using namespace cjson;
+using namespace std;
+
+void testText();
+void testStringValues();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**)
+{
+	testText();
+	testStringValues();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testText() {
+	static_assert(sizeof(Text) == 16, "Text must stay within two words");
+	Text empty;
+	assert(empty.empty() && empty.isInline() && empty.c_str()[0] == '\0');
+
+	// Short strings are stored inline, up to the last byte
+	const string fifteen = "123456789012345";
+	Text full(fifteen.data(), fifteen.size());
+	assert(full.isInline() && full.size() == 15 && full.str() == fifteen && full.c_str()[15] == '\0');
+	const string sixteen = fifteen + "6";
+	Text longer(sixteen.data(), sixteen.size());
+	assert(!longer.isInline() && longer.size() == 16 && strcmp(longer.c_str(), sixteen.c_str()) == 0);
+
+	// Copies, moves and assignments between both kinds
+	Text copy(longer);
+	assert(copy == longer && copy.hash() == longer.hash() && copy.data() != longer.data());
+	Text moved(std::move(copy));
+	assert(moved == longer && copy.empty());
+	moved = full;
+	assert(moved == full && moved.isInline());
+	moved = std::move(longer);
+	assert(moved.str() == sixteen && longer.empty());
+	moved.assign(moved.data() + 1, 15); // From its own storage
+	assert(moved.str() == sixteen.substr(1) && moved.isInline());
+	moved = moved;
+	assert(moved.str() == sixteen.substr(1));
+
+	// Comparison
+	Text a("abc", 3), b("abd", 3), prefix("ab", 2), nul("a\0c", 3);
+	assert(a.compare(b) < 0 && b.compare(a) > 0 && prefix.compare(a) < 0 && a.compare(a) == 0);
+	assert(a != b && !(a == prefix) && a.equals("abc", 3) && !a.equals("ab", 2));
+	assert(nul.size() == 3 && nul != a && nul.equals("a\0c", 3));
+	Text x(sixteen.data(), sixteen.size()), y((fifteen + "7").data(), 16);
+	assert(x != y && x.compare(y) < 0);
+	x.hash(); // Cached hashes are compared before the characters
+	y.hash();
+	assert(x != y);
+	x.clear();
+	assert(x.empty() && x.isInline());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testStringValues() {
+	Json doc;
+	assert(doc.parse(R"({"short":"abc", "long":"a string that doesn't fit inline", "nul":"a\u0000b", "empty":""})"));
+	assert(doc["short"] == "abc" && strcmp(doc["short"].c_str(), "abc") == 0);
+	assert(doc["long"] == string("a string that doesn't fit inline"));
+	assert(doc["nul"].size() == 3 && doc["nul"] == string("a\0b", 3) && !(doc["nul"] == "a"));
+	assert(doc["empty"] == "" && doc["empty"].size() == 0);
+	assert(std::string(doc["long"]) == "a string that doesn't fit inline");
+	assert(doc.serialize().find("\"a\\u0000b\"") != string::npos);
+
+	// Equal strings are equal values with equal hashes, whatever their storage
+	Json other;
+	assert(other.parse(R"({"empty":"", "long":"a string that doesn't fit inline", "nul":"a\u0000b", "short":"abc"})"));
+	assert(doc == other && doc.hash() == other.hash());
+	other["long"] = "a string that doesn't fit inline!";
+	assert(!(doc == other));
+
+	// Assigning a string from the value itself
+	Json text = "a string that lives in the value itself";
+	text = text.c_str();
+	assert(text == "a string that lives in the value itself");
+	Json tree;
+	tree["key"] = "a value longer than fifteen bytes";
+	tree = std::string(tree["key"]);
+	assert(tree == "a value longer than fifteen bytes");
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Frozen documents and publishing versions to reader threads
+#include <atomic>
+#include <cassert>
+#include <cjson/frozen.h>
+#include <cjson/json.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cjson;
+using namespace std;
+
+void testFrozen();
+void testConcurrentReads();
+void testPublishing();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testFrozen();
+	testConcurrentReads();
+	testPublishing();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// All the members of a version hold its number, so a torn read would show
+Json makeVersion(int _version) {
+	Json document;
+	document["version"] = _version;
+	for(int i = 0; i < 50; ++i)
+		document["values"].push_back(_version);
+	document["nested"]["version"] = _version;
+	return document;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool isConsistent(const Json& _document) {
+	int version = _document["version"];
+	if(int(_document["nested"]["version"]) != version || _document["values"].size() != 50)
+		return false;
+	for(const Json& value : _document["values"]) {
+		if(int(value) != version)
+			return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testFrozen() {
+	Json original = makeVersion(1);
+	FrozenJson frozen(original);
+	// The original can still be modified, without affecting the frozen document
+	original["version"] = 2;
+	original["values"](3) = 2;
+	assert(int(frozen["version"]) == 1);
+	assert(int(frozen->operator[]("values")(3)) == 1);
+	assert(isConsistent(*frozen));
+	FrozenJson copy = frozen;
+	assert(&copy.get() != &frozen.get() && copy.get() == frozen.get());
+	FrozenJson empty;
+	assert(empty->isNull());
+
+	// A document built through references is cloned once when it is moved in, and copies share that clone
+	Json built = makeVersion(3);
+	Json& kept = built["nested"]["version"];
+	FrozenJson moved(std::move(built));
+	kept = 4;
+	assert(int(moved["nested"]["version"]) == 3 && isConsistent(*moved));
+	FrozenJson again = moved;
+	assert(&again["nested"] == &moved["nested"] && &again["values"](0) == &moved["values"](0));
+
+	// Same for published versions: loading one is O(1)
+	SharedJson shared;
+	shared.store(makeVersion(5));
+	FrozenJson first = shared.load();
+	FrozenJson second = shared.load();
+	assert(&first["values"](49) == &second["values"](49) && isConsistent(*first));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testConcurrentReads() {
+	FrozenJson frozen(makeVersion(7));
+	vector<thread> readers;
+	atomic<int> failures(0);
+	for(int t = 0; t < 4; ++t) {
+		readers.emplace_back([&frozen, &failures]() {
+			for(int i = 0; i < 1000; ++i) {
+				FrozenJson mine = frozen;
+				if(!isConsistent(*mine) || !isConsistent(*frozen) || frozen->hash() != mine->hash())
+					++failures;
+			}
+		});
+	}
+	for(auto& reader : readers)
+		reader.join();
+	assert(failures == 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testPublishing() {
+	SharedJson shared(makeVersion(0));
+	assert(int(shared.load()["version"]) == 0);
+	const int cVersions = 500;
+	atomic<bool> done(false);
+	atomic<int> failures(0);
+	vector<thread> readers;
+	for(int t = 0; t < 4; ++t) {
+		readers.emplace_back([&]() {
+			int last = 0;
+			while(!done) {
+				FrozenJson snapshot = shared.load();
+				int version = snapshot["version"];
+				// Versions only move forward, and are never seen half way through
+				if(version < last || !isConsistent(*snapshot))
+					++failures;
+				last = version;
+			}
+		});
+	}
+	Json next = makeVersion(0);
+	for(int v = 1; v <= cVersions; ++v) {
+		next["version"] = v; // Each version is a modified copy of the previous one
+		next["nested"]["version"] = v;
+		for(auto& value : next["values"])
+			value = v;
+		shared.store(next);
+	}
+	done = true;
+	for(auto& reader : readers)
+		reader.join();
+	assert(failures == 0);
+	assert(int(shared.load()["version"]) == cVersions);
+}
\ No newline at end of file
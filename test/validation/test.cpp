@@ -0,0 +1,251 @@
+//----------------------------------------------------------------------------------------------------------------------
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Carmelo J. Fernndez-Agera Tortosa
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//----------------------------------------------------------------------------------------------------------------------
+// Simple Json C++ library
+//----------------------------------------------------------------------------------------------------------------------
+// Validation of documents against JSON Schemas
+#include <cassert>
+#include <cjson/json.h>
+#include <cjson/parser.h>
+#include <cjson/validator.h>
+#include <string>
+
+using namespace cjson;
+using namespace std;
+
+void testEvents();
+void testTrees();
+void testStreaming();
+void testCompileErrors();
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int, const char**) {
+	testEvents();
+	testTrees();
+	testStreaming();
+	testCompileErrors();
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+Json schemaFrom(const char* _text) {
+	Json schema;
+	bool ok = schema.parse(_text);
+	assert(ok);
+	(void)ok;
+	return schema;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Records the events it receives in a compact form
+class EventLog : public SaxHandler {
+public:
+	std::string log;
+	bool null() override { log += "n"; return true; }
+	bool boolean(bool _b) override { log += _b ? "T" : "F"; return true; }
+	bool integer(int _i) override { log += "i" + to_string(_i); return true; }
+	bool real(float) override { log += "r"; return true; }
+	bool string(const std::string& _s) override { log += "'" + _s + "'"; return true; }
+	bool beginArray() override { log += "["; return true; }
+	bool endArray() override { log += "]"; return true; }
+	bool beginObject() override { log += "{"; return true; }
+	bool key(const std::string& _key) override { log += _key + ":"; return true; }
+	bool endObject() override { log += "}"; return log.size() < 100; } // Gives up on long documents
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void testEvents() {
+	EventLog events;
+	Parser parser(R"({"a":[1, 2.5, "x\n"], "b":{}, "c":[null, true, false]})");
+	assert(parser.parse(events));
+	assert(events.log == "{a:[i1r'x\n']b:{}c:[nTF]}");
+
+	// A builder reproduces what the generic parse would
+	const char* cText = R"({"a":[1,2.5,{"b":"text"}], "c":{"d":true}, "e":[[], {}]})";
+	Json built, parsed;
+	JsonBuilder builder(built);
+	assert(Parser(cText).parse(builder));
+	assert(parsed.parse(cText));
+	assert(built == parsed);
+
+	// Syntax errors and handlers stopping the parse
+	EventLog broken;
+	Parser bad(R"([1, tru])");
+	assert(!bad.parse(broken));
+	assert(bad.error().code == ParseErrorCode::invalidLiteral);
+	EventLog stopping;
+	Parser stopped("[{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},"
+		"{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}]");
+	assert(!stopped.parse(stopping));
+	assert(stopped.error().code == ParseErrorCode::rejected);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* cOrderSchema = R"({
+	"$schema": "http://json-schema.org/draft-07/schema#",
+	"type": "object",
+	"required": ["id", "items"],
+	"properties": {
+		"id": { "type": "integer", "minimum": 1 },
+		"status": { "enum": ["open", "closed"] },
+		"customer": { "type": "string", "minLength": 2, "maxLength": 8, "pattern": "^[a-z]+$" },
+		"items": {
+			"type": "array",
+			"minItems": 1,
+			"items": {
+				"type": "object",
+				"required": ["price"],
+				"properties": {
+					"price": { "type": "number", "exclusiveMinimum": 0 },
+					"tags": { "type": "array", "maxItems": 2, "items": { "type": "string" } }
+				},
+				"additionalProperties": false
+			}
+		},
+		"origin": { "enum": [[1, 2], {"x": 0}] },
+		"extra": true,
+		"never": false
+	},
+	"additionalProperties": { "type": ["string", "null"] }
+})";
+
+struct Case {
+	const char* document;
+	const char* path; ///< nullptr if the document is valid
+	const char* keyword;
+};
+
+const Case cCases[] = {
+	{ R"({"id":1, "items":[{"price":2.5}]})", nullptr, nullptr },
+	{ R"({"id":3.0, "items":[{"price":2, "tags":["a","b"]}], "status":"open", "customer":"ana"})", nullptr, nullptr },
+	{ R"({"id":1, "items":[{"price":1}], "origin":[1,2], "note":"hi", "other":null, "extra":{"a":[]}})",
+		nullptr, nullptr },
+	{ R"({"id":1, "items":[{"price":1}], "origin":{"x":0}})", nullptr, nullptr },
+	{ R"([])", "", "type" },
+	{ R"({"items":[{"price":1}]})", "", "required" },
+	{ R"({"id":0, "items":[{"price":1}]})", "/id", "minimum" },
+	{ R"({"id":1.5, "items":[{"price":1}]})", "/id", "type" },
+	{ R"({"id":1, "items":[]})", "/items", "minItems" },
+	{ R"({"id":1, "items":[{"price":1}, {"price":0}]})", "/items/1/price", "exclusiveMinimum" },
+	{ R"({"id":1, "items":[{"price":1, "tags":["a", 2]}]})", "/items/0/tags/1", "type" },
+	{ R"({"id":1, "items":[{"price":1, "tags":["a","b","c"]}]})", "/items/0/tags", "maxItems" },
+	{ R"({"id":1, "items":[{"price":1, "size":2}]})", "/items/0/size", "additionalProperties" },
+	{ R"({"id":1, "items":[{"tags":[]}]})", "/items/0", "required" },
+	{ R"({"id":1, "items":[{"price":1}], "status":"lost"})", "/status", "enum" },
+	{ R"({"id":1, "items":[{"price":1}], "customer":"Ana"})", "/customer", "pattern" },
+	{ R"({"id":1, "items":[{"price":1}], "customer":"a"})", "/customer", "minLength" },
+	{ R"({"id":1, "items":[{"price":1}], "customer":"abcdefghi"})", "/customer", "maxLength" },
+	{ R"({"id":1, "items":[{"price":1}], "origin":[2,1]})", "/origin", "enum" },
+	{ R"({"id":1, "items":[{"price":1}], "a/b~":3})", "/a~1b~0", "type" },
+	{ R"({"id":1, "items":[{"price":1}], "never":null})", "/never", "false" },
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void testTrees() {
+	Validator anything;
+	assert(anything.validate(schemaFrom(cOrderSchema)));
+
+	Validator validator;
+	assert(validator.compile(schemaFrom(cOrderSchema)));
+	for(const Case& c : cCases) {
+		Json document = schemaFrom(c.document);
+		ValidationError error;
+		bool valid = validator.validate(document, error);
+		assert(valid == !c.path);
+		assert(validator.validate(document) == valid);
+		if(!valid) {
+			assert(error.path == c.path);
+			assert(error.keyword == c.keyword);
+		}
+	}
+
+	// Counts use code points, and integral reals are integers
+	Validator text;
+	assert(text.compile(schemaFrom(R"({"type":"string", "maxLength":2})")));
+	assert(text.validate(Json("\xC3\xB1\xC3\xB1")));
+	assert(!text.validate(Json("abc")));
+	Validator integer;
+	assert(integer.compile(schemaFrom(R"({"type":"integer", "maximum":3})")));
+	assert(integer.validate(Json(2.f)) && !integer.validate(Json(2.5f)) && !integer.validate(Json(4)));
+
+	ValidationError error;
+	Validator properties;
+	assert(properties.compile(schemaFrom(R"({"minProperties":1, "maxProperties":2})")));
+	assert(properties.validate(schemaFrom(R"({"a":1})")) && properties.validate(Json(7)));
+	assert(!properties.validate(schemaFrom(R"({})"), error) && error.keyword == "minProperties");
+	assert(!properties.validate(schemaFrom(R"({"a":1,"b":2,"c":3})"), error) && error.message() == ": maxProperties");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testStreaming() {
+	Validator validator;
+	assert(validator.compile(schemaFrom(cOrderSchema)));
+	for(const Case& c : cCases) {
+		Json document;
+		JsonBuilder builder(document);
+		ValidatingHandler handler(validator, &builder);
+		Parser parser(c.document);
+		bool valid = parser.parse(handler);
+		assert(valid == !c.path);
+		if(valid)
+			assert(document == schemaFrom(c.document));
+		else {
+			assert(parser.error().code == ParseErrorCode::rejected);
+			assert(handler.error().path == c.path);
+			assert(handler.error().keyword == c.keyword);
+		}
+	}
+
+	// The parse stops right at the offending value
+	const std::string cText = R"({"id":1, "items":[{"price":-1}], "customer":"ana"})";
+	ValidatingHandler alone(validator);
+	Parser parser(cText.c_str());
+	assert(!parser.parse(alone));
+	assert(parser.error().offset < cText.find("customer"));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void testCompileErrors() {
+	const char* cBadSchemas[] = {
+		R"(3)",
+		R"({"type":"text"})",
+		R"({"type":["string", 1]})",
+		R"({"minimum":"3"})",
+		R"({"minLength":-1})",
+		R"({"maxItems":1.5})",
+		R"({"pattern":"[a-"})",
+		R"({"enum":1})",
+		R"({"required":["a", 2]})",
+		R"({"properties":{"a":{"type":"nothing"}}})",
+		R"({"items":[{"type":"string"}]})",
+	};
+	for(const char* text : cBadSchemas) {
+		Validator validator;
+		assert(!validator.compile(schemaFrom(text)));
+		assert(!validator.compileError().empty());
+		assert(!validator.validate(Json())); // A failed compilation rejects everything
+	}
+	Validator validator;
+	assert(!validator.compile(schemaFrom(R"({"properties":{"a":{"type":"nothing"}}})")));
+	assert(validator.compileError() == "/properties/a/type: unknown type");
+}
\ No newline at end of file